@@ -59,8 +59,8 @@ void generator::generate(const package &p, graphml_node_t &parent) const
     const auto &uns = config().using_namespace();
     using namespace common::generators::graphml;
 
-    pugi::xml_node package_node;
-    pugi::xml_node graph_node;
+    graphml_node_t package_node;
+    graphml_node_t graph_node;
 
     if (config().generate_packages()) {
         // Don't generate packages from namespaces filtered out by
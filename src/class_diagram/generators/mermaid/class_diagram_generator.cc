@@ -18,10 +18,12 @@
 
 #include "class_diagram_generator.h"
 
-#include "util/error.h"
-
 #include <inja/inja.hpp>
 
+#include <iterator>
+#include <tuple>
+#include <unordered_set>
+
 namespace clanguml::class_diagram::generators::mermaid {
 
 using clanguml::common::eid_t;
@@ -88,18 +90,8 @@ void generator::generate(const class_ &c, std::ostream &ostr) const
     //
     std::set<std::string> rendered_relations;
 
-    std::stringstream all_relations_str;
-    for (const auto &r : c.relationships()) {
-        try {
-            generate_relationship(r, rendered_relations);
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(false), r.destination(),
-                e.what());
-        }
-    }
+    for (const auto &r : c.relationships())
+        generate_relationship(r, rendered_relations);
 
     //
     // Process members
@@ -360,26 +352,11 @@ void generator::generate_relationship(
 
     LOG_DBG("Processing relationship {}", to_string(r.type()));
 
-    std::string destination;
-
-    auto target_element = model().get(r.destination());
-    if (!target_element.has_value())
-        throw error::uml_alias_missing{fmt::format(
-            "Missing element in the model for ID: {}", r.destination())};
-
-    destination = target_element.value().full_name(false);
-
-    if (util::starts_with(destination, std::string{"::"}))
-        destination = destination.substr(2, destination.size());
-
-    std::string mmd_relation;
-    if (!r.multiplicity_source().empty())
-        mmd_relation += "\"" + r.multiplicity_source() + "\" ";
-
-    mmd_relation += mermaid_common::to_mermaid(r.type());
-
-    if (!r.multiplicity_destination().empty())
-        mmd_relation += " \"" + r.multiplicity_destination() + "\"";
+    if (plan().alias(r.destination()) == nullptr) {
+        LOG_DBG("Skipping {} relation to {} - missing element in the model",
+            to_string(r.type()), r.destination());
+        return;
+    }
 
     if (!r.label().empty()) {
         if (r.type() == relationship_t::kFriendship)
@@ -393,211 +370,102 @@ void generator::generate_relationship(
 void generator::generate_relationships(
     const class_ &c, std::ostream &ostr) const
 {
-    namespace mermaid_common = clanguml::common::generators::mermaid;
-
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
-
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
-
-    for (const auto &r : c.relationships()) {
-        LOG_DBG("== Processing relationship {}", to_string(r.type()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
-
-            std::string relation_str;
-
-            if (!r.multiplicity_source().empty())
-                relation_str += "\"" + r.multiplicity_source() + "\" ";
-
-            relation_str += mermaid_common::to_mermaid(r.type());
-
-            if (!r.multiplicity_destination().empty())
-                relation_str += " \"" + r.multiplicity_destination() + "\"";
-
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() == relationship_t::kContainment) {
-                relstr << indent(1) << target_alias << " " << relation_str
-                       << " " << c.alias();
-            }
-            else if (r.type() == relationship_t::kExtension) {
-                relstr << indent(1) << target_alias << " <|-- " << c.alias();
-            }
-            else {
-                relstr << indent(1) << c.alias() << " " << relation_str << " "
-                       << target_alias;
-            }
-
-            relstr << " : ";
-
-            if (!r.label().empty()) {
-                auto lbl = r.label();
-                if (r.type() == relationship_t::kFriendship)
-                    lbl = "[friend]";
-                relstr << mermaid_common::to_mermaid(r.access()) << lbl;
-                rendered_relations.emplace(r.label());
-            }
-
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
-
-                LOG_DBG("=== Adding relation {}", relstr.str());
-
-                all_relations_str << relstr.str() << '\n';
-            }
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
-        }
-    }
-
-    ostr << all_relations_str.str();
+    generate_element_relationships(c, ostr);
 }
 
 void generator::generate_relationships(
     const concept_ &c, std::ostream &ostr) const
+{
+    generate_element_relationships(c, ostr);
+}
+
+void generator::generate_element_relationships(
+    const common::model::diagram_element &e, std::ostream &ostr) const
 {
     namespace mermaid_common = clanguml::common::generators::mermaid;
 
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
+    const auto *source_alias = plan().alias(e.id());
+    if (source_alias == nullptr)
+        return;
+
+    fmt::memory_buffer all_relations;
+    fmt::memory_buffer relation;
+    std::unordered_set<std::string> unique_relations;
+
+    for (const auto &[r, target_alias] : plan().relationships(e.id())) {
+        LOG_DBG("== Processing relationship {}", to_string(r->type()));
+
+        relation.clear();
+        auto out = std::back_inserter(relation);
 
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
-
-    for (const auto &r : c.relationships()) {
-        LOG_DBG("== Processing relationship {}", to_string(r.type()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
-
-            std::string mmd_relation;
-            if (!r.multiplicity_source().empty())
-                mmd_relation += "\"" + r.multiplicity_source() + "\" ";
-
-            mmd_relation += mermaid_common::to_mermaid(r.type());
-
-            if (!r.multiplicity_destination().empty())
-                mmd_relation += " \"" + r.multiplicity_destination() + "\"";
-
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() == relationship_t::kContainment) {
-                relstr << indent(1) << target_alias << " " << mmd_relation
-                       << " " << c.alias();
-            }
-            else {
-                relstr << indent(1) << c.alias() << " " << mmd_relation << " "
-                       << target_alias;
-            }
-
-            relstr << " : ";
-
-            if (!r.label().empty()) {
-                auto lbl = r.label();
-                if (r.type() == relationship_t::kFriendship)
-                    lbl = "[friend]";
-                relstr << mermaid_common::to_mermaid(r.access()) << lbl;
-                rendered_relations.emplace(r.label());
-            }
-
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
-
-                LOG_TRACE("=== Adding relation {}", relstr.str());
-
-                all_relations_str << relstr.str() << '\n';
-            }
+        fmt::format_to(out, "{}", indent(1));
+
+        if (r->type() == relationship_t::kExtension) {
+            fmt::format_to(out, "{} <|-- {}", *target_alias, *source_alias);
+        }
+        else {
+            const auto &[from, to] = r->type() == relationship_t::kContainment
+                ? std::tie(*target_alias, *source_alias)
+                : std::tie(*source_alias, *target_alias);
+
+            fmt::format_to(out, "{} ", from);
+
+            if (!r->multiplicity_source().empty())
+                fmt::format_to(out, "\"{}\" ", r->multiplicity_source());
+
+            fmt::format_to(out, "{}", mermaid_common::to_mermaid(r->type()));
+
+            if (!r->multiplicity_destination().empty())
+                fmt::format_to(out, " \"{}\"", r->multiplicity_destination());
+
+            fmt::format_to(out, " {}", to);
         }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
+
+        fmt::format_to(out, " : ");
+
+        if (!r->label().empty()) {
+            fmt::format_to(out, "{}{}", mermaid_common::to_mermaid(r->access()),
+                r->type() == relationship_t::kFriendship ? "[friend]"
+                                                         : r->label());
         }
+
+        if (!unique_relations.emplace(relation.data(), relation.size())
+                 .second)
+            continue;
+
+        LOG_TRACE("=== Adding relation {}", fmt::to_string(relation));
+
+        all_relations.append(
+            relation.data(), relation.data() + relation.size());
+        all_relations.push_back('\n');
     }
 
-    ostr << all_relations_str.str();
+    ostr.write(all_relations.data(),
+        static_cast<std::streamsize>(all_relations.size()));
 }
 
 void generator::generate_relationships(const enum_ &e, std::ostream &ostr) const
 {
-    for (const auto &r : e.relationships()) {
-        eid_t destination{};
-        std::stringstream relstr;
-        try {
-            destination = r.destination();
-
-            auto target_alias = model().to_alias(destination);
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() == relationship_t::kContainment) {
-                relstr << indent(1) << target_alias << " "
-                       << clanguml::common::generators::mermaid::to_mermaid(
-                              r.type())
-                       << " " << e.alias();
-            }
-            else {
-                relstr << indent(1) << e.alias() << " "
-                       << clanguml::common::generators::mermaid::to_mermaid(
-                              r.type())
-                       << " " << target_alias;
-            }
-
-            auto lbl = r.label();
-            if (r.type() == relationship_t::kFriendship)
-                lbl = "[friend]";
-
-            relstr << " : " << r.label();
-
-            relstr << '\n';
-
-            ostr << relstr.str();
-        }
-        catch (error::uml_alias_missing &ex) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                clanguml::common::generators::mermaid::to_mermaid(r.type()),
-                e.full_name(true), destination, ex.what());
-        }
+    namespace mermaid_common = clanguml::common::generators::mermaid;
+
+    const auto *source_alias = plan().alias(e.id());
+    if (source_alias == nullptr)
+        return;
+
+    fmt::memory_buffer relations;
+    auto out = std::back_inserter(relations);
+
+    for (const auto &[r, target_alias] : plan().relationships(e.id())) {
+        const auto &[from, to] = r->type() == relationship_t::kContainment
+            ? std::tie(*target_alias, *source_alias)
+            : std::tie(*source_alias, *target_alias);
+
+        fmt::format_to(out, "{}{} {} {} : {}\n", indent(1), from,
+            mermaid_common::to_mermaid(r->type()), to, r->label());
     }
+
+    ostr.write(
+        relations.data(), static_cast<std::streamsize>(relations.size()));
 }
 
 void generator::generate(const enum_ &e, std::ostream &ostr) const
@@ -647,18 +515,8 @@ void generator::generate(const objc_interface &c, std::ostream &ostr) const
     //
     std::set<std::string> rendered_relations;
 
-    std::stringstream all_relations_str;
-    for (const auto &r : c.relationships()) {
-        try {
-            generate_relationship(r, rendered_relations);
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), r.destination(),
-                e.what());
-        }
-    }
+    for (const auto &r : c.relationships())
+        generate_relationship(r, rendered_relations);
 
     //
     // Process members
@@ -696,89 +554,19 @@ void generator::generate(const objc_interface &c, std::ostream &ostr) const
 void generator::generate_relationships(
     const objc_interface &c, std::ostream &ostr) const
 {
-    namespace mermaid_common = clanguml::common::generators::mermaid;
-
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
-
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
-
-    for (const auto &r : c.relationships()) {
-        LOG_DBG("== Processing relationship {}", to_string(r.type()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
-
-            std::string relation_str;
-
-            if (!r.multiplicity_source().empty())
-                relation_str += "\"" + r.multiplicity_source() + "\" ";
-
-            relation_str += mermaid_common::to_mermaid(r.type());
-
-            if (!r.multiplicity_destination().empty())
-                relation_str += " \"" + r.multiplicity_destination() + "\"";
-
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() == relationship_t::kExtension) {
-                relstr << indent(1) << target_alias << " <|-- " << c.alias();
-            }
-            else {
-                relstr << indent(1) << c.alias() << " " << relation_str << " "
-                       << target_alias;
-            }
-
-            relstr << " : ";
-
-            if (!r.label().empty()) {
-                auto lbl = r.label();
-                if (r.type() == relationship_t::kFriendship)
-                    lbl = "[friend]";
-                relstr << mermaid_common::to_mermaid(r.access()) << lbl;
-                rendered_relations.emplace(r.label());
-            }
-
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
-
-                LOG_TRACE("=== Adding relation {}", relstr.str());
-
-                all_relations_str << relstr.str() << '\n';
-            }
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
-        }
-    }
-
-    ostr << all_relations_str.str();
+    generate_element_relationships(c, ostr);
 }
 
 void generator::generate_diagram(std::ostream &ostr) const
 {
+    build_render_plan();
+
     generate_top_level_elements(ostr);
 
     generate_groups(ostr);
 
+    resolve_render_plan(m_generated_aliases);
+
     generate_relationships(ostr);
 }
 
@@ -159,6 +159,16 @@ public:
     void generate_relationship(
         const relationship &r, std::set<std::string> &rendered_relations) const;
 
+    /**
+     * @brief Render relationships of a class diagram element to elements
+     *        rendered in the diagram.
+     *
+     * @param e Diagram element
+     * @param ostr Output stream
+     */
+    void generate_element_relationships(
+        const common::model::diagram_element &e, std::ostream &ostr) const;
+
     /**
      * @brief Render enum element to MermaidJS
      *
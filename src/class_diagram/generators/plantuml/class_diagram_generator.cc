@@ -18,10 +18,11 @@
 
 #include "class_diagram_generator.h"
 
-#include "util/error.h"
-
 #include <inja/inja.hpp>
 
+#include <iterator>
+#include <unordered_set>
+
 namespace clanguml::class_diagram::generators::plantuml {
 
 using clanguml::common::generators::display_name_adapter;
@@ -42,13 +43,9 @@ void generator::generate_link(
     auto maybe_link_pattern = get_link_pattern(e);
     if (maybe_link_pattern) {
         const auto &[link_prefix, link_pattern] = *maybe_link_pattern;
-        inja::json context = common::jinja::element_context<class_element>(
-            e, common_generator<diagram_config, diagram_model>::context());
-
-        common::generators::make_context_source_relative(context, link_prefix);
 
         ostr << " [[[";
-        ostr << common::jinja::render_template(env(), context, link_pattern)
+        ostr << render_element_template(e, link_prefix, link_pattern)
                     .value_or("");
     }
 
@@ -56,12 +53,8 @@ void generator::generate_link(
 
     if (maybe_tooltip_pattern) {
         const auto &[tooltip_prefix, tooltip_pattern] = *maybe_tooltip_pattern;
-        inja::json context = common::jinja::element_context<class_element>(
-            e, common_generator<diagram_config, diagram_model>::context());
-        common::generators::make_context_source_relative(
-            context, tooltip_prefix);
         ostr << "{";
-        ostr << common::jinja::render_template(env(), context, tooltip_pattern)
+        ostr << render_element_template(e, tooltip_prefix, tooltip_pattern)
                     .value_or("");
         ostr << "}";
     }
@@ -183,18 +176,8 @@ void generator::generate(const class_ &c, std::ostream &ostr) const
     //
     std::set<std::string> rendered_relations;
 
-    std::stringstream all_relations_str;
-    for (const auto &r : c.relationships()) {
-        try {
-            generate_relationship(r, rendered_relations);
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), r.destination(),
-                e.what());
-        }
-    }
+    for (const auto &r : c.relationships())
+        generate_relationship(r, rendered_relations);
 
     //
     // Process members
@@ -416,18 +399,8 @@ void generator::generate(const objc_interface &c, std::ostream &ostr) const
     //
     std::set<std::string> rendered_relations;
 
-    std::stringstream all_relations_str;
-    for (const auto &r : c.relationships()) {
-        try {
-            generate_relationship(r, rendered_relations);
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), r.destination(),
-                e.what());
-        }
-    }
+    for (const auto &r : c.relationships())
+        generate_relationship(r, rendered_relations);
 
     //
     // Process members
@@ -542,30 +515,13 @@ void generator::generate_member_notes(std::ostream &ostr,
 void generator::generate_relationship(
     const relationship &r, std::set<std::string> &rendered_relations) const
 {
-    namespace plantuml_common = clanguml::common::generators::plantuml;
-
     LOG_DBG("Processing relationship {}", to_string(r.type()));
 
-    std::string destination;
-
-    auto target_element = model().get(r.destination());
-    if (!target_element.has_value())
-        throw error::uml_alias_missing{fmt::format(
-            "Missing element in the model for ID: {}", r.destination())};
-
-    destination = target_element.value().full_name(false);
-
-    if (util::starts_with(destination, std::string{"::"}))
-        destination = destination.substr(2, destination.size());
-
-    std::string puml_relation;
-    if (!r.multiplicity_source().empty())
-        puml_relation += "\"" + r.multiplicity_source() + "\" ";
-
-    puml_relation += plantuml_common::to_plantuml(r, config());
-
-    if (!r.multiplicity_destination().empty())
-        puml_relation += " \"" + r.multiplicity_destination() + "\"";
+    if (plan().alias(r.destination()) == nullptr) {
+        LOG_DBG("Skipping {} relation to {} - missing element in the model",
+            to_string(r.type()), r.destination());
+        return;
+    }
 
     if (!r.label().empty()) {
         rendered_relations.emplace(r.label());
@@ -575,157 +531,80 @@ void generator::generate_relationship(
 void generator::generate_relationships(
     const class_ &c, std::ostream &ostr) const
 {
-    namespace plantuml_common = clanguml::common::generators::plantuml;
-
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
-
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
-
-    for (const auto &r : c.relationships()) {
-        LOG_TRACE("== Processing relationship {}",
-            plantuml_common::to_plantuml(r, config()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
-
-            std::string puml_relation;
-            if (!r.multiplicity_source().empty())
-                puml_relation += "\"" + r.multiplicity_source() + "\" ";
-
-            puml_relation += plantuml_common::to_plantuml(r, config());
-
-            if (!r.multiplicity_destination().empty())
-                puml_relation += " \"" + r.multiplicity_destination() + "\"";
-
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() != relationship_t::kExtension)
-                relstr << c.alias() << " " << puml_relation << " "
-                       << target_alias;
-            else
-                relstr << target_alias << " <|-- " << c.alias();
-
-            if (config().generate_links) {
-                common_generator<diagram_config, diagram_model>::generate_link(
-                    relstr, r);
-            }
-
-            if (!r.label().empty()) {
-                relstr << " : " << plantuml_common::to_plantuml(r.access())
-                       << r.label();
-                rendered_relations.emplace(r.label());
-            }
-
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
-
-                LOG_TRACE("=== Adding relation {}", relstr.str());
-
-                all_relations_str << relstr.str() << '\n';
-            }
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
-        }
-    }
-
-    ostr << all_relations_str.str();
+    generate_element_relationships(c, false, ostr);
 }
 
 void generator::generate_relationships(
     const concept_ &c, std::ostream &ostr) const
+{
+    generate_element_relationships(c, true, ostr);
+}
+
+void generator::generate_element_relationships(
+    const common::model::diagram_element &e, bool filter_relationship_types,
+    std::ostream &ostr) const
 {
     namespace plantuml_common = clanguml::common::generators::plantuml;
 
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
+    const auto *source_alias = plan().alias(e.id());
+    if (source_alias == nullptr)
+        return;
 
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
+    fmt::memory_buffer all_relations;
+    fmt::memory_buffer relation;
+    std::unordered_set<std::string> unique_relations;
 
-    for (const auto &r : c.relationships()) {
-        if (!model().should_include(r.type()))
+    for (const auto &[r, target_alias] : plan().relationships(e.id())) {
+        if (filter_relationship_types && !model().should_include(r->type()))
             continue;
 
-        LOG_TRACE("== Processing relationship {}", to_string(r.type()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
+        LOG_TRACE("== Processing relationship {}",
+            plantuml_common::to_plantuml(*r, config()));
 
-            std::string puml_relation;
-            if (!r.multiplicity_source().empty())
-                puml_relation += "\"" + r.multiplicity_source() + "\" ";
+        relation.clear();
+        auto out = std::back_inserter(relation);
 
-            puml_relation += plantuml_common::to_plantuml(r, config());
+        if (r->type() == relationship_t::kExtension) {
+            fmt::format_to(out, "{} <|-- {}", *target_alias, *source_alias);
+        }
+        else {
+            fmt::format_to(out, "{} ", *source_alias);
 
-            if (!r.multiplicity_destination().empty())
-                puml_relation += " \"" + r.multiplicity_destination() + "\"";
+            if (!r->multiplicity_source().empty())
+                fmt::format_to(out, "\"{}\" ", r->multiplicity_source());
 
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
+            fmt::format_to(
+                out, "{}", plantuml_common::to_plantuml(*r, config()));
 
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
+            if (!r->multiplicity_destination().empty())
+                fmt::format_to(out, " \"{}\"", r->multiplicity_destination());
 
-            relstr << c.alias() << " " << puml_relation << " " << target_alias;
+            fmt::format_to(out, " {}", *target_alias);
+        }
 
-            if (config().generate_links) {
-                common_generator<diagram_config, diagram_model>::generate_link(
-                    relstr, r);
-            }
+        if (config().generate_links) {
+            common_generator<diagram_config, diagram_model>::generate_link(
+                relation, *r);
+        }
 
-            if (!r.label().empty()) {
-                relstr << " : " << plantuml_common::to_plantuml(r.access())
-                       << r.label();
-                rendered_relations.emplace(r.label());
-            }
+        if (!r->label().empty()) {
+            fmt::format_to(out, " : {}{}",
+                plantuml_common::to_plantuml(r->access()), r->label());
+        }
 
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
+        if (!unique_relations.emplace(relation.data(), relation.size())
+                 .second)
+            continue;
 
-                LOG_TRACE("=== Adding relation {}", relstr.str());
+        LOG_TRACE("=== Adding relation {}", fmt::to_string(relation));
 
-                all_relations_str << relstr.str() << '\n';
-            }
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
-        }
+        all_relations.append(
+            relation.data(), relation.data() + relation.size());
+        all_relations.push_back('\n');
     }
 
-    ostr << all_relations_str.str();
+    ostr.write(all_relations.data(),
+        static_cast<std::streamsize>(all_relations.size()));
 }
 
 void generator::generate(const enum_ &e, std::ostream &ostr) const
@@ -751,122 +630,37 @@ void generator::generate(const enum_ &e, std::ostream &ostr) const
 
 void generator::generate_relationships(const enum_ &e, std::ostream &ostr) const
 {
-    for (const auto &r : e.relationships()) {
-        eid_t destination{};
-        std::stringstream relstr;
-        try {
-            destination = r.destination();
-
-            auto target_alias = model().to_alias(destination);
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
+    const auto *source_alias = plan().alias(e.id());
+    if (source_alias == nullptr)
+        return;
 
-            relstr << e.alias() << " "
-                   << clanguml::common::generators::plantuml::to_plantuml(
-                          r, config())
-                   << " " << target_alias;
+    fmt::memory_buffer relations;
+    auto out = std::back_inserter(relations);
 
-            if (config().generate_links) {
-                common_generator<diagram_config, diagram_model>::generate_link(
-                    relstr, r);
-            }
+    for (const auto &[r, target_alias] : plan().relationships(e.id())) {
+        fmt::format_to(out, "{} {} {}", *source_alias,
+            clanguml::common::generators::plantuml::to_plantuml(*r, config()),
+            *target_alias);
 
-            if (!r.label().empty())
-                relstr << " : " << r.label();
+        if (config().generate_links) {
+            common_generator<diagram_config, diagram_model>::generate_link(
+                relations, *r);
+        }
 
-            relstr << '\n';
+        if (!r->label().empty())
+            fmt::format_to(out, " : {}", r->label());
 
-            ostr << relstr.str();
-        }
-        catch (error::uml_alias_missing &ex) {
-            LOG_DBG("Skipping {} relation from {} to {} due "
-                    "to: {}",
-                clanguml::common::generators::plantuml::to_plantuml(
-                    r, config()),
-                e.full_name(true), destination, ex.what());
-        }
+        relations.push_back('\n');
     }
+
+    ostr.write(
+        relations.data(), static_cast<std::streamsize>(relations.size()));
 }
 
 void generator::generate_relationships(
     const objc_interface &c, std::ostream &ostr) const
 {
-    namespace plantuml_common = clanguml::common::generators::plantuml;
-
-    //
-    // Process relationships
-    //
-    std::set<std::string> rendered_relations;
-
-    std::stringstream all_relations_str;
-    std::set<std::string> unique_relations;
-
-    for (const auto &r : c.relationships()) {
-        LOG_TRACE("== Processing relationship {}",
-            plantuml_common::to_plantuml(r, config()));
-
-        std::stringstream relstr;
-        eid_t destination{};
-        try {
-            destination = r.destination();
-
-            std::string puml_relation;
-            if (!r.multiplicity_source().empty())
-                puml_relation += "\"" + r.multiplicity_source() + "\" ";
-
-            puml_relation += plantuml_common::to_plantuml(r, config());
-
-            if (!r.multiplicity_destination().empty())
-                puml_relation += " \"" + r.multiplicity_destination() + "\"";
-
-            std::string target_alias;
-            try {
-                target_alias = model().to_alias(destination);
-            }
-            catch (...) {
-                LOG_DBG("Failed to find alias to {}", destination);
-                continue;
-            }
-
-            if (m_generated_aliases.find(target_alias) ==
-                m_generated_aliases.end())
-                continue;
-
-            if (r.type() != relationship_t::kExtension)
-                relstr << c.alias() << " " << puml_relation << " "
-                       << target_alias;
-            else
-                relstr << target_alias << " <|-- " << c.alias();
-
-            if (config().generate_links) {
-                common_generator<diagram_config, diagram_model>::generate_link(
-                    relstr, r);
-            }
-
-            if (!r.label().empty()) {
-                relstr << " : " << plantuml_common::to_plantuml(r.access())
-                       << r.label();
-                rendered_relations.emplace(r.label());
-            }
-
-            if (unique_relations.count(relstr.str()) == 0) {
-                unique_relations.emplace(relstr.str());
-
-                LOG_TRACE("=== Adding relation {}", relstr.str());
-
-                all_relations_str << relstr.str() << '\n';
-            }
-        }
-        catch (error::uml_alias_missing &e) {
-            LOG_DBG("=== Skipping {} relation from {} to {} due "
-                    "to: {}",
-                to_string(r.type()), c.full_name(true), destination, e.what());
-        }
-    }
-
-    ostr << all_relations_str.str();
+    generate_element_relationships(c, false, ostr);
 }
 
 void generator::start_package(const package &p, std::ostream &ostr) const
@@ -911,10 +705,14 @@ void generator::end_together_group(
 
 void generator::generate_diagram(std::ostream &ostr) const
 {
+    build_render_plan();
+
     generate_top_level_elements(ostr);
 
     generate_groups(ostr);
 
+    resolve_render_plan(m_generated_aliases);
+
     generate_relationships(ostr);
 
     generate_config_layout_hints(ostr);
@@ -176,6 +176,18 @@ public:
     void generate_relationship(
         const relationship &r, std::set<std::string> &rendered_relations) const;
 
+    /**
+     * @brief Render relationships of a class diagram element to elements
+     *        rendered in the diagram.
+     *
+     * @param e Diagram element
+     * @param filter_relationship_types Whether to skip relationship types
+     *                                  excluded by diagram filters
+     * @param ostr Output stream
+     */
+    void generate_element_relationships(const common::model::diagram_element &e,
+        bool filter_relationship_types, std::ostream &ostr) const;
+
     /**
      * @brief Render enum element to PlantUML
      *
@@ -0,0 +1,97 @@
+/**
+ * @file src/class_diagram/generators/render_plan.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_plan.h"
+
+namespace clanguml::class_diagram::generators {
+
+render_plan::relationship_range::relationship_range(
+    const relationship_entry *begin, const relationship_entry *end)
+    : begin_{begin}
+    , end_{end}
+{
+}
+
+void render_plan::build(const model::diagram &diagram)
+{
+    elements_.clear();
+    element_index_.clear();
+    relationships_.clear();
+
+    diagram.for_all_elements([this](const auto &view) {
+        for (const auto &e : view) {
+            const auto &element = e.get();
+
+            if (!element_index_.emplace(element.id().value(), elements_.size())
+                     .second)
+                continue;
+
+            elements_.push_back({&element, element.alias(), 0, 0});
+        }
+    });
+}
+
+void render_plan::resolve_relationships(
+    const std::set<std::string> &rendered_aliases)
+{
+    relationships_.clear();
+
+    std::vector<bool> rendered(elements_.size());
+    for (std::size_t i = 0; i < elements_.size(); i++)
+        rendered[i] = rendered_aliases.count(elements_[i].alias) > 0;
+
+    // Relationship entries point to the aliases stored in the elements_
+    // array, which is not modified anymore
+    for (auto &source : elements_) {
+        source.relationships_begin = relationships_.size();
+
+        for (const auto &r : source.element->relationships()) {
+            auto it = element_index_.find(r.destination().value());
+            if (it == element_index_.end() || !rendered[it->second])
+                continue;
+
+            relationships_.push_back({&r, &elements_[it->second].alias});
+        }
+
+        source.relationships_end = relationships_.size();
+    }
+}
+
+const std::string *render_plan::alias(const common::eid_t &id) const
+{
+    auto it = element_index_.find(id.value());
+    if (it == element_index_.end())
+        return nullptr;
+
+    return &elements_[it->second].alias;
+}
+
+render_plan::relationship_range render_plan::relationships(
+    const common::eid_t &id) const
+{
+    auto it = element_index_.find(id.value());
+    if (it == element_index_.end())
+        return {};
+
+    const auto &e = elements_[it->second];
+
+    return {relationships_.data() + e.relationships_begin,
+        relationships_.data() + e.relationships_end};
+}
+
+} // namespace clanguml::class_diagram::generators
@@ -0,0 +1,122 @@
+/**
+ * @file src/class_diagram/generators/render_plan.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "class_diagram/model/diagram.h"
+#include "common/model/relationship.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clanguml::class_diagram::generators {
+
+/**
+ * @brief Aliases and relationships of a class diagram resolved for
+ *        rendering.
+ *
+ * Text generators look up relationship targets for every relationship in
+ * the diagram, and most of these targets are usually not part of the
+ * rendered diagram. The plan resolves aliases of all diagram elements once
+ * and keeps only relationships with rendered targets in a flat array, so
+ * that generators do not have to search the model or rely on exceptions
+ * for missing targets.
+ */
+class render_plan {
+public:
+    /**
+     * @brief Relationship with a rendered target element.
+     */
+    struct relationship_entry {
+        const common::model::relationship *relationship{nullptr};
+        const std::string *target_alias{nullptr};
+    };
+
+    /**
+     * @brief Range of relationship entries of a single element.
+     */
+    class relationship_range {
+    public:
+        relationship_range() = default;
+
+        relationship_range(
+            const relationship_entry *begin, const relationship_entry *end);
+
+        const relationship_entry *begin() const { return begin_; }
+
+        const relationship_entry *end() const { return end_; }
+
+        bool empty() const { return begin_ == end_; }
+
+    private:
+        const relationship_entry *begin_{nullptr};
+        const relationship_entry *end_{nullptr};
+    };
+
+    /**
+     * @brief Resolve aliases of all elements in the diagram.
+     *
+     * Any previously resolved state is discarded.
+     *
+     * @param diagram Class diagram model
+     */
+    void build(const model::diagram &diagram);
+
+    /**
+     * @brief Resolve relationships between rendered elements.
+     *
+     * Must be called after all elements have been rendered, and before
+     * any relationships are generated.
+     *
+     * @param rendered_aliases Aliases of elements rendered in the diagram
+     */
+    void resolve_relationships(const std::set<std::string> &rendered_aliases);
+
+    /**
+     * @brief Get alias of a diagram element.
+     *
+     * @param id Element id
+     * @return Pointer to the alias, or nullptr if the element is not in the
+     *         diagram
+     */
+    const std::string *alias(const common::eid_t &id) const;
+
+    /**
+     * @brief Get relationships of an element with rendered targets.
+     *
+     * @param id Id of the relationships source element
+     * @return Relationships in the order of the model
+     */
+    relationship_range relationships(const common::eid_t &id) const;
+
+private:
+    struct element_entry {
+        const common::model::diagram_element *element{nullptr};
+        std::string alias;
+        std::size_t relationships_begin{0};
+        std::size_t relationships_end{0};
+    };
+
+    std::vector<element_entry> elements_;
+    std::unordered_map<common::eid_t::type, std::size_t> element_index_;
+    std::vector<relationship_entry> relationships_;
+};
+
+} // namespace clanguml::class_diagram::generators
@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include "class_diagram/generators/render_plan.h"
 #include "class_diagram/model/diagram.h"
 #include "common/generators/generator.h"
 #include "common/generators/nested_element_stack.h"
@@ -28,6 +29,7 @@
 #include <optional>
 #include <ostream>
 #include <regex>
+#include <set>
 #include <string>
 
 namespace clanguml::class_diagram::generators {
@@ -171,6 +173,34 @@ public:
         }
     }
 
+    /**
+     * @brief Resolve aliases of all diagram elements.
+     *
+     * This has to be called before any diagram elements are rendered.
+     */
+    void build_render_plan() const { render_plan_.build(generator_.model()); }
+
+    /**
+     * @brief Resolve relationships between rendered diagram elements.
+     *
+     * This has to be called after all diagram elements are rendered and
+     * before any relationships are rendered.
+     *
+     * @param rendered_aliases Aliases of rendered diagram elements
+     */
+    void resolve_render_plan(
+        const std::set<std::string> &rendered_aliases) const
+    {
+        render_plan_.resolve_relationships(rendered_aliases);
+    }
+
+    /**
+     * @brief Get the render plan of the diagram.
+     *
+     * @return Reference to the render plan
+     */
+    const render_plan &plan() const { return render_plan_; }
+
     template <typename T>
     void sort_class_elements(std::vector<T> &elements) const
     {
@@ -240,6 +270,7 @@ private:
     G &generator_;
     mutable common::generators::nested_element_stack<common::model::element>
         together_group_stack_;
+    mutable render_plan render_plan_;
 };
 
 } // namespace clanguml::class_diagram::generators
\ No newline at end of file
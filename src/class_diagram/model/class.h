@@ -156,6 +156,8 @@ protected:
      */
     std::string full_name_impl(bool relative = true) const override;
 
+    bool is_full_name_cacheable() const override { return true; }
+
 private:
     bool is_struct_{false};
     bool is_union_{false};
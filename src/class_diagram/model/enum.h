@@ -65,6 +65,8 @@ public:
 protected:
     std::string full_name_impl(bool relative = true) const override;
 
+    bool is_full_name_cacheable() const override { return true; }
+
 private:
     std::vector<std::string> constants_;
 };
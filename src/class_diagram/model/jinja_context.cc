@@ -31,17 +31,12 @@ void to_json(inja::json &ctx,
 {
     to_json(ctx, d.as<decorated_element>());
 
-    ctx["element"]["name"] = display_name_adapter(d.get()).name();
-    ctx["element"]["type"] = display_name_adapter(d.get()).type();
-    ctx["element"]["access"] = to_string(d.get().access());
-
-    if (d.diagram_context().contains("git")) {
-        ctx["git"] = d.diagram_context()["git"];
-    }
-
-    if (d.diagram_context().contains("user_data")) {
-        ctx["user_data"] = d.diagram_context()["user_data"];
-    }
+    if (d.references("element.name"))
+        ctx["element"]["name"] = display_name_adapter(d.get()).name();
+    if (d.references("element.type"))
+        ctx["element"]["type"] = display_name_adapter(d.get()).type();
+    if (d.references("element.access"))
+        ctx["element"]["access"] = to_string(d.get().access());
 
     to_json(ctx, d.as<source_location>());
 }
@@ -0,0 +1,407 @@
+/**
+ * @file src/class_diagram/model/serialization.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization.h"
+
+#include "util/error.h"
+
+#include <map>
+
+namespace clanguml::class_diagram::model {
+
+using common::model::binary_reader;
+using common::model::binary_writer;
+
+namespace {
+enum class element_kind_t { kPackage, kClass, kEnum, kConcept, kObjCInterface };
+
+void write_class_element(binary_writer &w, const class_element &e)
+{
+    w.write_enum(e.access());
+    w.write_string(e.name());
+    w.write_string(e.type());
+    w.write_string(e.qualified_name());
+    common::model::write_decorated_element(w, e);
+    common::model::write_source_location(w, e);
+}
+
+template <typename T> T read_class_element(binary_reader &r)
+{
+    const auto access = r.read_enum<common::model::access_t>();
+    auto name = r.read_string();
+    auto type = r.read_string();
+
+    T result{access, name, type};
+    result.set_qualified_name(r.read_string());
+    common::model::read_decorated_element(r, result);
+    common::model::read_source_location(r, result);
+
+    return result;
+}
+
+void write_member(binary_writer &w, const class_member_base &m)
+{
+    write_class_element(w, m);
+    w.write_bool(m.is_static());
+    w.write_bool(m.destination_multiplicity().has_value());
+    if (m.destination_multiplicity())
+        w.write_uint(*m.destination_multiplicity());
+}
+
+template <typename T> T read_member(binary_reader &r)
+{
+    auto m = read_class_element<T>(r);
+    m.is_static(r.read_bool());
+    if (r.read_bool())
+        m.set_destination_multiplicity(r.read_uint());
+
+    return m;
+}
+
+void write_parameter(binary_writer &w, const method_parameter &p)
+{
+    w.write_string(p.type());
+    w.write_string(p.name());
+    w.write_string(p.default_value());
+    common::model::write_decorated_element(w, p);
+}
+
+method_parameter read_parameter(binary_reader &r)
+{
+    auto type = r.read_string();
+    auto name = r.read_string();
+    auto default_value = r.read_string();
+
+    method_parameter p{
+        std::move(type), std::move(name), std::move(default_value)};
+    common::model::read_decorated_element(r, p);
+
+    return p;
+}
+
+void write_method_base(binary_writer &w, const class_method_base &m)
+{
+    write_class_element(w, m);
+    w.write_string(m.display_name());
+    w.write_bool(m.is_static());
+    w.write_uint(m.parameters().size());
+    for (const auto &p : m.parameters())
+        write_parameter(w, p);
+}
+
+template <typename T> T read_method_base(binary_reader &r)
+{
+    auto m = read_class_element<T>(r);
+    m.set_display_name(r.read_string());
+    m.is_static(r.read_bool());
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        m.add_parameter(read_parameter(r));
+
+    return m;
+}
+
+void write_method(binary_writer &w, const class_method &m)
+{
+    write_method_base(w, m);
+    common::model::write_template_trait(w, m);
+    w.write_bool(m.is_pure_virtual());
+    w.write_bool(m.is_virtual());
+    w.write_bool(m.is_const());
+    w.write_bool(m.is_defaulted());
+    w.write_bool(m.is_deleted());
+    w.write_bool(m.is_constexpr());
+    w.write_bool(m.is_consteval());
+    w.write_bool(m.is_coroutine());
+    w.write_bool(m.is_noexcept());
+    w.write_bool(m.is_constructor());
+    w.write_bool(m.is_destructor());
+    w.write_bool(m.is_move_assignment());
+    w.write_bool(m.is_copy_assignment());
+    w.write_bool(m.is_operator());
+}
+
+class_method read_method(binary_reader &r)
+{
+    auto m = read_method_base<class_method>(r);
+    common::model::read_template_trait(r, m);
+    m.is_pure_virtual(r.read_bool());
+    m.is_virtual(r.read_bool());
+    m.is_const(r.read_bool());
+    m.is_defaulted(r.read_bool());
+    m.is_deleted(r.read_bool());
+    m.is_constexpr(r.read_bool());
+    m.is_consteval(r.read_bool());
+    m.is_coroutine(r.read_bool());
+    m.is_noexcept(r.read_bool());
+    m.is_constructor(r.read_bool());
+    m.is_destructor(r.read_bool());
+    m.is_move_assignment(r.read_bool());
+    m.is_copy_assignment(r.read_bool());
+    m.is_operator(r.read_bool());
+
+    return m;
+}
+
+void write_class(binary_writer &w, const class_ &c)
+{
+    common::model::write_template_element(w, c);
+    common::model::write_stylable_element(w, c);
+    w.write_bool(c.is_struct());
+    w.write_bool(c.is_union());
+
+    w.write_uint(c.members().size());
+    for (const auto &m : c.members())
+        write_member(w, m);
+
+    w.write_uint(c.methods().size());
+    for (const auto &m : c.methods())
+        write_method(w, m);
+}
+
+void read_class(binary_reader &r, class_ &c)
+{
+    common::model::read_template_element(r, c);
+    common::model::read_stylable_element(r, c);
+    c.is_struct(r.read_bool());
+    c.is_union(r.read_bool());
+
+    auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        c.add_member(read_member<class_member>(r));
+
+    count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        c.add_method(read_method(r));
+}
+
+void write_enumeration(binary_writer &w, const enum_ &e)
+{
+    common::model::write_element(w, e);
+    common::model::write_stylable_element(w, e);
+    w.write_strings(e.constants());
+}
+
+void read_enumeration(binary_reader &r, enum_ &e)
+{
+    common::model::read_element(r, e);
+    common::model::read_stylable_element(r, e);
+    e.constants() = r.read_strings();
+}
+
+void write_concept(binary_writer &w, const concept_ &c)
+{
+    common::model::write_template_element(w, c);
+    common::model::write_stylable_element(w, c);
+
+    w.write_uint(c.requires_parameters().size());
+    for (const auto &p : c.requires_parameters())
+        write_parameter(w, p);
+
+    w.write_strings(c.requires_statements());
+}
+
+void read_concept(binary_reader &r, concept_ &c)
+{
+    common::model::read_template_element(r, c);
+    common::model::read_stylable_element(r, c);
+
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        c.add_parameter(read_parameter(r));
+
+    for (auto &statement : r.read_strings())
+        c.add_statement(std::move(statement));
+}
+
+void write_objc_interface(binary_writer &w, const objc_interface &c)
+{
+    common::model::write_element(w, c);
+    common::model::write_stylable_element(w, c);
+    w.write_bool(c.is_protocol());
+    w.write_bool(c.is_category());
+
+    w.write_uint(c.members().size());
+    for (const auto &m : c.members())
+        write_member(w, m);
+
+    w.write_uint(c.methods().size());
+    for (const auto &m : c.methods()) {
+        write_method_base(w, m);
+        w.write_bool(m.is_optional());
+    }
+}
+
+void read_objc_interface(binary_reader &r, objc_interface &c)
+{
+    common::model::read_element(r, c);
+    common::model::read_stylable_element(r, c);
+    c.is_protocol(r.read_bool());
+    c.is_category(r.read_bool());
+
+    auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        c.add_member(read_member<objc_member>(r));
+
+    count = r.read_uint();
+    for (auto i = 0U; i < count; i++) {
+        auto m = read_method_base<objc_method>(r);
+        m.is_optional(r.read_bool());
+        c.add_method(std::move(m));
+    }
+}
+
+void write_elements(binary_writer &w,
+    const common::model::nested_trait<common::model::element,
+        common::model::path> &parent,
+    const common::model::path &parent_path)
+{
+    for (const auto &e : parent) {
+        if (const auto *p =
+                dynamic_cast<const common::model::package *>(e.get());
+            p != nullptr) {
+            w.write_enum(element_kind_t::kPackage);
+            common::model::write_path(w, parent_path);
+            common::model::write_package(w, *p);
+
+            common::model::path package_path{parent_path.begin(),
+                parent_path.end(), p->get_namespace().type()};
+            package_path |= p->name();
+
+            write_elements(w, *p, package_path);
+            continue;
+        }
+
+        if (const auto *c = dynamic_cast<const class_ *>(e.get());
+            c != nullptr) {
+            w.write_enum(element_kind_t::kClass);
+            common::model::write_path(w, parent_path);
+            common::model::write_path(w, c->using_namespace());
+            write_class(w, *c);
+        }
+        else if (const auto *en = dynamic_cast<const enum_ *>(e.get());
+                 en != nullptr) {
+            w.write_enum(element_kind_t::kEnum);
+            common::model::write_path(w, parent_path);
+            common::model::write_path(w, en->using_namespace());
+            write_enumeration(w, *en);
+        }
+        else if (const auto *cpt = dynamic_cast<const concept_ *>(e.get());
+                 cpt != nullptr) {
+            w.write_enum(element_kind_t::kConcept);
+            common::model::write_path(w, parent_path);
+            common::model::write_path(w, cpt->using_namespace());
+            write_concept(w, *cpt);
+        }
+        else if (const auto *oi = dynamic_cast<const objc_interface *>(e.get());
+                 oi != nullptr) {
+            w.write_enum(element_kind_t::kObjCInterface);
+            common::model::write_path(w, parent_path);
+            common::model::write_path(w, oi->using_namespace());
+            write_objc_interface(w, *oi);
+        }
+    }
+}
+
+template <typename ElementT>
+void add_or_merge(diagram &d,
+    std::map<common::eid_t, common::model::diagram_element *> &elements,
+    const common::model::path &parent_path, std::unique_ptr<ElementT> e)
+{
+    if (auto it = elements.find(e->id()); it != elements.end()) {
+        common::model::merge_relationships(*e, *it->second);
+        return;
+    }
+
+    const auto *e_ptr = e.get();
+    d.add(parent_path, std::move(e));
+
+    // The element is in the diagram only if it was added to its view
+    const auto &view = d.elements<ElementT>();
+    if (!view.empty() && &view.back().get() == e_ptr)
+        elements.emplace(e_ptr->id(), &view.back().get());
+}
+} // namespace
+
+void serialize(const diagram &d, binary_writer &w)
+{
+    // Elements at the root of the diagram are added with an empty module
+    // path, which for all package types adds them directly to the root
+    write_elements(
+        w, d, common::model::path{common::model::path_type::kModule});
+}
+
+void deserialize(binary_reader &r, diagram &d)
+{
+    std::map<common::eid_t, common::model::diagram_element *> elements;
+
+    const auto index = [&elements](const auto &view) {
+        for (const auto &e : view)
+            elements.emplace(e.get().id(), &e.get());
+    };
+    index(d.classes());
+    index(d.enums());
+    index(d.concepts());
+    index(d.objc_interfaces());
+
+    while (!r.at_end()) {
+        const auto kind = r.read_enum<element_kind_t>();
+        const auto parent_path = common::model::read_path(r);
+
+        if (kind == element_kind_t::kPackage) {
+            // Packages are never merged, duplicates are rejected by the
+            // diagram
+            d.add(parent_path, common::model::read_package(r));
+            continue;
+        }
+
+        const auto using_namespace = common::model::read_path(r);
+
+        switch (kind) {
+        case element_kind_t::kClass: {
+            auto c = std::make_unique<class_>(using_namespace);
+            read_class(r, *c);
+            add_or_merge(d, elements, parent_path, std::move(c));
+            break;
+        }
+        case element_kind_t::kEnum: {
+            auto e = std::make_unique<enum_>(using_namespace);
+            read_enumeration(r, *e);
+            add_or_merge(d, elements, parent_path, std::move(e));
+            break;
+        }
+        case element_kind_t::kConcept: {
+            auto c = std::make_unique<concept_>(using_namespace);
+            read_concept(r, *c);
+            add_or_merge(d, elements, parent_path, std::move(c));
+            break;
+        }
+        case element_kind_t::kObjCInterface: {
+            auto c = std::make_unique<objc_interface>(using_namespace);
+            read_objc_interface(r, *c);
+            add_or_merge(d, elements, parent_path, std::move(c));
+            break;
+        }
+        default:
+            throw error::model_serialization_error(
+                "Invalid class diagram element kind");
+        }
+    }
+}
+
+} // namespace clanguml::class_diagram::model
@@ -178,6 +178,39 @@ cli_flow_t cli_handler::parse(int argc, const char **argv)
     app.add_option("--mermaid-cmd", mermaid_cmd,
         "Command template to render MermaidJS diagram, `{}` will be replaced "
         "with diagram name.");
+    app.add_option("--profile", profile,
+           "Print timing and memory profile of diagram generation, or write "
+           "it as JSON to a file if path is provided")
+        ->expected(0, 1)
+        ->option_text("[PATH]");
+    app.add_option("--timings", timings,
+           "Record times of translation units to order diagrams and balance "
+           "threads or worker processes by their cost in subsequent runs, in "
+           "'.clang-uml-timings.json' in the compilation database directory "
+           "or in a file if path is provided")
+        ->expected(0, 1)
+        ->option_text("[PATH]");
+    app.add_flag("--watch", watch,
+        "Keep running and regenerate diagrams affected by changes to source "
+        "files");
+    app.add_option("--watch-interval", watch_interval,
+        "Interval in milliseconds between checks for source file changes in "
+        "watch mode (default: 500)");
+#if !defined(_WIN32)
+    app.add_option("-j,--jobs", jobs,
+        "Number of worker processes parsing translation units of each "
+        "diagram (default: 1)");
+#endif
+    app.add_option("--memory-limit", memory_limit,
+        "Resident memory limit in MiB, above which translation units are "
+        "not parsed concurrently and Clang file caches are released after "
+        "each translation unit (default: 0 - no limit)");
+    app.add_flag("--save-model", save_model,
+        "Save model of each diagram before filtering to output directory, "
+        "so that diagrams can be regenerated using '--from-model'");
+    app.add_flag("--from-model", from_model,
+        "Regenerate diagrams from models saved using '--save-model' with "
+        "current configuration, without parsing translation units");
     app.add_option(
            "--user-data",
            [this](CLI::results_t vals) {
@@ -288,6 +321,20 @@ cli_flow_t cli_handler::handle_pre_config_options()
         }
     }
 
+    if (watch && (print_from || print_to || validate_only)) {
+        LOG_ERROR("ERROR: '--watch' cannot be used with '--print-from', "
+                  "'--print-to' or '--validate-only'");
+
+        return cli_flow_t::kError;
+    }
+
+    if (from_model && (watch || save_model)) {
+        LOG_ERROR("ERROR: '--from-model' cannot be used with '--watch' or "
+                  "'--save-model'");
+
+        return cli_flow_t::kError;
+    }
+
     if (initialize) {
         return create_config_file();
     }
@@ -462,6 +509,16 @@ runtime_config cli_handler::get_runtime_config() const
     cfg.thread_count = thread_count;
     cfg.render_diagrams = render_diagrams;
     cfg.output_directory = effective_output_directory;
+    cfg.profile = profile.has_value();
+    cfg.profile_output = profile.value_or("");
+    cfg.timings = timings.has_value();
+    cfg.timings_path = timings.value_or("");
+    cfg.watch = watch;
+    cfg.watch_interval = std::chrono::milliseconds{watch_interval};
+    cfg.jobs = jobs;
+    cfg.save_model = save_model;
+    cfg.from_model = from_model;
+    cfg.memory_limit = memory_limit;
 
     return cfg;
 }
@@ -23,6 +23,7 @@
 
 #include <cli11/CLI11.hpp>
 
+#include <chrono>
 #include <optional>
 
 namespace clanguml::cli {
@@ -40,6 +41,16 @@ struct runtime_config {
     unsigned int thread_count{};
     bool render_diagrams{};
     std::string output_directory{};
+    bool profile{};
+    std::string profile_output{};
+    bool timings{};
+    std::string timings_path{};
+    bool watch{};
+    std::chrono::milliseconds watch_interval{};
+    unsigned int jobs{1};
+    bool save_model{};
+    bool from_model{};
+    std::size_t memory_limit{};
 };
 
 /**
@@ -222,6 +233,14 @@ public:
     bool render_diagrams{false};
     std::optional<std::string> plantuml_cmd;
     std::optional<std::string> mermaid_cmd;
+    std::optional<std::string> profile;
+    std::optional<std::string> timings;
+    bool watch{false};
+    unsigned int watch_interval{500};
+    unsigned int jobs{1};
+    bool save_model{false};
+    bool from_model{false};
+    std::size_t memory_limit{0};
 
     clanguml::config::config config;
 
@@ -463,55 +463,103 @@ bool is_subexpr_of(const clang::Stmt *parent_stmt, const clang::Stmt *sub_stmt)
         [sub_stmt](const auto *e) { return is_subexpr_of(e, sub_stmt); });
 }
 
+namespace {
+thread_local translation_unit_id_cache *current_id_cache{nullptr}; // NOLINT
+
+template <typename F> eid_t cached_id(const void *key, F &&f)
+{
+    auto *cache = translation_unit_id_cache::current();
+    if (cache == nullptr)
+        return f();
+
+    return cache->id(key, std::forward<F>(f));
+}
+} // namespace
+
+translation_unit_id_cache::translation_unit_id_cache()
+    : previous_{current_id_cache}
+{
+    current_id_cache = this;
+}
+
+translation_unit_id_cache::~translation_unit_id_cache()
+{
+    current_id_cache = previous_;
+}
+
+translation_unit_id_cache *translation_unit_id_cache::current()
+{
+    return current_id_cache;
+}
+
 template <> eid_t to_id(const std::string &full_name)
 {
-    return static_cast<eid_t>(
-        static_cast<uint64_t>(std::hash<std::string>{}(full_name)));
+    return static_cast<eid_t>(util::stable_hash(full_name));
 }
 
 eid_t to_id(const clang::QualType &type, const clang::ASTContext &ctx)
 {
-    return to_id(common::to_string(type, ctx));
+    return cached_id(type.getAsOpaquePtr(),
+        [&type, &ctx] { return to_id(common::to_string(type, ctx)); });
 }
 
 template <> eid_t to_id(const clang::NamespaceDecl &declaration)
 {
-    return to_id(get_qualified_name(declaration));
+    return cached_id(&declaration, [&declaration] {
+        return to_id(get_qualified_name(declaration));
+    });
 }
 
 template <> eid_t to_id(const clang::RecordDecl &declaration)
 {
-    return to_id(get_qualified_name(declaration));
+    return cached_id(&declaration, [&declaration] {
+        return to_id(get_qualified_name(declaration));
+    });
 }
 
 template <> eid_t to_id(const clang::ObjCCategoryDecl &type)
 {
-    return to_id(fmt::format("__objc__category__{}", type.getNameAsString()));
+    return cached_id(&type, [&type] {
+        return to_id(
+            fmt::format("__objc__category__{}", type.getNameAsString()));
+    });
 }
 
 template <> eid_t to_id(const clang::ObjCInterfaceDecl &type)
 {
-    return to_id(fmt::format("__objc__interface__{}", type.getNameAsString()));
+    return cached_id(&type, [&type] {
+        return to_id(
+            fmt::format("__objc__interface__{}", type.getNameAsString()));
+    });
 }
 
 template <> eid_t to_id(const clang::ObjCProtocolDecl &type)
 {
-    return to_id(fmt::format("__objc__protocol__{}", type.getNameAsString()));
+    return cached_id(&type, [&type] {
+        return to_id(
+            fmt::format("__objc__protocol__{}", type.getNameAsString()));
+    });
 }
 
 template <> eid_t to_id(const clang::EnumDecl &declaration)
 {
-    return to_id(get_qualified_name(declaration));
+    return cached_id(&declaration, [&declaration] {
+        return to_id(get_qualified_name(declaration));
+    });
 }
 
 template <> eid_t to_id(const clang::TagDecl &declaration)
 {
-    return to_id(get_qualified_name(declaration));
+    return cached_id(&declaration, [&declaration] {
+        return to_id(get_qualified_name(declaration));
+    });
 }
 
 template <> eid_t to_id(const clang::CXXRecordDecl &declaration)
 {
-    return to_id(get_qualified_name(declaration));
+    return cached_id(&declaration, [&declaration] {
+        return to_id(get_qualified_name(declaration));
+    });
 }
 
 template <> eid_t to_id(const clang::EnumType &t)
@@ -1080,28 +1128,84 @@ std::optional<size_t> get_array_size(const clang::ArrayType &type)
     return {};
 }
 
+namespace {
+translation_unit_id_cache::file_path_ids make_file_path_ids(
+    const std::string &file, const std::filesystem::path &tu_path,
+    const std::filesystem::path &relative_to_path)
+{
+    namespace fs = std::filesystem;
+
+    auto &paths = model::file_path_table::instance();
+
+    translation_unit_id_cache::file_path_ids result;
+
+    // ensure the path is absolute
+    fs::path file_path{file};
+    if (!file_path.is_absolute()) {
+        file_path = fs::absolute(file_path);
+    }
+
+    file_path = weakly_canonical(file_path);
+
+    result.file = paths.intern(file_path.string());
+
+    if (util::is_relative_to(file_path, relative_to_path)) {
+        result.file_relative = paths.intern(util::path_to_url(
+            fs::path{paths.path(result.file)}.lexically_relative(
+                relative_to_path)));
+    }
+
+    result.translation_unit = paths.intern(tu_path.string());
+
+    return result;
+}
+} // namespace
+
 void set_source_location(clang::SourceManager &source_manager,
     const clang::SourceLocation &location,
     clanguml::common::model::source_location &element,
     std::filesystem::path tu_path, std::filesystem::path relative_to_path_)
 {
-    namespace fs = std::filesystem;
-
     std::string file;
     unsigned line{};
     unsigned column{};
+    std::optional<translation_unit_id_cache::file_path_ids> file_paths;
 
     if (location.isValid()) {
-        file =
-            source_manager.getFilename(source_manager.getSpellingLoc(location))
-                .str();
+        const auto spelling_location = source_manager.getSpellingLoc(location);
+        const auto file_id = source_manager.getFileID(spelling_location);
+
         line = source_manager.getSpellingLineNumber(location);
         column = source_manager.getSpellingColumnNumber(location);
 
-        if (file.empty()) {
-            // Why do I have to do this?
-            parse_source_location(
-                location.printToString(source_manager), file, line, column);
+        auto *cache = translation_unit_id_cache::current();
+        if (cache != nullptr && file_id.isValid()) {
+            // Absolute and relative paths are calculated only once per file
+            file_paths = cache->file_paths(file_id.getHashValue(), [&] {
+                auto result = translation_unit_id_cache::file_path_ids{};
+
+                const auto filename =
+                    source_manager.getFilename(spelling_location).str();
+
+                if (!filename.empty())
+                    result = make_file_path_ids(
+                        filename, tu_path, relative_to_path_);
+
+                return result;
+            });
+
+            if (file_paths->file == model::file_path_table::kEmpty)
+                file_paths.reset();
+        }
+
+        if (!file_paths) {
+            file = source_manager.getFilename(spelling_location).str();
+
+            if (file.empty()) {
+                // Why do I have to do this?
+                parse_source_location(
+                    location.printToString(source_manager), file, line, column);
+            }
         }
     }
     else {
@@ -1114,27 +1218,12 @@ void set_source_location(clang::SourceManager &source_manager,
         }
     }
 
-    // ensure the path is absolute
-    fs::path file_path{file};
-    if (!file_path.is_absolute()) {
-        file_path = fs::absolute(file_path);
-    }
-
-    file_path = weakly_canonical(file_path);
-
-    file = file_path.string();
-
-    element.set_file(file);
-
-    if (util::is_relative_to(file_path, relative_to_path_)) {
-        element.set_file_relative(util::path_to_url(
-            fs::path{element.file()}.lexically_relative(relative_to_path_)));
-    }
-    else {
-        element.set_file_relative("");
-    }
+    if (!file_paths)
+        file_paths = make_file_path_ids(file, tu_path, relative_to_path_);
 
-    element.set_translation_unit(tu_path.string());
+    element.set_file_id(file_paths->file);
+    element.set_file_relative_id(file_paths->file_relative);
+    element.set_translation_unit_id(file_paths->translation_unit);
     element.set_line(line);
     element.set_column(column);
     element.set_location_id(location.getHashValue());
@@ -31,6 +31,7 @@
 #include <deque>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 
 namespace clang {
 class NamespaceDecl;
@@ -212,6 +213,97 @@ template <> eid_t to_id(const clang::TemplateSpecializationType &type);
 template <> eid_t to_id(const std::filesystem::path &type);
 /** @} */ // end of to_id
 
+/**
+ * @brief Cache of ids and qualified names of declarations and types in
+ *        the currently processed translation unit.
+ *
+ * Generating an id requires rendering a fully qualified name of the
+ * declaration or type, which visitors request repeatedly for the same
+ * entities. While an instance of this class is alive, `to_id()` overloads
+ * for Clang declarations and types memoize their results in it. The cache is
+ * keyed by AST node pointers, so it must not outlive the translation unit.
+ *
+ * The cache also keeps the file path table ids of source files, so that
+ * absolute and relative paths of each file are computed only once per
+ * translation unit.
+ *
+ * Each thread has its own current cache, set on construction and restored
+ * to the previous one on destruction.
+ */
+class translation_unit_id_cache {
+public:
+    /**
+     * @brief Ids of source file paths in the file path table.
+     */
+    struct file_path_ids {
+        model::file_path_table::id_t file{model::file_path_table::kEmpty};
+        model::file_path_table::id_t file_relative{
+            model::file_path_table::kEmpty};
+        model::file_path_table::id_t translation_unit{
+            model::file_path_table::kEmpty};
+    };
+
+    translation_unit_id_cache();
+
+    translation_unit_id_cache(const translation_unit_id_cache &) = delete;
+    translation_unit_id_cache(translation_unit_id_cache &&) = delete;
+    translation_unit_id_cache &operator=(
+        const translation_unit_id_cache &) = delete;
+    translation_unit_id_cache &operator=(translation_unit_id_cache &&) = delete;
+
+    ~translation_unit_id_cache();
+
+    /**
+     * @brief Get the cache active in the current thread.
+     *
+     * @return Pointer to the active cache or nullptr
+     */
+    static translation_unit_id_cache *current();
+
+    /**
+     * @brief Get cached id of a declaration or type, or compute it.
+     *
+     * @param key AST node pointer
+     * @param f Function generating the id
+     * @return Element id
+     */
+    template <typename F> eid_t id(const void *key, F &&f)
+    {
+        auto it = ids_.find(key);
+        if (it != ids_.end())
+            return it->second;
+
+        const auto result = f();
+        ids_.emplace(key, result);
+        return result;
+    }
+
+    /**
+     * @brief Get cached path ids of a source file, or compute them.
+     *
+     * The translation unit path and the `relative_to` path must be the same
+     * for all source locations processed within a single cache instance.
+     *
+     * @param file_id Hash value of Clang's FileID in current translation unit
+     * @param f Function generating the path ids
+     * @return Source file path ids
+     */
+    template <typename F>
+    const file_path_ids &file_paths(unsigned file_id, F &&f)
+    {
+        auto it = file_paths_.find(file_id);
+        if (it != file_paths_.end())
+            return it->second;
+
+        return file_paths_.emplace(file_id, f()).first->second;
+    }
+
+private:
+    std::unordered_map<const void *, eid_t> ids_;
+    std::unordered_map<unsigned, file_path_ids> file_paths_;
+    translation_unit_id_cache *previous_;
+};
+
 /**
  * @brief Split qualified name to namespace and name
  *
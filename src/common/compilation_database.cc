@@ -117,6 +117,26 @@ size_t compilation_database::count_matching_commands(
     return result;
 }
 
+const util::query_driver_output_extractor &
+compilation_database::query_driver(
+    const std::string &command, const std::string &language) const
+{
+    std::lock_guard<std::mutex> l(query_driver_cache_mutex_);
+
+    const auto key = std::make_pair(command, language);
+
+    auto it = query_driver_cache_.find(key);
+    if (it != query_driver_cache_.end())
+        return it->second;
+
+    util::query_driver_output_extractor extractor{command, language};
+
+    extractor.execute();
+
+    return query_driver_cache_.emplace(key, std::move(extractor))
+        .first->second;
+}
+
 void compilation_database::adjust_compilation_database(
     std::vector<clang::tooling::CompileCommand> &commands) const
 {
@@ -127,10 +147,8 @@ void compilation_database::adjust_compilation_database(
                 ? compile_command.CommandLine.at(0)
                 : config().query_driver();
 
-            util::query_driver_output_extractor extractor{
-                argv0, guess_language_from_filename(compile_command.Filename)};
-
-            extractor.execute();
+            const auto &extractor = query_driver(
+                argv0, guess_language_from_filename(compile_command.Filename));
 
             std::vector<std::string> system_header_args;
             for (const auto &path : extractor.system_include_paths()) {
@@ -23,6 +23,7 @@
 #include "config/config.h"
 #include "types.h"
 #include "util/error.h"
+#include "util/query_driver_output_extractor.h"
 #include "util/util.h"
 
 #include <clang/Frontend/CompilerInstance.h>
@@ -31,6 +32,8 @@
 
 #include <deque>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <string>
 
 namespace clanguml::common {
@@ -120,6 +123,9 @@ private:
     void adjust_compilation_database(
         std::vector<clang::tooling::CompileCommand> &commands) const;
 
+    const util::query_driver_output_extractor &query_driver(
+        const std::string &command, const std::string &language) const;
+
     /*!
      * Pointer to the Clang's original compilation database.
      *
@@ -138,6 +144,16 @@ private:
      * compile_flags.txt
      */
     bool is_fixed_;
+
+    /**
+     * Query driver results for each compiler command and language, so that
+     * the compiler is executed only once regardless of the number of
+     * translation units and diagrams.
+     */
+    mutable std::mutex query_driver_cache_mutex_;
+    mutable std::map<std::pair<std::string, std::string>,
+        util::query_driver_output_extractor>
+        query_driver_cache_;
 };
 
 using compilation_database_ptr = std::unique_ptr<compilation_database>;
@@ -25,6 +25,7 @@
 #include <clang/Options/OptionUtils.h>
 #endif
 
+#include "common/generators/memory_governor.h"
 #include "util/util.h"
 
 namespace clanguml::generators {
@@ -140,12 +141,27 @@ clang_tool::clang_tool(common::model::diagram_t diagram_type,
 
 clang_tool::~clang_tool() = default;
 
+void clang_tool::reset_file_system()
+{
+    overlay_fs_ =
+        new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem());
+    inmemory_fs_ = new llvm::vfs::InMemoryFileSystem;
+    overlay_fs_->pushOverlay(inmemory_fs_);
+    files_ = new FileManager(FileSystemOptions(), overlay_fs_);
+    visited_working_directories_.clear();
+}
+
 void clang_tool::append_arguments_adjuster(ArgumentsAdjuster Adjuster)
 {
     args_adjuster_ =
         combineAdjusters(std::move(args_adjuster_), std::move(Adjuster));
 }
 
+void clang_tool::set_profile(common::generators::diagram_profile *profile)
+{
+    profile_ = profile;
+}
+
 void clang_tool::run(ToolAction *Action)
 {
     static int static_symbol;
@@ -179,13 +195,23 @@ void clang_tool::run(ToolAction *Action)
                 diagram_name_, current_workdir.getError().message());
     }
 
+    auto &governor = common::generators::memory_governor::instance();
+
     for (const auto &file : absolute_tu_paths) {
+        // Wait until memory usage allows parsing another translation unit
+        const auto slot = governor.acquire(file);
+
         if (!quiet_)
             LOG_INFO("Processing diagram '{}' translation unit: {}",
                 diagram_name_, file);
 
+        common::generators::stopwatch sw;
+
         auto compile_commands_for_file = compilations_.getCompileCommands(file);
 
+        if (profile_ != nullptr)
+            profile_->add_phase("compile commands", sw.elapsed());
+
         if (compile_commands_for_file.empty()) {
             if (!quiet_)
                 LOG_WARN(
@@ -220,6 +246,8 @@ void clang_tool::run(ToolAction *Action)
                             llvm::MemoryBuffer::getMemBuffer(file_content));
             }
 
+            sw.restart();
+
             auto command_line = compile_command.CommandLine;
             if (args_adjuster_)
                 command_line =
@@ -229,6 +257,11 @@ void clang_tool::run(ToolAction *Action)
 
             inject_resource_dir(command_line, "clang_tool", &static_symbol);
 
+            if (profile_ != nullptr) {
+                profile_->add_phase("compile commands", sw.elapsed());
+                sw.restart();
+            }
+
             ToolInvocation invocation(std::move(command_line), Action,
                 files_.get(), pch_container_ops_);
             invocation.setDiagnosticConsumer(diag_consumer_.get());
@@ -236,7 +269,19 @@ void clang_tool::run(ToolAction *Action)
             invocation.setDiagnosticOptions(diag_opts_.get());
 #endif
 
-            if (!invocation.run() || diag_consumer_->failed) {
+            const auto invocation_result = invocation.run();
+
+            if (profile_ != nullptr) {
+                const auto elapsed = sw.elapsed();
+                profile_->add_phase("parse and traverse", elapsed);
+                profile_->add_translation_unit(file, elapsed);
+
+                LOG_DBG("Processed diagram '{}' translation unit {} in "
+                        "{:.1f} ms (CPU {:.1f} ms)",
+                    diagram_name_, file, elapsed.wall_ms(), elapsed.cpu_ms());
+            }
+
+            if (!invocation_result || diag_consumer_->failed) {
                 if (!initial_workdir.empty()) {
                     if (const auto ec = overlay_fs_->setCurrentWorkingDirectory(
                             initial_workdir);
@@ -265,6 +310,11 @@ void clang_tool::run(ToolAction *Action)
             if (diagram_type_ == common::model::diagram_t::kSequence)
                 break;
         }
+
+        // In bounded memory mode, do not keep file entries and buffers of
+        // all headers seen so far for the next translation units
+        if (governor.enabled())
+            reset_file_system();
     }
 
     if (!initial_workdir.empty()) {
@@ -21,6 +21,7 @@
 
 #include "common/clang_utils.h"
 #include "common/compilation_database.h"
+#include "common/generators/profiler.h"
 #include "common/model/source_location.h"
 
 namespace clanguml::generators {
@@ -79,9 +80,23 @@ public:
 
     void append_arguments_adjuster(clang::tooling::ArgumentsAdjuster Adjuster);
 
+    /**
+     * @brief Enable recording of compile command adjustment and per
+     *        translation unit timings.
+     *
+     * @param profile Diagram profile or nullptr to disable profiling
+     */
+    void set_profile(common::generators::diagram_profile *profile);
+
     void run(ToolAction *Action);
 
 private:
+    /**
+     * @brief Replace the file manager and virtual file systems with new
+     *        ones, releasing all cached file entries and buffers.
+     */
+    void reset_file_system();
+
     const common::model::diagram_t diagram_type_;
     const std::string diagram_name_;
     const clanguml::common::compilation_database &compilations_;
@@ -103,6 +118,8 @@ private:
     ArgumentsAdjuster args_adjuster_;
 
     std::unique_ptr<diagnostic_consumer> diag_consumer_;
+
+    common::generators::diagram_profile *profile_{nullptr};
 #if LLVM_VERSION_MAJOR < 21
     llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diag_opts_;
 #else
@@ -0,0 +1,208 @@
+/**
+ * @file src/common/generators/cost_model.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cost_model.h"
+
+#include "util/logging.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+
+namespace clanguml::common::generators {
+
+std::filesystem::path cost_model::default_path(
+    const std::filesystem::path &compilation_database_dir)
+{
+    return compilation_database_dir / ".clang-uml-timings.json";
+}
+
+bool cost_model::load(const std::filesystem::path &path)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    timings_.clear();
+
+    std::ifstream ifs{path};
+    if (!ifs)
+        return false;
+
+    try {
+        const auto j = nlohmann::json::parse(ifs);
+
+        if (j.at("version").get<unsigned>() != kVersion)
+            return false;
+
+        for (const auto &[type, tus] : j.at("diagrams").items()) {
+            auto &timings = timings_[model::from_string(type)];
+
+            for (const auto &[tu, wall_ms] : tus.items()) {
+                const auto t = wall_ms.get<double>();
+                timings.translation_units.emplace(tu, t);
+                timings.total += t;
+            }
+        }
+    }
+    catch (const std::exception & /*e*/) {
+        timings_.clear();
+
+        return false;
+    }
+
+    return true;
+}
+
+void cost_model::save(const std::filesystem::path &path) const
+{
+    nlohmann::json j;
+    j["version"] = kVersion;
+    j["diagrams"] = nlohmann::json::object();
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+
+        for (const auto &[type, timings] : timings_) {
+            auto &tus = j["diagrams"][model::to_string(type)];
+            tus = nlohmann::json::object();
+
+            for (const auto &[tu, t] : timings.translation_units)
+                tus[tu] = t;
+        }
+    }
+
+    std::error_code ec;
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream ofs{tmp_path};
+        if (!ofs) {
+            LOG_WARN("Failed to write timings {}", path.string());
+            return;
+        }
+
+        ofs << j.dump();
+    }
+
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        LOG_WARN("Failed to write timings {}: {}", path.string(), ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+double cost_model::estimate(
+    model::diagram_t type, const std::string &translation_unit) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (auto it = timings_.find(type); it != timings_.end()) {
+        const auto &tus = it->second.translation_units;
+        if (auto tu_it = tus.find(translation_unit); tu_it != tus.end())
+            return tu_it->second;
+    }
+
+    return default_cost(type);
+}
+
+double cost_model::estimate(model::diagram_t type,
+    const std::vector<std::string> &translation_units) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    const auto unknown_cost = default_cost(type);
+
+    const auto it = timings_.find(type);
+    if (it == timings_.end())
+        return unknown_cost * static_cast<double>(translation_units.size());
+
+    const auto &tus = it->second.translation_units;
+
+    double result{0};
+    for (const auto &tu : translation_units) {
+        if (auto tu_it = tus.find(tu); tu_it != tus.end())
+            result += tu_it->second;
+        else
+            result += unknown_cost;
+    }
+
+    return result;
+}
+
+void cost_model::record(model::diagram_t type,
+    const std::string &translation_unit, std::chrono::nanoseconds wall)
+{
+    const auto t = std::chrono::duration<double, std::milli>(wall).count();
+
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto &timings = timings_[type];
+
+    auto [it, inserted] =
+        timings.translation_units.try_emplace(translation_unit, t);
+    if (!inserted) {
+        timings.total -= it->second;
+        it->second = t;
+    }
+    timings.total += t;
+}
+
+void cost_model::record(const diagram_profile &profile)
+{
+    for (const auto &tu : profile.translation_units)
+        record(profile.type, tu.path, tu.time.wall);
+}
+
+std::size_t cost_model::size() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    std::size_t result{0};
+    for (const auto &[type, timings] : timings_)
+        result += timings.translation_units.size();
+
+    return result;
+}
+
+double cost_model::default_cost(model::diagram_t type) const
+{
+    if (auto it = timings_.find(type);
+        it != timings_.end() && !it->second.translation_units.empty()) {
+        return it->second.total /
+            static_cast<double>(it->second.translation_units.size());
+    }
+
+    // Without timings for the diagram type, fall back to the average of
+    // all diagram types
+    double total{0};
+    std::size_t count{0};
+    for (const auto &[t, timings] : timings_) {
+        total += timings.total;
+        count += timings.translation_units.size();
+    }
+
+    if (count == 0)
+        return kDefaultCost;
+
+    return total / static_cast<double>(count);
+}
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,140 @@
+/**
+ * @file src/common/generators/cost_model.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/generators/profiler.h"
+#include "common/model/enums.h"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Estimates the cost of processing translation units.
+ *
+ * The estimates are based on wall times of translation units recorded in
+ * previous runs with `--timings`, which are persisted in a file, by default
+ * next to the compilation database. Timings are recorded separately for
+ * each diagram type, as the same translation unit can be only preprocessed
+ * for an include diagram and fully parsed for a class or sequence diagram.
+ *
+ * Translation units without a recorded time are estimated by the average
+ * time of the recorded ones for the diagram type, or of all recorded ones if
+ * there are none for the diagram type, or by @ref kDefaultCost if nothing
+ * has been recorded yet, in which case the estimated cost of a diagram is
+ * simply proportional to its number of translation units.
+ */
+class cost_model {
+public:
+    static constexpr auto kVersion{2U};
+
+    /** Cost of a translation unit if no timings are known [ms] */
+    static constexpr auto kDefaultCost{1.0};
+
+    /**
+     * @brief Get the path of the timings file for a compilation database.
+     *
+     * @param compilation_database_dir Directory of `compile_commands.json`
+     * @return Path to the timings file
+     */
+    static std::filesystem::path default_path(
+        const std::filesystem::path &compilation_database_dir);
+
+    /**
+     * @brief Load recorded timings from a file.
+     *
+     * Missing, invalid or incompatible files result in an empty model.
+     *
+     * @param path Path to the timings file
+     * @return True, if the timings were loaded
+     */
+    bool load(const std::filesystem::path &path);
+
+    /**
+     * @brief Save recorded timings to a file.
+     *
+     * Missing parent directories of the file are created.
+     *
+     * @param path Path to the timings file
+     */
+    void save(const std::filesystem::path &path) const;
+
+    /**
+     * @brief Estimate the cost of a translation unit.
+     *
+     * @param type Type of the diagram processing the translation unit
+     * @param translation_unit Path of the translation unit
+     * @return Estimated wall time in milliseconds
+     */
+    double estimate(
+        model::diagram_t type, const std::string &translation_unit) const;
+
+    /**
+     * @brief Estimate the total cost of translation units.
+     *
+     * @param type Type of the diagram processing the translation units
+     * @param translation_units Paths of translation units
+     * @return Estimated wall time in milliseconds
+     */
+    double estimate(model::diagram_t type,
+        const std::vector<std::string> &translation_units) const;
+
+    /**
+     * @brief Record wall time of a translation unit, replacing the previous
+     *        one for the same diagram type.
+     *
+     * @param type Type of the diagram processing the translation unit
+     * @param translation_unit Path of the translation unit
+     * @param wall Wall time spent processing the translation unit
+     */
+    void record(model::diagram_t type, const std::string &translation_unit,
+        std::chrono::nanoseconds wall);
+
+    /**
+     * @brief Record wall times of all translation units in a diagram
+     *        profile.
+     *
+     * @param profile Diagram profile
+     */
+    void record(const diagram_profile &profile);
+
+    /**
+     * @brief Number of recorded timings for all diagram types.
+     */
+    std::size_t size() const;
+
+private:
+    /** Recorded wall times of translation units for a diagram type [ms] */
+    struct diagram_timings {
+        std::unordered_map<std::string, double> translation_units;
+        double total{0};
+    };
+
+    double default_cost(model::diagram_t type) const;
+
+    mutable std::mutex mutex_;
+    std::map<model::diagram_t, diagram_timings> timings_;
+};
+
+} // namespace clanguml::common::generators
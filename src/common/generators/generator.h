@@ -26,16 +26,51 @@
 
 #include <inja/inja.hpp>
 
+#include <map>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <regex>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 
 namespace clanguml::common::generators {
 
 void make_context_source_relative(
     inja::json &context, const std::string &prefix);
 
+/**
+ * @brief Link or tooltip patterns selected by source file path prefix.
+ *
+ * The patterns are compiled into a path prefix map once, and the pattern
+ * selected for each source file is memoized.
+ */
+class path_patterns {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param patterns Map of path prefixes to patterns
+     */
+    explicit path_patterns(const std::map<std::string, std::string> &patterns);
+
+    /**
+     * @brief Get pattern for the source file of an element.
+     *
+     * @param sl Source location of the element
+     * @return Path prefix and the pattern, if any matches the source file
+     */
+    const std::optional<std::pair<std::string, std::string>> &get(
+        const common::model::source_location &sl);
+
+private:
+    util::path_prefix_map patterns_;
+    std::unordered_map<common::model::file_path_table::id_t,
+        std::optional<std::pair<std::string, std::string>>>
+        cache_;
+};
+
 /**
  * @brief Common diagram generator interface
  *
@@ -103,6 +138,28 @@ public:
     std::optional<std::string> render_tooltip(
         const common::model::relationship &e) const;
 
+    std::optional<std::string> render_link(
+        const common::model::source_location &e) const;
+
+    std::optional<std::string> render_tooltip(
+        const common::model::source_location &e) const;
+
+    /**
+     * @brief Render link or tooltip template in the Jinja context of element.
+     *
+     * The template is parsed only once, and the element context only
+     * contains the variables referenced by the template.
+     *
+     * @tparam T Type of diagram element
+     * @param e Diagram element
+     * @param prefix Prefix of source paths, which are made relative to it
+     * @param jinja_template Jinja template
+     * @return Rendered template, or empty optional in case of an error
+     */
+    template <typename T>
+    std::optional<std::string> render_element_template(const T &e,
+        const std::string &prefix, const std::string &jinja_template) const;
+
     /**
      * @brief Initialize diagram Jinja context
      */
@@ -126,6 +183,11 @@ public:
 protected:
     mutable inja::json m_context;
     mutable inja::Environment m_env;
+    mutable std::map<std::string, std::unique_ptr<jinja::parsed_template>>
+        m_templates;
+    mutable jinja::git_relative_paths m_git_relative_paths;
+    mutable std::optional<path_patterns> m_link_patterns;
+    mutable std::optional<path_patterns> m_tooltip_patterns;
 
 private:
     ConfigType &config_;
@@ -274,11 +336,10 @@ std::optional<std::pair<std::string, std::string>>
 generator<C, D>::get_link_pattern(
     const common::model::source_location &sl) const
 {
-    if (sl.file_relative().empty()) {
-        return config().generate_links().get_link_pattern(sl.file());
-    }
+    if (!m_link_patterns)
+        m_link_patterns.emplace(config().generate_links().link);
 
-    return config().generate_links().get_link_pattern(sl.file_relative());
+    return m_link_patterns->get(sl);
 }
 
 template <typename C, typename D>
@@ -286,20 +347,16 @@ std::optional<std::pair<std::string, std::string>>
 generator<C, D>::get_tooltip_pattern(
     const common::model::source_location &sl) const
 {
-    if (sl.file_relative().empty()) {
-        return config().generate_links().get_tooltip_pattern(sl.file());
-    }
+    if (!m_tooltip_patterns)
+        m_tooltip_patterns.emplace(config().generate_links().tooltip);
 
-    return config().generate_links().get_tooltip_pattern(sl.file_relative());
+    return m_tooltip_patterns->get(sl);
 }
 
 template <typename C, typename D>
 std::optional<std::string> generator<C, D>::render_link(
     const common::model::diagram_element &e) const
 {
-    using common::generators::make_context_source_relative;
-    using common::jinja::render_template;
-
     if (e.file().empty() && e.file_relative().empty())
         return {};
 
@@ -310,22 +367,13 @@ std::optional<std::string> generator<C, D>::render_link(
 
     const auto &[link_prefix, link_pattern] = *maybe_link_pattern;
 
-    inja::json ec = jinja::element_context<common::model::diagram_element>(
-        e, generators::generator<C, D>::context());
-
-    make_context_source_relative(ec, link_prefix);
-
-    return render_template(
-        generators::generator<C, D>::env(), ec, link_pattern);
+    return render_element_template(e, link_prefix, link_pattern);
 }
 
 template <typename C, typename D>
 std::optional<std::string> generator<C, D>::render_link(
     const common::model::relationship &e) const
 {
-    using common::generators::make_context_source_relative;
-    using common::jinja::render_template;
-
     if (e.file().empty() && e.file_relative().empty())
         return {};
 
@@ -336,22 +384,31 @@ std::optional<std::string> generator<C, D>::render_link(
 
     const auto &[link_prefix, link_pattern] = *maybe_link_pattern;
 
-    inja::json ec = jinja::element_context<common::model::relationship>(
-        e, generators::generator<C, D>::context());
-
-    make_context_source_relative(ec, link_prefix);
-
-    return render_template(
-        generators::generator<C, D>::env(), ec, link_pattern);
+    return render_element_template(e, link_prefix, link_pattern);
 }
 
 template <typename C, typename D>
 std::optional<std::string> generator<C, D>::render_tooltip(
     const common::model::diagram_element &e) const
 {
-    using common::generators::make_context_source_relative;
-    using common::jinja::render_template;
+    if (e.file().empty() && e.file_relative().empty())
+        return {};
+
+    auto maybe_tooltip_pattern =
+        generators::generator<C, D>::get_tooltip_pattern(e);
 
+    if (!maybe_tooltip_pattern)
+        return {};
+
+    const auto &[tooltip_prefix, tooltip_pattern] = *maybe_tooltip_pattern;
+
+    return render_element_template(e, tooltip_prefix, tooltip_pattern);
+}
+
+template <typename C, typename D>
+std::optional<std::string> generator<C, D>::render_tooltip(
+    const common::model::relationship &e) const
+{
     if (e.file().empty() && e.file_relative().empty())
         return {};
 
@@ -363,22 +420,30 @@ std::optional<std::string> generator<C, D>::render_tooltip(
 
     const auto &[tooltip_prefix, tooltip_pattern] = *maybe_tooltip_pattern;
 
-    inja::json ec = jinja::element_context<common::model::diagram_element>(
-        e, generators::generator<C, D>::context());
+    return render_element_template(e, tooltip_prefix, tooltip_pattern);
+}
+
+template <typename C, typename D>
+std::optional<std::string> generator<C, D>::render_link(
+    const common::model::source_location &e) const
+{
+    if (e.file().empty() && e.file_relative().empty())
+        return {};
+
+    auto maybe_link_pattern = generators::generator<C, D>::get_link_pattern(e);
+
+    if (!maybe_link_pattern)
+        return {};
 
-    make_context_source_relative(ec, tooltip_prefix);
+    const auto &[link_prefix, link_pattern] = *maybe_link_pattern;
 
-    return render_template(
-        generators::generator<C, D>::env(), ec, tooltip_pattern);
+    return render_element_template(e, link_prefix, link_pattern);
 }
 
 template <typename C, typename D>
 std::optional<std::string> generator<C, D>::render_tooltip(
-    const common::model::relationship &e) const
+    const common::model::source_location &e) const
 {
-    using common::generators::make_context_source_relative;
-    using common::jinja::render_template;
-
     if (e.file().empty() && e.file_relative().empty())
         return {};
 
@@ -390,12 +455,43 @@ std::optional<std::string> generator<C, D>::render_tooltip(
 
     const auto &[tooltip_prefix, tooltip_pattern] = *maybe_tooltip_pattern;
 
-    inja::json ec = jinja::element_context<common::model::relationship>(
-        e, generators::generator<C, D>::context());
+    return render_element_template(e, tooltip_prefix, tooltip_pattern);
+}
+
+template <typename C, typename D>
+template <typename T>
+std::optional<std::string> generator<C, D>::render_element_template(
+    const T &e, const std::string &prefix,
+    const std::string &jinja_template) const
+{
+    using common::generators::make_context_source_relative;
+
+    auto it = m_templates.find(jinja_template);
+    if (it == m_templates.end()) {
+        it = m_templates
+                 .emplace(jinja_template,
+                     jinja::parse_template(env(), jinja_template))
+                 .first;
+    }
+
+    if (!it->second)
+        return {};
+
+    const auto &tmpl = *it->second;
+
+    inja::json ec = jinja::element_context<T>(
+        e, context(), tmpl.variables, &m_git_relative_paths);
+
+    if constexpr (std::is_same_v<T, common::model::source_location>) {
+        // Elements with only source location (e.g. sequence diagram
+        // messages) have no name, but templates can be shared with other
+        // diagram elements
+        ec["element"]["name"] = "";
+        ec["element"]["full_name"] = "";
+    }
 
-    make_context_source_relative(ec, tooltip_prefix);
+    make_context_source_relative(ec, prefix);
 
-    return render_template(
-        generators::generator<C, D>::env(), ec, tooltip_pattern);
+    return jinja::render_template(env(), ec, tmpl);
 }
-} // namespace clanguml::common::generators
\ No newline at end of file
+} // namespace clanguml::common::generators
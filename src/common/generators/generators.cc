@@ -19,6 +19,13 @@
 #include "generators.h"
 
 #include "progress_indicator.h"
+#include "sequence_diagram/visitor/definition_index_visitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <set>
 
 namespace clanguml::common::generators {
 void make_context_source_relative(
@@ -43,6 +50,30 @@ void make_context_source_relative(
     }
 }
 
+path_patterns::path_patterns(const std::map<std::string, std::string> &patterns)
+    : patterns_{patterns}
+{
+}
+
+const std::optional<std::pair<std::string, std::string>> &path_patterns::get(
+    const common::model::source_location &sl)
+{
+    // Patterns are selected by the relative path of the file, if available
+    const auto file_id = sl.file_relative().empty() ? sl.file_id()
+                                                    : sl.file_relative_id();
+
+    auto it = cache_.find(file_id);
+    if (it == cache_.end()) {
+        it = cache_
+                 .emplace(file_id,
+                     patterns_.find(
+                         model::file_path_table::instance().path(file_id)))
+                 .first;
+    }
+
+    return it->second;
+}
+
 void find_translation_units_for_diagrams(
     const std::vector<std::string> &diagram_names,
     clanguml::config::config &config,
@@ -94,15 +125,64 @@ void render_diagram(const clanguml::common::generator_type_t generator_type,
 
 namespace detail {
 
+bool is_file_content_equal(
+    const std::filesystem::path &path, const std::string &contents)
+{
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) != contents.size() || ec)
+        return false;
+
+    std::ifstream ifs{path, std::ios::binary};
+    return std::equal(contents.begin(), contents.end(),
+        std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+}
+
+template <typename ElementT>
+void count_elements(const common::reference_vector<ElementT> &elements,
+    diagram_profile &profile)
+{
+    profile.elements_count += elements.size();
+    for (const auto &e : elements)
+        profile.relationships_count += e.get().relationships().size();
+}
+
+template <typename DiagramModel>
+void count_model_elements(const DiagramModel &model, diagram_profile &profile)
+{
+    if constexpr (std::is_same_v<DiagramModel,
+                      clanguml::class_diagram::model::diagram>) {
+        count_elements(model.classes(), profile);
+        count_elements(model.enums(), profile);
+        count_elements(model.concepts(), profile);
+        count_elements(model.objc_interfaces(), profile);
+    }
+    else if constexpr (std::is_same_v<DiagramModel,
+                           clanguml::package_diagram::model::diagram>) {
+        count_elements(model.packages(), profile);
+    }
+    else if constexpr (std::is_same_v<DiagramModel,
+                           clanguml::include_diagram::model::diagram>) {
+        count_elements(model.files(), profile);
+    }
+    else if constexpr (std::is_same_v<DiagramModel,
+                           clanguml::sequence_diagram::model::diagram>) {
+        // In sequence diagrams, messages are counted as relationships
+        profile.elements_count += model.participants().size();
+        for (const auto &[id, act] : model.sequences())
+            profile.relationships_count += act.messages().size();
+    }
+}
+
 template <typename DiagramConfig, typename GeneratorTag, typename DiagramModel>
 void generate_diagram_select_generator(const std::string &od,
     const std::string &name, std::shared_ptr<clanguml::config::diagram> diagram,
-    const DiagramModel &model)
+    const DiagramModel &model, diagram_profile *profile = nullptr)
 {
     using diagram_generator =
         typename diagram_generator_t<DiagramConfig, GeneratorTag>::type;
 
     if constexpr (!std::is_same_v<diagram_generator, not_supported>) {
+        stopwatch sw;
 
         std::stringstream buffer;
         buffer << diagram_generator(
@@ -112,13 +192,28 @@ void generate_diagram_select_generator(const std::string &od,
         // in order not to overwrite previous diagram in case of failure
         auto path = std::filesystem::path{od} /
             fmt::format("{}.{}", name, GeneratorTag::extension);
-        std::ofstream ofs;
-        ofs.open(path, std::ofstream::out | std::ofstream::trunc);
-        ofs << buffer.str();
 
-        ofs.close();
+        // Do not touch the diagram file if it did not change, e.g. when
+        // regenerating diagrams in watch mode
+        const bool is_up_to_date = is_file_content_equal(path, buffer.str());
+
+        if (!is_up_to_date) {
+            std::ofstream ofs;
+            ofs.open(path, std::ofstream::out | std::ofstream::trunc);
+            ofs << buffer.str();
 
-        LOG_INFO("Written {} diagram to {}", name, path.string());
+            ofs.close();
+        }
+
+        if (profile != nullptr)
+            profile->add_phase(
+                fmt::format("generate {}", GeneratorTag::extension),
+                sw.elapsed());
+
+        if (is_up_to_date)
+            LOG_INFO("Diagram {} in {} is up to date", name, path.string());
+        else
+            LOG_INFO("Written {} diagram to {}", name, path.string());
     }
     else {
         LOG_INFO("Serialization to {} not supported for {}",
@@ -126,21 +221,16 @@ void generate_diagram_select_generator(const std::string &od,
     }
 }
 
-template <typename DiagramConfig>
-void generate_diagram_impl(const std::string &name,
+template <typename DiagramConfig, typename DiagramModel>
+void generate_diagram_outputs(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
-    const common::compilation_database &db,
-    const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config, std::function<void()> &&progress)
+    const DiagramModel &model, const cli::runtime_config &runtime_config,
+    diagram_profile *profile)
 {
     using diagram_config = DiagramConfig;
-    using diagram_model = typename diagram_model_t<DiagramConfig>::type;
-    using diagram_visitor = typename diagram_visitor_t<DiagramConfig>::type;
 
-    auto model = clanguml::common::generators::generate<diagram_model,
-        diagram_config, diagram_visitor>(db, diagram->name,
-        dynamic_cast<diagram_config &>(*diagram), translation_units,
-        runtime_config.verbose, std::move(progress));
+    if (profile != nullptr)
+        count_model_elements(*model, *profile);
 
     if constexpr (std::is_same_v<DiagramConfig, config::sequence_diagram>) {
         if (runtime_config.print_from) {
@@ -179,42 +269,453 @@ void generate_diagram_impl(const std::string &name,
         }
     }
 
-    for (const auto generator_type : runtime_config.generators) {
-        if (generator_type == generator_type_t::plantuml) {
-            generate_diagram_select_generator<diagram_config,
-                plantuml_generator_tag>(
-                runtime_config.output_directory, name, diagram, model);
+    // Output generators only read the finalized model, so they can run
+    // concurrently, each recording its timings in its own profile
+    const auto &generators = runtime_config.generators;
+    std::vector<diagram_profile> generator_profiles(generators.size());
+    std::vector<std::function<void()>> tasks;
+
+    for (auto i = 0U; i < generators.size(); i++) {
+        tasks.emplace_back([&, i]() {
+            const auto generator_type = generators[i];
+            auto *generator_profile =
+                profile != nullptr ? &generator_profiles[i] : nullptr;
+
+            if (generator_type == generator_type_t::plantuml) {
+                generate_diagram_select_generator<diagram_config,
+                    plantuml_generator_tag>(runtime_config.output_directory,
+                    name, diagram, model, generator_profile);
+            }
+            else if (generator_type == generator_type_t::json) {
+                generate_diagram_select_generator<diagram_config,
+                    json_generator_tag>(runtime_config.output_directory, name,
+                    diagram, model, generator_profile);
+            }
+            else if (generator_type == generator_type_t::mermaid) {
+                generate_diagram_select_generator<diagram_config,
+                    mermaid_generator_tag>(runtime_config.output_directory,
+                    name, diagram, model, generator_profile);
+            }
+            else if (generator_type == generator_type_t::graphml) {
+                generate_diagram_select_generator<diagram_config,
+                    graphml_generator_tag>(runtime_config.output_directory,
+                    name, diagram, model, generator_profile);
+            }
+
+            // Convert plantuml or mermaid to an image using command provided
+            // in the command line arguments
+            if (runtime_config.render_diagrams) {
+                render_diagram(generator_type, diagram);
+            }
+        });
+    }
+
+    util::run_nested(tasks);
+
+    if (profile != nullptr) {
+        for (const auto &generator_profile : generator_profiles)
+            profile->merge(generator_profile);
+    }
+}
+
+template <typename DiagramConfig>
+void generate_diagram_impl(const std::string &name,
+    std::shared_ptr<clanguml::config::diagram> diagram,
+    const common::compilation_database &db,
+    const std::vector<std::string> &translation_units,
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_profile *profile, dependency_tracker *dependencies,
+    const cost_model *costs, sequence_diagram::model::definition_index *index)
+{
+    using diagram_config = DiagramConfig;
+    using diagram_model = typename diagram_model_t<DiagramConfig>::type;
+    using diagram_visitor = typename diagram_visitor_t<DiagramConfig>::type;
+
+    try {
+        auto model = clanguml::common::generators::generate<diagram_model,
+            diagram_config, diagram_visitor>(db, diagram->name,
+            dynamic_cast<diagram_config &>(*diagram), translation_units,
+            runtime_config.verbose, std::move(progress), profile,
+            dependencies, runtime_config.jobs,
+            runtime_config.save_model
+                ? model_path(runtime_config.output_directory, name)
+                : std::filesystem::path{},
+            costs, index);
+
+        // In watch mode, diagrams whose model did not change are not
+        // generated
+        if (!model) {
+            LOG_INFO("Diagram {} is up to date", name);
+            return;
         }
-        else if (generator_type == generator_type_t::json) {
-            generate_diagram_select_generator<diagram_config,
-                json_generator_tag>(
-                runtime_config.output_directory, name, diagram, model);
+
+        generate_diagram_outputs<DiagramConfig>(
+            name, diagram, model, runtime_config, profile);
+    }
+    catch (...) {
+        // Make sure the diagram is generated in the next iteration of watch
+        // mode, even if its partial models do not change
+        if (dependencies != nullptr)
+            dependencies->reset_context(name);
+        throw;
+    }
+}
+
+template <typename DiagramConfig>
+void generate_diagram_from_model_impl(const std::string &name,
+    std::shared_ptr<clanguml::config::diagram> diagram,
+    const cli::runtime_config &runtime_config, diagram_profile *profile)
+{
+    using diagram_config = DiagramConfig;
+    using diagram_model = typename diagram_model_t<DiagramConfig>::type;
+
+    auto model = clanguml::common::generators::load<diagram_model,
+        diagram_config>(diagram->name,
+        dynamic_cast<diagram_config &>(*diagram),
+        model_path(runtime_config.output_directory, name), profile);
+
+    generate_diagram_outputs<DiagramConfig>(
+        name, diagram, model, runtime_config, profile);
+}
+
+} // namespace detail
+
+namespace {
+/**
+ * @brief Load the definition index from the compilation database directory.
+ */
+void load_definition_index(const common::compilation_database &db,
+    sequence_diagram::model::definition_index &index)
+{
+    using sequence_diagram::model::definition_index;
+
+    const auto index_path =
+        definition_index::default_path(db.config().compilation_database_dir());
+
+    if (!index.load(index_path))
+        LOG_INFO("Building new definition index in {}", index_path.string());
+}
+
+/**
+ * @brief Save the definition index in the compilation database directory,
+ *        if any translation unit has been indexed.
+ */
+void save_definition_index(const common::compilation_database &db,
+    const sequence_diagram::model::definition_index &index)
+{
+    using sequence_diagram::model::definition_index;
+
+    if (!index.modified())
+        return;
+
+    index.save(
+        definition_index::default_path(db.config().compilation_database_dir()));
+}
+
+/**
+ * @brief Update the definition index with stale translation units.
+ *
+ * Stale translation units are indexed in parallel, as nested tasks of the
+ * executor running the diagram generation, or sequentially otherwise.
+ * Diagrams sharing the index can update it concurrently, in which case
+ * translation units stale in both diagrams may be indexed twice.
+ *
+ * @return Translation units which could not be indexed
+ */
+std::set<std::string> update_definition_index(
+    sequence_diagram::model::definition_index &index,
+    const common::compilation_database &db, const std::string &name,
+    const std::vector<std::string> &translation_units,
+    const std::filesystem::path &relative_to)
+{
+    using sequence_diagram::model::definition_index;
+
+    const auto stale = index.stale_translation_units(translation_units);
+
+    std::set<std::string> failed;
+
+    if (stale.empty())
+        return failed;
+
+    LOG_INFO("Indexing function definitions in {} translation units for "
+             "diagram {}",
+        stale.size(), name);
+
+    std::mutex failed_mutex;
+
+    const auto index_translation_unit = [&](const std::string &tu) {
+        definition_index::translation_unit_entry entry;
+
+        try {
+            clanguml::generators::clang_tool clang_tool(
+                common::model::diagram_t::kSequence, name, db, {tu},
+                relative_to, true);
+
+            sequence_diagram::visitor::definition_index_action_factory
+                action_factory{entry};
+
+            clang_tool.run(&action_factory);
+
+            index.set_translation_unit(tu, std::move(entry));
         }
-        else if (generator_type == generator_type_t::mermaid) {
-            generate_diagram_select_generator<diagram_config,
-                mermaid_generator_tag>(
-                runtime_config.output_directory, name, diagram, model);
+        catch (const std::exception &e) {
+            LOG_WARN(
+                "Failed to index function definitions in {}: {}", tu, e.what());
+
+            std::lock_guard<std::mutex> fl(failed_mutex);
+            failed.emplace(tu);
         }
-        else if (generator_type == generator_type_t::graphml) {
-            generate_diagram_select_generator<diagram_config,
-                graphml_generator_tag>(
-                runtime_config.output_directory, name, diagram, model);
+    };
+
+    // When called from a diagram generation task, index the translation
+    // units as nested tasks of the pool generating the diagrams, which is
+    // sized according to the configured thread count
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(stale.size());
+
+    for (const auto &tu : stale)
+        tasks.emplace_back(
+            [&index_translation_unit, &tu]() { index_translation_unit(tu); });
+
+    util::run_nested(tasks);
+
+    return failed;
+}
+
+/**
+ * @brief Select translation units defining functions reachable from the
+ *        diagram start points using the definition index.
+ *
+ * The call graph is built incrementally, only from the selected
+ * translation units, until the closure of the start points does not require
+ * any new translation units.
+ *
+ * @return Selected translation units, or empty optional if all translation
+ *         units have to be parsed
+ */
+std::optional<std::vector<std::string>> select_translation_units(
+    const common::compilation_database &db, const std::string &name,
+    const clanguml::config::sequence_diagram &config,
+    const std::vector<std::string> &translation_units,
+    sequence_diagram::model::definition_index &index,
+    sequence_diagram::model::call_graph &graph,
+    const std::function<void(const std::vector<std::string> &)>
+        &build_call_graph)
+{
+    using sequence_diagram::model::call_graph;
+    using sequence_diagram::model::definition_index;
+
+    if (!config.to().empty()) {
+        LOG_INFO("Cannot use definition index in diagram {} with 'to' "
+                 "conditions",
+            name);
+        return {};
+    }
+
+    auto selected = update_definition_index(index, db, name,
+        translation_units, config.get_relative_to()());
+
+    index.add_functions(graph);
+
+    std::vector<call_graph::node_id> from_ids;
+    std::vector<clanguml::config::source_location> start_points{
+        config.from()};
+    for (const auto &from_to_location : config.from_to()) {
+        if (!from_to_location.empty())
+            start_points.emplace_back(from_to_location.front());
+    }
+
+    for (const auto &sl : start_points) {
+        if (sl.location_type != clanguml::config::location_t::function ||
+            sl.location.is_regex()) {
+            return {};
+        }
+
+        const auto functions = graph.find_functions(sl.location.to_string());
+        if (functions.empty())
+            return {};
+
+        util::append(from_ids, functions);
+    }
+
+    if (from_ids.empty())
+        return {};
+
+    const std::set<std::string> diagram_translation_units{
+        translation_units.begin(), translation_units.end()};
+
+    const auto add_translation_units =
+        [&](call_graph::node_id id, std::vector<std::string> &pending) {
+            const auto select = [&](const std::string &tu) {
+                if (diagram_translation_units.count(tu) == 0)
+                    return false;
+                if (selected.emplace(tu).second)
+                    pending.emplace_back(tu);
+                return true;
+            };
+
+            bool found{false};
+            for (const auto &tu : index.translation_units(id))
+                found = select(tu) || found;
+
+            if (found)
+                return;
+
+            // Functions defined only in headers have to be analyzed in just
+            // one of the translation units including them
+            const auto inline_tus = index.inline_translation_units(id);
+            for (const auto &tu : inline_tus) {
+                if (selected.count(tu) > 0)
+                    return;
+            }
+            for (const auto &tu : inline_tus) {
+                if (select(tu))
+                    return;
+            }
+        };
+
+    // Translation units which could not be indexed are always parsed
+    std::vector<std::string> pending{selected.begin(), selected.end()};
+    for (const auto id : from_ids)
+        add_translation_units(id, pending);
+
+    while (!pending.empty()) {
+        build_call_graph(pending);
+        pending.clear();
+
+        for (const auto id : graph.callees_closure(from_ids))
+            add_translation_units(id, pending);
+    }
+
+    std::vector<std::string> result;
+    for (const auto &tu : translation_units) {
+        if (selected.count(tu) > 0)
+            result.emplace_back(tu);
+    }
+
+    LOG_INFO("Selected {} out of {} translation units for diagram {} using "
+             "definition index",
+        result.size(), translation_units.size(), name);
+
+    return result;
+}
+} // namespace
+
+std::optional<std::vector<std::string>> find_reachable_functions(
+    const common::compilation_database &db, const std::string &name,
+    const config::sequence_diagram &config,
+    const std::vector<std::string> &translation_units,
+    sequence_diagram::model::diagram &diagram, bool quiet,
+    diagram_profile *profile, sequence_diagram::model::definition_index *index)
+{
+    using sequence_diagram::model::call_graph;
+    using sequence_diagram::model::definition_index;
+
+    stopwatch sw;
+
+    call_graph graph;
+
+    const auto build_call_graph =
+        [&](const std::vector<std::string> &call_graph_translation_units) {
+            clanguml::generators::clang_tool clang_tool(diagram.type(), name,
+                db, call_graph_translation_units, config.get_relative_to()(),
+                quiet);
+
+            sequence_diagram::visitor::call_graph_action_factory
+                action_factory{graph};
+
+            clang_tool.run(&action_factory);
+        };
+
+    std::optional<std::vector<std::string>> selected_translation_units;
+
+    if (config.use_definition_index()) {
+        // Without an index shared by all diagrams of the run, the index is
+        // loaded and saved only for this diagram
+        std::optional<definition_index> diagram_index;
+        if (index == nullptr) {
+            index = &diagram_index.emplace();
+            load_definition_index(db, *index);
+        }
+
+        selected_translation_units = select_translation_units(db, name,
+            config, translation_units, *index, graph, build_call_graph);
+
+        if (diagram_index)
+            save_definition_index(db, *diagram_index);
+
+        if (profile != nullptr) {
+            profile->add_phase("select translation units", sw.elapsed());
+            sw.restart();
+        }
+    }
+
+    if (!selected_translation_units)
+        build_call_graph(translation_units);
+
+    bool is_bounded{true};
+
+    const auto find_functions = [&graph, &is_bounded](
+                                    const clanguml::config::source_location &sl,
+                                    std::vector<call_graph::node_id> &ids) {
+        if (sl.location_type != clanguml::config::location_t::function ||
+            sl.location.is_regex()) {
+            is_bounded = false;
+            return;
         }
 
-        // Convert plantuml or mermaid to an image using command provided
-        // in the command line arguments
-        if (runtime_config.render_diagrams) {
-            render_diagram(generator_type, diagram);
+        const auto functions = graph.find_functions(sl.location.to_string());
+        if (functions.empty()) {
+            is_bounded = false;
+            return;
         }
+
+        util::append(ids, functions);
+    };
+
+    std::vector<call_graph::node_id> from_ids;
+    std::vector<call_graph::node_id> to_ids;
+
+    for (const auto &from_location : config.from())
+        find_functions(from_location, from_ids);
+
+    for (const auto &from_to_location : config.from_to()) {
+        if (!from_to_location.empty())
+            find_functions(from_to_location.front(), from_ids);
+    }
+
+    for (const auto &to_location : config.to())
+        find_functions(to_location, to_ids);
+
+    if (!is_bounded || (from_ids.empty() && to_ids.empty())) {
+        LOG_INFO("Analyzing all functions in diagram {} - could not match "
+                 "all start and end points in the call graph",
+            name);
+    }
+    else {
+        auto reachable = graph.callees_closure(from_ids);
+        for (const auto id : graph.callers_closure(to_ids))
+            reachable.emplace(id);
+
+        LOG_INFO("Analyzing {} out of {} functions in diagram {}",
+            reachable.size(), graph.size(), name);
+
+        diagram.set_reachable_functions(std::move(reachable));
     }
+
+    if (profile != nullptr)
+        profile->add_phase("build call graph", sw.elapsed());
+
+    return selected_translation_units;
 }
-} // namespace detail
 
 void generate_diagram(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
     const common::compilation_database &db,
     const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config, std::function<void()> &&progress)
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_profile *profile, dependency_tracker *dependencies,
+    const cost_model *costs, sequence_diagram::model::definition_index *index)
 {
     using clanguml::common::generator_type_t;
     using clanguml::common::model::diagram_t;
@@ -226,29 +727,180 @@ void generate_diagram(const std::string &name,
 
     if (diagram->type() == diagram_t::kClass) {
         detail::generate_diagram_impl<class_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), profile,
+            dependencies, costs, index);
     }
     else if (diagram->type() == diagram_t::kSequence) {
         detail::generate_diagram_impl<sequence_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), profile,
+            dependencies, costs, index);
     }
     else if (diagram->type() == diagram_t::kPackage) {
         detail::generate_diagram_impl<package_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), profile,
+            dependencies, costs, index);
     }
     else if (diagram->type() == diagram_t::kInclude) {
         detail::generate_diagram_impl<include_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), profile,
+            dependencies, costs, index);
+    }
+}
+
+std::filesystem::path model_path(
+    const std::string &output_directory, const std::string &name)
+{
+    return std::filesystem::path{output_directory} /
+        fmt::format("{}.model", name);
+}
+
+namespace {
+bool is_diagram_type_supported(
+    const std::vector<generator_type_t> &generators, model::diagram_t type)
+{
+    for (const auto generator_type : generators) {
+        if (generator_type == generator_type_t::plantuml) {
+            if (generator_supports_diagram_type<plantuml_generator_tag>(type))
+                return true;
+        }
+        else if (generator_type == generator_type_t::json) {
+            if (generator_supports_diagram_type<json_generator_tag>(type))
+                return true;
+        }
+        else if (generator_type == generator_type_t::mermaid) {
+            if (generator_supports_diagram_type<mermaid_generator_tag>(type))
+                return true;
+        }
+        else if (generator_type == generator_type_t::graphml) {
+            if (generator_supports_diagram_type<graphml_generator_tag>(type))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void generate_diagram_from_model(const std::string &name,
+    std::shared_ptr<clanguml::config::diagram> diagram,
+    const cli::runtime_config &runtime_config, diagram_profile *profile)
+{
+    using clanguml::common::model::diagram_t;
+
+    using clanguml::config::class_diagram;
+    using clanguml::config::include_diagram;
+    using clanguml::config::package_diagram;
+    using clanguml::config::sequence_diagram;
+
+    if (diagram->type() == diagram_t::kClass) {
+        detail::generate_diagram_from_model_impl<class_diagram>(
+            name, diagram, runtime_config, profile);
+    }
+    else if (diagram->type() == diagram_t::kSequence) {
+        detail::generate_diagram_from_model_impl<sequence_diagram>(
+            name, diagram, runtime_config, profile);
+    }
+    else if (diagram->type() == diagram_t::kPackage) {
+        detail::generate_diagram_from_model_impl<package_diagram>(
+            name, diagram, runtime_config, profile);
+    }
+    else if (diagram->type() == diagram_t::kInclude) {
+        detail::generate_diagram_from_model_impl<include_diagram>(
+            name, diagram, runtime_config, profile);
+    }
+}
+} // namespace
+
+int generate_diagrams_from_models(
+    const std::vector<std::string> &diagram_names, config::config &config,
+    const cli::runtime_config &runtime_config)
+{
+    util::thread_pool_executor generator_executor{runtime_config.thread_count};
+    std::vector<std::future<void>> futs;
+
+    std::unique_ptr<profiler> prof;
+    if (runtime_config.profile)
+        prof = std::make_unique<profiler>();
+
+    for (const auto &[name, diagram] : config.diagrams) {
+        if (!diagram_names.empty() && !util::contains(diagram_names, name))
+            continue;
+
+        if (!is_diagram_type_supported(
+                runtime_config.generators, diagram->type())) {
+            LOG_INFO("Diagram '{}' not supported by any of selected "
+                     "generators - skipping...",
+                name);
+            continue;
+        }
+
+        diagram_profile *profile =
+            prof ? &prof->add_diagram(name, diagram->type()) : nullptr;
+
+        futs.emplace_back(generator_executor.add(
+            [&name = name, &diagram = diagram, &runtime_config, profile]() {
+                stopwatch sw;
+
+                try {
+                    generate_diagram_from_model(
+                        name, diagram, runtime_config, profile);
+                }
+                catch (std::exception &e) {
+                    throw std::runtime_error(
+                        fmt::format("Failed to generate diagram '{}' from "
+                                    "saved model: {}",
+                            name, e.what()));
+                }
+
+                if (profile != nullptr)
+                    profile->total = sw.elapsed();
+            }));
+    }
+
+    int result{0};
+    for (auto &fut : futs) {
+        try {
+            fut.get();
+        }
+        catch (std::exception &e) {
+            if (clanguml::logging::logger_type() ==
+                logging::logger_type_t::text) {
+                fmt::println("ERROR: {}", e.what());
+            }
+            else {
+                LOG_ERROR("{}", e.what());
+            }
+            result = 1;
+        }
+    }
+
+    if (prof) {
+        if (runtime_config.profile_output.empty())
+            prof->print(std::cout);
+        else
+            prof->save(runtime_config.profile_output);
     }
+
+    return result;
 }
 
 int generate_diagrams(const std::vector<std::string> &diagram_names,
     config::config &config, const common::compilation_database_ptr &db,
     const cli::runtime_config &runtime_config,
     const std::map<std::string, std::vector<std::string>>
-        &translation_units_map)
+        &translation_units_map,
+    dependency_tracker *dependencies)
 {
-    util::thread_pool_executor generator_executor{runtime_config.thread_count};
+    constexpr std::size_t kMebibyte{1024U * 1024U};
+    memory_governor::instance().set_limit(
+        runtime_config.memory_limit * kMebibyte);
+
+    // Worker processes are forked from the generator thread, so diagrams
+    // are generated one at a time when they are enabled, so that no other
+    // thread can hold a lock needed by the workers when they are forked.
+    // Diagrams with a single translation unit, as well as finalizing and
+    // rendering of each diagram, are then not overlapped with other diagrams
+    util::thread_pool_executor generator_executor{
+        runtime_config.jobs > 1 ? 1U : runtime_config.thread_count};
     std::vector<std::future<void>> futs;
 
     std::unique_ptr<progress_indicator_base> indicator;
@@ -265,8 +917,33 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         }
     }
 
+    // Diagrams are profiled when requested, or in order to record timings
+    // of translation units for the cost model
+    std::unique_ptr<profiler> prof;
+    if (runtime_config.profile || runtime_config.timings)
+        prof = std::make_unique<profiler>();
+
+    // Without recorded timings, the cost of a diagram is estimated by its
+    // number of translation units
+    cost_model costs;
+    std::filesystem::path costs_path;
+    if (runtime_config.timings) {
+        costs_path = runtime_config.timings_path.empty()
+            ? cost_model::default_path(db->config().compilation_database_dir())
+            : std::filesystem::path{runtime_config.timings_path};
+        costs.load(costs_path);
+    }
+
+    stopwatch run_sw;
+    const auto run_cpu_start = util::get_process_cpu_time();
+
     std::vector<std::exception_ptr> errors;
 
+    std::vector<std::pair<int64_t, std::function<void()>>> generators;
+
+    // Definition index shared by all sequence diagrams generated in this run
+    std::optional<sequence_diagram::model::definition_index> definitions;
+
     for (const auto &[name, diagram] : config.diagrams) {
         // If there are any specific diagram names provided on the command
         // line, and this diagram is not in that list - skip it
@@ -274,31 +951,8 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
             continue;
 
         // If none of the generators supports the diagram type - skip it
-        bool at_least_one_generator_supports_diagram_type{false};
-        for (const auto generator_type : runtime_config.generators) {
-            if (generator_type == generator_type_t::plantuml) {
-                if (generator_supports_diagram_type<plantuml_generator_tag>(
-                        diagram->type()))
-                    at_least_one_generator_supports_diagram_type = true;
-            }
-            else if (generator_type == generator_type_t::json) {
-                if (generator_supports_diagram_type<json_generator_tag>(
-                        diagram->type()))
-                    at_least_one_generator_supports_diagram_type = true;
-            }
-            else if (generator_type == generator_type_t::mermaid) {
-                if (generator_supports_diagram_type<mermaid_generator_tag>(
-                        diagram->type()))
-                    at_least_one_generator_supports_diagram_type = true;
-            }
-            else if (generator_type == generator_type_t::graphml) {
-                if (generator_supports_diagram_type<graphml_generator_tag>(
-                        diagram->type()))
-                    at_least_one_generator_supports_diagram_type = true;
-            }
-        }
-
-        if (!at_least_one_generator_supports_diagram_type) {
+        if (!is_diagram_type_supported(
+                runtime_config.generators, diagram->type())) {
             LOG_INFO("Diagram '{}' not supported by any of selected "
                      "generators - skipping...",
                 name);
@@ -341,27 +995,66 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         LOG_DBG("Found {} matching translation unit commands for diagram {}",
             matching_commands_count, name);
 
+        diagram_profile *profile = nullptr;
+        if (prof)
+            profile = &prof->add_diagram(name, diagram->type());
+
+        const auto estimated_cost =
+            costs.estimate(diagram->type(), valid_translation_units);
+
+        if (profile != nullptr)
+            profile->estimated_cost = estimated_cost;
+
+        LOG_DBG("Estimated cost of diagram {} is {:.1f} ms", name,
+            estimated_cost);
+
+        if (!definitions && diagram->type() == model::diagram_t::kSequence) {
+            const auto &sequence_config =
+                dynamic_cast<const config::sequence_diagram &>(*diagram);
+
+            if (sequence_config.analyze_reachable_only() &&
+                sequence_config.use_definition_index()) {
+                load_definition_index(*db, definitions.emplace());
+            }
+        }
+
         auto generator = [&name = name, &diagram = diagram, &indicator,
                              db = std::ref(*db), matching_commands_count,
                              translation_units = valid_translation_units,
-                             runtime_config]() mutable -> void {
+                             runtime_config, profile, dependencies,
+                             costs = &costs,
+                             &definitions]() mutable -> void {
+            auto *index = definitions ? &*definitions : nullptr;
+
+            stopwatch sw;
+
             try {
                 if (indicator) {
                     indicator->add_progress_bar(name, matching_commands_count,
                         diagram_type_to_color(diagram->type()));
 
-                    generate_diagram(name, diagram, db, translation_units,
-                        runtime_config, [&indicator, &name]() {
+                    generate_diagram(
+                        name, diagram, db, translation_units, runtime_config,
+                        [&indicator, &name]() {
                             if (indicator)
                                 indicator->increment(name);
-                        });
+                        },
+                        profile, dependencies, costs, index);
 
                     if (indicator)
                         indicator->complete(name);
                 }
                 else {
                     generate_diagram(name, diagram, db, translation_units,
-                        runtime_config, {});
+                        runtime_config, {}, profile, dependencies, costs,
+                        index);
+                }
+
+                if (profile != nullptr) {
+                    profile->total = sw.elapsed();
+
+                    if (runtime_config.timings)
+                        costs->record(*profile);
                 }
             }
             catch (clanguml::generators::clang_tool_exception &e) {
@@ -381,9 +1074,21 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
             }
         };
 
-        futs.emplace_back(generator_executor.add(std::move(generator)));
+        // Estimated cost in microseconds is used as the task priority
+        generators.emplace_back(
+            std::llround(estimated_cost * 1000.0),
+            std::move(generator));
     }
 
+    // Start the most expensive diagrams first, so that the largest diagram
+    // does not end up being generated alone at the end
+    std::stable_sort(generators.begin(), generators.end(),
+        [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    for (auto &[priority, generator] : generators)
+        futs.emplace_back(
+            generator_executor.add(std::move(generator), priority));
+
     for (auto &fut : futs) {
         try {
             fut.get();
@@ -405,6 +1110,34 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         std::cout << termcolor::reset;
     }
 
+    if (prof && !generators.empty()) {
+        const auto run_time = timing{run_sw.elapsed().wall,
+            util::get_process_cpu_time() - run_cpu_start};
+        const auto cores =
+            std::max(static_cast<unsigned>(generator_executor.size()),
+                runtime_config.jobs);
+
+        prof->set_run(run_time, cores);
+
+        LOG_INFO("Generated {} diagrams in {:.1f} ms, core utilization {:.0f}% "
+                 "of {} cores",
+            generators.size(), run_time.wall_ms(), prof->utilization() * 100.0,
+            cores);
+    }
+
+    if (runtime_config.timings && !generators.empty())
+        costs.save(costs_path);
+
+    if (definitions)
+        save_definition_index(*db, *definitions);
+
+    if (runtime_config.profile) {
+        if (runtime_config.profile_output.empty())
+            prof->print(std::cout);
+        else
+            prof->save(runtime_config.profile_output);
+    }
+
     if (errors.empty())
         return 0;
 
@@ -21,34 +21,51 @@
 #include "class_diagram/generators/json/class_diagram_generator.h"
 #include "class_diagram/generators/mermaid/class_diagram_generator.h"
 #include "class_diagram/generators/plantuml/class_diagram_generator.h"
+#include "class_diagram/model/serialization.h"
 #include "cli/cli_handler.h"
 #include "common/compilation_database.h"
 #include "common/generators/clang_tool.h"
+#include "common/generators/cost_model.h"
+#include "common/generators/memory_governor.h"
+#include "common/generators/profiler.h"
+#include "common/generators/watcher.h"
+#include "common/generators/worker_processes.h"
 #include "common/model/filters/diagram_filter_factory.h"
+#include "common/model/serialization.h"
 #include "config/config.h"
 #include "include_diagram/generators/graphml/include_diagram_generator.h"
 #include "include_diagram/generators/json/include_diagram_generator.h"
 #include "include_diagram/generators/mermaid/include_diagram_generator.h"
 #include "include_diagram/generators/plantuml/include_diagram_generator.h"
+#include "include_diagram/model/serialization.h"
 #include "indicators/indicators.hpp"
 #include "package_diagram/generators/graphml/package_diagram_generator.h"
 #include "package_diagram/generators/json/package_diagram_generator.h"
 #include "package_diagram/generators/mermaid/package_diagram_generator.h"
 #include "package_diagram/generators/plantuml/package_diagram_generator.h"
+#include "package_diagram/model/serialization.h"
 #include "sequence_diagram/generators/json/sequence_diagram_generator.h"
 #include "sequence_diagram/generators/mermaid/sequence_diagram_generator.h"
 #include "sequence_diagram/generators/plantuml/sequence_diagram_generator.h"
+#include "sequence_diagram/model/definition_index.h"
+#include "sequence_diagram/model/serialization.h"
+#include "sequence_diagram/visitor/call_graph_visitor.h"
 #include "util/util.h"
 
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/Utils.h>
 #include <clang/Tooling/Tooling.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <string>
 #include <util/thread_pool_executor.h>
 #include <vector>
@@ -264,6 +281,41 @@ void find_translation_units_for_diagrams(
     const compilation_database &compilation_database,
     std::map<std::string, std::vector<std::string>> &translation_units_map);
 
+/**
+ * @brief Find functions reachable from sequence diagram `from` and `to`
+ *        conditions.
+ *
+ * This runs a cheap first pass over all translation units of the diagram,
+ * which only builds a call graph, and restricts building of detailed
+ * messages in the diagram model to functions reachable from the diagram
+ * start and end points. If any of the start or end points cannot be matched
+ * to the call graph (e.g. it is a regular expression), all functions are
+ * analyzed.
+ *
+ * If `use_definition_index` is enabled, the call graph is built only from
+ * translation units selected using the persistent definition index, and
+ * these translation units are returned to be used for the diagram.
+ *
+ * @param db Reference to compilation database
+ * @param name Name of the diagram
+ * @param config Sequence diagram configuration
+ * @param translation_units List of translation units for the diagram
+ * @param diagram Sequence diagram model to restrict
+ * @param quiet Whether clang tool should not log processed files
+ * @param profile Optional diagram profile to record timings
+ * @param index Optional definition index shared by diagrams, if not
+ *              provided the index is loaded and saved for this diagram only
+ * @return Translation units selected using definition index, or empty
+ *         optional if all translation units should be used
+ */
+std::optional<std::vector<std::string>> find_reachable_functions(
+    const common::compilation_database &db, const std::string &name,
+    const config::sequence_diagram &config,
+    const std::vector<std::string> &translation_units,
+    sequence_diagram::model::diagram &diagram, bool quiet,
+    diagram_profile *profile = nullptr,
+    sequence_diagram::model::definition_index *index = nullptr);
+
 /**
  * @brief Specialization of
  * [clang::ASTConsumer](https://clang.llvm.org/doxygen/classclang_1_1ASTConsumer.html)
@@ -280,11 +332,14 @@ template <typename DiagramModel, typename DiagramConfig,
     typename TranslationUnitVisitor>
 class diagram_ast_consumer : public clang::ASTConsumer {
     TranslationUnitVisitor visitor_;
+    diagram_profile *profile_;
 
 public:
     explicit diagram_ast_consumer(clang::CompilerInstance &ci,
-        DiagramModel &diagram, const DiagramConfig &config)
+        DiagramModel &diagram, const DiagramConfig &config,
+        diagram_profile *profile = nullptr)
         : visitor_{ci.getSourceManager(), diagram, config}
+        , profile_{profile}
     {
     }
 
@@ -292,14 +347,45 @@ public:
 
     void HandleTranslationUnit(clang::ASTContext &ast_context) override
     {
+        // Memoize element ids of declarations and types in this translation
+        // unit
+        common::translation_unit_id_cache id_cache;
+
+        if (profile_ == nullptr) {
+            visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+            visitor_.finalize();
+            return;
+        }
+
+        stopwatch sw;
         visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+        profile_->add_phase("traverse AST", sw.elapsed());
+
+        sw.restart();
         visitor_.finalize();
+        profile_->add_phase("finalize", sw.elapsed());
     }
 };
 
+/**
+ * @brief Base frontend action class for a diagram type.
+ *
+ * Include diagrams only need the inclusion directives, so their translation
+ * units are only preprocessed, without building the AST.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ */
+template <typename DiagramModel>
+using diagram_frontend_action_base_t = std::conditional_t<
+    std::is_same_v<DiagramModel, clanguml::include_diagram::model::diagram>,
+    clang::PreprocessOnlyAction, clang::ASTFrontendAction>;
+
 /**
  * @brief Specialization of
  * [clang::ASTFrontendAction](https://clang.llvm.org/doxygen/classclang_1_1ASTFrontendAction.html)
+ * or
+ * [clang::PreprocessOnlyAction](https://clang.llvm.org/doxygen/classclang_1_1PreprocessOnlyAction.html)
+ * for include diagrams.
  *
  * This class overrides the BeginSourceFileAction() and CreateASTConsumer()
  * methods to create and setup an appropriate diagram_ast_consumer instance.
@@ -310,13 +396,20 @@ public:
  */
 template <typename DiagramModel, typename DiagramConfig,
     typename DiagramVisitor>
-class diagram_fronted_action : public clang::ASTFrontendAction {
+class diagram_fronted_action
+    : public diagram_frontend_action_base_t<DiagramModel> {
+    using base_t = diagram_frontend_action_base_t<DiagramModel>;
+
 public:
     explicit diagram_fronted_action(DiagramModel &diagram,
-        const DiagramConfig &config, std::function<void()> progress)
+        const DiagramConfig &config, std::function<void()> progress,
+        diagram_profile *profile = nullptr,
+        dependency_tracker *dependencies = nullptr)
         : diagram_{diagram}
         , config_{config}
         , progress_{std::move(progress)}
+        , profile_{profile}
+        , dependencies_{dependencies}
     {
     }
 
@@ -325,11 +418,12 @@ public:
     {
         auto ast_consumer = std::make_unique<
             diagram_ast_consumer<DiagramModel, DiagramConfig, DiagramVisitor>>(
-            CI, diagram_, config_);
+            CI, diagram_, config_, profile_);
 
         if constexpr (!std::is_same_v<DiagramModel,
                           clanguml::include_diagram::model::diagram>) {
-            ast_consumer->visitor().set_tu_path(getCurrentFile().str());
+            ast_consumer->visitor().set_tu_path(
+                this->getCurrentFile().str());
         }
 
         return ast_consumer;
@@ -338,7 +432,7 @@ public:
 protected:
     bool BeginSourceFileAction(clang::CompilerInstance &ci) override
     {
-        LOG_DBG("Visiting source file: {}", getCurrentFile().str());
+        LOG_DBG("Visiting source file: {}", this->getCurrentFile().str());
 
         // Update progress indicators, if enabled, on each translation
         // unit
@@ -356,13 +450,48 @@ protected:
             pp.addPPCallbacks(std::move(find_includes_callback));
         }
 
+        // Record files included by the translation unit, in order to
+        // determine which diagrams must be regenerated in watch mode
+        if (dependencies_ != nullptr) {
+            dependency_collector_ =
+                std::make_shared<clang::DependencyCollector>();
+            dependency_collector_->attachToPreprocessor(ci.getPreprocessor());
+        }
+
         return true;
     }
 
+    void EndSourceFileAction() override
+    {
+        if (dependencies_ != nullptr && dependency_collector_) {
+            auto &file_manager =
+                this->getCompilerInstance().getFileManager();
+
+            const auto make_absolute = [&file_manager](llvm::StringRef p) {
+                llvm::SmallString<256> path{p};
+                file_manager.makeAbsolutePath(path);
+                llvm::sys::path::remove_dots(path, true);
+                return path.str().str();
+            };
+
+            std::vector<std::string> files;
+            for (const auto &file : dependency_collector_->getDependencies())
+                files.emplace_back(make_absolute(file));
+
+            dependencies_->set_dependencies(diagram_.name(),
+                make_absolute(this->getCurrentFile()), files);
+        }
+
+        base_t::EndSourceFileAction();
+    }
+
 private:
     DiagramModel &diagram_;
     const DiagramConfig &config_;
     std::function<void()> progress_;
+    diagram_profile *profile_;
+    dependency_tracker *dependencies_;
+    std::shared_ptr<clang::DependencyCollector> dependency_collector_;
 };
 
 /**
@@ -382,25 +511,513 @@ class diagram_action_visitor_factory
     : public clang::tooling::FrontendActionFactory {
 public:
     explicit diagram_action_visitor_factory(DiagramModel &diagram,
-        const DiagramConfig &config, std::function<void()> progress)
+        const DiagramConfig &config, std::function<void()> progress,
+        diagram_profile *profile = nullptr,
+        dependency_tracker *dependencies = nullptr)
         : diagram_{diagram}
         , config_{config}
         , progress_{std::move(progress)}
+        , profile_{profile}
+        , dependencies_{dependencies}
     {
     }
 
     std::unique_ptr<clang::FrontendAction> create() override
     {
         return std::make_unique<diagram_fronted_action<DiagramModel,
-            DiagramConfig, DiagramVisitor>>(diagram_, config_, progress_);
+            DiagramConfig, DiagramVisitor>>(
+            diagram_, config_, progress_, profile_, dependencies_);
     }
 
 private:
     DiagramModel &diagram_;
     const DiagramConfig &config_;
     std::function<void()> progress_;
+    diagram_profile *profile_;
+    dependency_tracker *dependencies_;
 };
 
+/**
+ * @brief Build the diagram model in forked worker processes
+ *
+ * Each worker parses a shard of the translation units into its own partial
+ * diagram model, which is serialized and merged into `diagram` by the parent
+ * process. Timings and dependencies of the translation units are collected
+ * by the workers and passed to the parent along with the partial models.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ * @param db Reference to compilation database
+ * @param name Name of the diagram
+ * @param config Diagram configuration
+ * @param translation_units List of translation units for the diagram
+ * @param diagram Diagram model to merge the partial models into
+ * @param jobs Maximum number of concurrent worker processes
+ * @param progress Function to report translation unit progress
+ * @param profile Optional diagram profile to record timings
+ * @param dependencies Optional tracker of translation units dependencies
+ * @param costs Optional cost model used to balance the worker processes
+ */
+template <typename DiagramModel, typename DiagramConfig,
+    typename DiagramVisitor>
+void generate_in_worker_processes(const common::compilation_database &db,
+    const std::string &name, DiagramConfig &config,
+    const std::vector<std::string> &translation_units, DiagramModel &diagram,
+    unsigned jobs, const std::function<void()> &progress,
+    diagram_profile *profile, dependency_tracker *dependencies = nullptr,
+    const cost_model *costs = nullptr)
+{
+    LOG_INFO("Parsing {} translation units of diagram {} in {} worker "
+             "processes",
+        translation_units.size(), name,
+        std::min<std::size_t>(jobs, translation_units.size()));
+
+    // Workers can only be forked safely, if no other thread is generating
+    // diagrams at the same time
+    assert(util::thread_pool_executor::current() == nullptr ||
+        util::thread_pool_executor::current()->size() == 1);
+
+    // Partial models are merged only after all workers have finished
+    stopwatch sw;
+    bool workers_finished{false};
+    const auto record_workers_time = [&]() {
+        if (profile != nullptr && !workers_finished)
+            profile->add_phase("worker processes", sw.elapsed());
+        workers_finished = true;
+    };
+
+    const auto process_shard =
+        [&](const std::vector<std::string> &shard) -> std::string {
+        diagram_profile shard_profile;
+        dependency_tracker shard_dependencies;
+        auto *worker_profile = profile != nullptr ? &shard_profile : nullptr;
+        auto *worker_dependencies =
+            dependencies != nullptr ? &shard_dependencies : nullptr;
+
+        clanguml::generators::clang_tool clang_tool(
+            diagram.type(), name, db, shard, config.get_relative_to()(), true);
+
+        clang_tool.set_profile(worker_profile);
+
+        auto action_factory =
+            std::make_unique<diagram_action_visitor_factory<DiagramModel,
+                DiagramConfig, DiagramVisitor>>(diagram, config,
+                std::function<void()>{}, worker_profile, worker_dependencies);
+
+        clang_tool.run(action_factory.get());
+
+        model::binary_writer writer;
+        serialize(diagram, writer);
+        if (worker_profile != nullptr)
+            serialize(*worker_profile, writer);
+        if (worker_dependencies != nullptr)
+            serialize(*worker_dependencies, writer);
+        return writer.release();
+    };
+
+    const auto merge_shard = [&](const std::vector<std::string> &shard,
+                                 std::string_view data) {
+        record_workers_time();
+
+        stopwatch merge_sw;
+
+        model::binary_reader reader{data};
+        deserialize(reader, diagram);
+        if (profile != nullptr)
+            deserialize(reader, *profile);
+        if (dependencies != nullptr)
+            deserialize(reader, *dependencies);
+
+        if (profile != nullptr)
+            profile->add_phase("merge models", merge_sw.elapsed());
+
+        if (progress) {
+            for (auto i = 0U; i < shard.size(); i++)
+                progress();
+        }
+    };
+
+    translation_unit_cost_t cost;
+    if (costs != nullptr)
+        cost = [costs, type = diagram.type()](const std::string &tu) {
+            return costs->estimate(type, tu);
+        };
+
+    const auto skipped = run_worker_processes(
+        translation_units, jobs, process_shard, merge_shard, cost);
+
+    record_workers_time();
+
+    if (progress) {
+        for (auto i = 0U; i < skipped.size(); i++)
+            progress();
+    }
+}
+
+/**
+ * @brief Create an empty diagram model for a part of the translation units
+ *        of a diagram.
+ *
+ * The partial model has the name and filter of the diagram, and for sequence
+ * diagrams also the set of reachable functions.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @param diagram Diagram model
+ * @param config Diagram configuration
+ * @return Empty partial diagram model
+ */
+template <typename DiagramModel, typename DiagramConfig>
+std::unique_ptr<DiagramModel> make_partial_model(
+    const DiagramModel &diagram, DiagramConfig &config)
+{
+    auto partial = std::make_unique<DiagramModel>();
+    partial->set_name(diagram.name());
+    partial->set_filter(
+        model::diagram_filter_factory::create(*partial, config));
+
+    if constexpr (std::is_same_v<DiagramModel,
+                      clanguml::sequence_diagram::model::diagram>) {
+        if (diagram.reachable_functions())
+            partial->set_reachable_functions(*diagram.reachable_functions());
+    }
+
+    return partial;
+}
+
+/**
+ * @brief Build the diagram model in nested tasks of the current thread pool
+ *
+ * Each task parses a shard of the translation units into its own partial
+ * diagram model and records its timings in its own profile. After all
+ * tasks have finished, the partial models are merged into `diagram` in the
+ * order of the shards.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ * @param db Reference to compilation database
+ * @param name Name of the diagram
+ * @param config Diagram configuration
+ * @param translation_units List of translation units for the diagram
+ * @param diagram Diagram model to merge the partial models into
+ * @param concurrency Number of shards
+ * @param progress Function to report translation unit progress
+ * @param profile Optional diagram profile to record timings
+ * @param dependencies Optional tracker of translation units dependencies
+ * @param costs Optional cost model used to balance the shards
+ */
+template <typename DiagramModel, typename DiagramConfig,
+    typename DiagramVisitor>
+void generate_in_nested_tasks(const common::compilation_database &db,
+    const std::string &name, DiagramConfig &config,
+    const std::vector<std::string> &translation_units, DiagramModel &diagram,
+    unsigned concurrency, const std::function<void()> &progress,
+    diagram_profile *profile, dependency_tracker *dependencies = nullptr,
+    const cost_model *costs = nullptr)
+{
+    translation_unit_cost_t cost;
+    if (costs != nullptr)
+        cost = [costs, type = diagram.type()](const std::string &tu) {
+            return costs->estimate(type, tu);
+        };
+
+    const auto shards = make_shards(translation_units, concurrency, cost);
+
+    LOG_INFO("Parsing {} translation units of diagram {} in {} tasks",
+        translation_units.size(), name, shards.size());
+
+    std::vector<std::unique_ptr<DiagramModel>> partials;
+    std::vector<diagram_profile> shard_profiles(shards.size());
+    std::vector<std::function<void()>> tasks;
+
+    for (auto i = 0U; i < shards.size(); i++) {
+        partials.emplace_back(make_partial_model(diagram, config));
+
+        tasks.emplace_back([&, i]() {
+            clanguml::generators::clang_tool clang_tool(diagram.type(), name,
+                db, shards[i], config.get_relative_to()(), !!progress);
+
+            auto *shard_profile =
+                profile != nullptr ? &shard_profiles[i] : nullptr;
+
+            clang_tool.set_profile(shard_profile);
+
+            auto action_factory =
+                std::make_unique<diagram_action_visitor_factory<DiagramModel,
+                    DiagramConfig, DiagramVisitor>>(*partials[i], config,
+                    progress, shard_profile, dependencies);
+
+            clang_tool.run(action_factory.get());
+        });
+    }
+
+    util::run_nested(tasks);
+
+    stopwatch sw;
+
+    for (auto i = 0U; i < shards.size(); i++) {
+        model::binary_writer writer;
+        serialize(*partials[i], writer);
+        partials[i].reset();
+
+        model::binary_reader reader{writer.buffer()};
+        deserialize(reader, diagram);
+
+        if (profile != nullptr)
+            profile->merge(shard_profiles[i]);
+    }
+
+    if (profile != nullptr)
+        profile->add_phase("merge models", sw.elapsed());
+}
+
+/**
+ * @brief Parse a single translation unit into a serialized partial model
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ * @param db Reference to compilation database
+ * @param name Name of the diagram
+ * @param config Diagram configuration
+ * @param translation_unit Translation unit to parse
+ * @param diagram Diagram model providing the context of the partial model
+ * @param progress Function to report translation unit progress
+ * @param profile Optional diagram profile to record timings
+ * @param dependencies Output set of files included by the translation unit
+ * @return Serialized partial model
+ */
+template <typename DiagramModel, typename DiagramConfig,
+    typename DiagramVisitor>
+std::string generate_partial_model(const common::compilation_database &db,
+    const std::string &name, DiagramConfig &config,
+    const std::string &translation_unit, const DiagramModel &diagram,
+    const std::function<void()> &progress, diagram_profile *profile,
+    std::set<std::string> &dependencies)
+{
+    auto partial = make_partial_model(diagram, config);
+    dependency_tracker translation_unit_dependencies;
+
+    clanguml::generators::clang_tool clang_tool(diagram.type(), name, db,
+        {translation_unit}, config.get_relative_to()(), true);
+
+    clang_tool.set_profile(profile);
+
+    auto action_factory = std::make_unique<diagram_action_visitor_factory<
+        DiagramModel, DiagramConfig, DiagramVisitor>>(*partial, config,
+        progress, profile, &translation_unit_dependencies);
+
+    clang_tool.run(action_factory.get());
+
+    // The frontend action records the dependencies under the absolute path
+    // of the file, which can differ from the path in the compilation
+    // database
+    for (const auto &[key, files] :
+        translation_unit_dependencies.dependencies())
+        dependencies.insert(files.begin(), files.end());
+
+    model::binary_writer writer;
+    serialize(*partial, writer);
+    return writer.release();
+}
+
+/**
+ * @brief Build the diagram model from partial models of its translation
+ *        units cached between generations in watch mode
+ *
+ * Only translation units without a partial model in `dependencies`, or
+ * whose partial model was invalidated by a change to any of their
+ * dependencies, are parsed - in nested tasks of the current thread pool, or
+ * in worker processes if `jobs` is larger than 1. If any of the partial
+ * models changed, the partial models of all translation units are merged
+ * into `diagram` in the order of `translation_units`.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ * @param db Reference to compilation database
+ * @param name Name of the diagram
+ * @param config Diagram configuration
+ * @param translation_units List of translation units for the diagram
+ * @param diagram Diagram model to merge the partial models into
+ * @param jobs Maximum number of concurrent worker processes
+ * @param progress Function to report translation unit progress
+ * @param profile Optional diagram profile to record timings
+ * @param dependencies Tracker of dependencies and partial models
+ * @param costs Optional cost model used to balance the worker processes
+ * @return True, if the diagram model changed since the previous call
+ */
+template <typename DiagramModel, typename DiagramConfig,
+    typename DiagramVisitor>
+bool generate_incrementally(const common::compilation_database &db,
+    const std::string &name, DiagramConfig &config,
+    const std::vector<std::string> &translation_units, DiagramModel &diagram,
+    unsigned jobs, const std::function<void()> &progress,
+    diagram_profile *profile, dependency_tracker &dependencies,
+    const cost_model *costs = nullptr)
+{
+    // Partial models of sequence diagrams only contain messages from
+    // functions reachable in the diagram
+    std::size_t context{0};
+    if constexpr (std::is_same_v<DiagramModel,
+                      clanguml::sequence_diagram::model::diagram>) {
+        if (diagram.reachable_functions()) {
+            std::vector<std::uint64_t> ids{
+                diagram.reachable_functions()->begin(),
+                diagram.reachable_functions()->end()};
+            std::sort(ids.begin(), ids.end());
+
+            context = ids.size();
+            for (const auto id : ids)
+                context ^= std::hash<std::uint64_t>{}(id) + 0x9e3779b9 +
+                    (context << 6U) + (context >> 2U); // NOLINT
+        }
+    }
+
+    bool changed = dependencies.set_context(name, context, translation_units);
+
+    const auto outdated =
+        dependencies.outdated_translation_units(name, translation_units);
+
+    LOG_INFO("Parsing {} of {} translation units of diagram {}",
+        outdated.size(), translation_units.size(), name);
+
+    if (progress) {
+        for (auto i = outdated.size(); i < translation_units.size(); i++)
+            progress();
+    }
+
+    const auto store = [&](const std::string &tu, std::string model,
+                           const std::set<std::string> &files) {
+        dependencies.set_dependencies(
+            name, tu, std::vector<std::string>{files.begin(), files.end()});
+
+        if (dependencies.set_partial_model(name, tu, std::move(model)))
+            changed = true;
+    };
+
+    if (jobs > 1 && outdated.size() > 1) {
+        const auto process_shard =
+            [&](const std::vector<std::string> &shard) -> std::string {
+            diagram_profile shard_profile;
+
+            model::binary_writer writer;
+            writer.write_uint(shard.size());
+            for (const auto &tu : shard) {
+                std::set<std::string> files;
+                const auto model =
+                    generate_partial_model<DiagramModel, DiagramConfig,
+                        DiagramVisitor>(db, name, config, tu, diagram,
+                        std::function<void()>{},
+                        profile != nullptr ? &shard_profile : nullptr, files);
+
+                writer.write_string(tu);
+                writer.write_strings({files.begin(), files.end()});
+                writer.write_uint(model.size());
+                writer.write_bytes(model);
+            }
+
+            if (profile != nullptr)
+                serialize(shard_profile, writer);
+
+            return writer.release();
+        };
+
+        const auto merge_shard = [&](const std::vector<std::string> &shard,
+                                     std::string_view data) {
+            model::binary_reader reader{data};
+
+            const auto count = reader.read_uint();
+            for (auto i = 0U; i < count; i++) {
+                auto tu = reader.read_string();
+                auto files = reader.read_strings();
+                const auto size = reader.read_uint();
+                store(tu, std::string{reader.read_bytes(size)},
+                    {files.begin(), files.end()});
+            }
+
+            if (profile != nullptr)
+                deserialize(reader, *profile);
+
+            if (progress) {
+                for (auto i = 0U; i < shard.size(); i++)
+                    progress();
+            }
+        };
+
+        translation_unit_cost_t cost;
+        if (costs != nullptr)
+            cost = [costs, type = diagram.type()](const std::string &tu) {
+                return costs->estimate(type, tu);
+            };
+
+        const auto skipped = run_worker_processes(
+            outdated, jobs, process_shard, merge_shard, cost);
+
+        if (progress) {
+            for (auto i = 0U; i < skipped.size(); i++)
+                progress();
+        }
+    }
+    else {
+        std::vector<std::optional<std::string>> models(outdated.size());
+        std::vector<std::set<std::string>> files(outdated.size());
+        std::vector<diagram_profile> profiles(outdated.size());
+        std::vector<std::function<void()>> tasks;
+
+        for (auto i = 0U; i < outdated.size(); i++) {
+            tasks.emplace_back([&, i]() {
+                models[i] = generate_partial_model<DiagramModel,
+                    DiagramConfig, DiagramVisitor>(db, name, config,
+                    outdated[i], diagram, progress,
+                    profile != nullptr ? &profiles[i] : nullptr, files[i]);
+            });
+        }
+
+        // Keep partial models of translation units parsed successfully, even
+        // if parsing of other translation units failed
+        std::exception_ptr error;
+        try {
+            util::run_nested(tasks);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        for (auto i = 0U; i < outdated.size(); i++) {
+            if (profile != nullptr)
+                profile->merge(profiles[i]);
+
+            if (models[i])
+                store(outdated[i], std::move(*models[i]), files[i]);
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    if (!changed)
+        return false;
+
+    stopwatch sw;
+
+    for (const auto &tu : translation_units) {
+        const auto model = dependencies.partial_model(name, tu);
+        if (!model)
+            continue;
+
+        model::binary_reader reader{*model};
+        deserialize(reader, diagram);
+    }
+
+    if (profile != nullptr)
+        profile->add_phase("merge models", sw.elapsed());
+
+    return true;
+}
+
 /**
  * @brief Specialization of
  * [clang::ASTFrontendAction](https://clang.llvm.org/doxygen/classclang_1_1tooling_1_1FrontendActionFactory.html)
@@ -408,18 +1025,28 @@ private:
  * This is the entry point function to initiate AST frontend action for a
  * specific diagram.
  *
+ * In watch mode, i.e. when `dependencies` is provided, only translation
+ * units invalidated since the previous call are parsed (see
+ * @ref generate_incrementally()).
+ *
  * @embed{diagram_generate_generic_sequence.svg}
  *
  * @tparam DiagramModel Type of diagram_model
  * @tparam DiagramConfig Type of diagram_config
  * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ * @return Diagram model, or nullptr in watch mode if the model did not
+ *         change since the previous call
  */
 template <typename DiagramModel, typename DiagramConfig,
     typename DiagramVisitor>
 std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
     const std::string &name, DiagramConfig &config,
     const std::vector<std::string> &translation_units, bool /*verbose*/ = false,
-    std::function<void()> progress = {})
+    std::function<void()> progress = {}, diagram_profile *profile = nullptr,
+    dependency_tracker *dependencies = nullptr, unsigned jobs = 1,
+    const std::filesystem::path &model_path = {},
+    const cost_model *costs = nullptr,
+    sequence_diagram::model::definition_index *index = nullptr)
 {
     LOG_INFO("Generating diagram {}", name);
 
@@ -433,20 +1060,124 @@ std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
 
     const bool quiet_clang_tool = !!progress;
 
-    clanguml::generators::clang_tool clang_tool(diagram->type(), name, db,
-        translation_units, config.get_relative_to()(), quiet_clang_tool);
+    std::optional<std::vector<std::string>> selected_translation_units;
 
-    auto action_factory =
-        std::make_unique<diagram_action_visitor_factory<DiagramModel,
-            DiagramConfig, DiagramVisitor>>(
-            *diagram, config, std::move(progress));
+    if constexpr (std::is_same_v<DiagramModel,
+                      clanguml::sequence_diagram::model::diagram>) {
+        if (config.analyze_reachable_only()) {
+            selected_translation_units =
+                find_reachable_functions(db, name, config, translation_units,
+                    *diagram, quiet_clang_tool, profile, index);
+        }
+    }
 
-    clang_tool.run(action_factory.get());
+    const auto &effective_translation_units = selected_translation_units
+        ? *selected_translation_units
+        : translation_units;
+
+    if (dependencies != nullptr) {
+        if (!generate_incrementally<DiagramModel, DiagramConfig,
+                DiagramVisitor>(db, name, config, effective_translation_units,
+                *diagram, jobs, progress, profile, *dependencies, costs)) {
+            LOG_INFO("Model of diagram {} did not change", name);
+            return {};
+        }
+    }
+    else if (jobs > 1 && effective_translation_units.size() > 1) {
+        generate_in_worker_processes<DiagramModel, DiagramConfig,
+            DiagramVisitor>(db, name, config, effective_translation_units,
+            *diagram, jobs, progress, profile, dependencies, costs);
+    }
+    else if (auto *executor = util::thread_pool_executor::current();
+             executor != nullptr && executor->size() > 1 &&
+             effective_translation_units.size() > 1) {
+        generate_in_nested_tasks<DiagramModel, DiagramConfig,
+            DiagramVisitor>(db, name, config, effective_translation_units,
+            *diagram, static_cast<unsigned>(executor->size()), progress,
+            profile, dependencies, costs);
+    }
+    else {
+        clanguml::generators::clang_tool clang_tool(diagram->type(), name, db,
+            effective_translation_units, config.get_relative_to()(),
+            quiet_clang_tool);
+
+        clang_tool.set_profile(profile);
+
+        auto action_factory =
+            std::make_unique<diagram_action_visitor_factory<DiagramModel,
+                DiagramConfig, DiagramVisitor>>(
+                *diagram, config, std::move(progress), profile, dependencies);
+
+        clang_tool.run(action_factory.get());
+    }
+
+    diagram->set_complete(true);
+
+    stopwatch sw;
+
+    // The model is saved before filtering, so that it can be regenerated
+    // with different filters
+    if (!model_path.empty()) {
+        model::save_model(*diagram, model_path);
+
+        if (profile != nullptr)
+            profile->add_phase("save model", sw.elapsed());
+
+        LOG_INFO("Saved {} diagram model to {}", name, model_path.string());
+
+        sw.restart();
+    }
+
+    diagram->finalize();
+
+    if (profile != nullptr)
+        profile->add_phase("apply_filter", sw.elapsed());
+
+    return diagram;
+}
+
+/**
+ * @brief Load diagram model saved by @ref generate instead of parsing the
+ *        translation units.
+ *
+ * The loaded model is filtered using the current diagram configuration.
+ *
+ * @tparam DiagramModel Type of diagram_model
+ * @tparam DiagramConfig Type of diagram_config
+ * @param name Name of the diagram
+ * @param config Diagram configuration
+ * @param model_path Path to the saved model
+ * @param profile Optional diagram profile to record timings
+ * @return Diagram model
+ */
+template <typename DiagramModel, typename DiagramConfig>
+std::unique_ptr<DiagramModel> load(const std::string &name,
+    DiagramConfig &config, const std::filesystem::path &model_path,
+    diagram_profile *profile = nullptr)
+{
+    LOG_INFO("Loading diagram {} model from {}", name, model_path.string());
+
+    auto diagram = std::make_unique<DiagramModel>();
+    diagram->set_name(name);
+    diagram->set_filter(
+        model::diagram_filter_factory::create(*diagram, config));
+
+    stopwatch sw;
+
+    model::load_model(model_path, *diagram);
+
+    if (profile != nullptr)
+        profile->add_phase("load model", sw.elapsed());
 
     diagram->set_complete(true);
 
+    sw.restart();
+
     diagram->finalize();
 
+    if (profile != nullptr)
+        profile->add_phase("apply_filter", sw.elapsed());
+
     return diagram;
 }
 
@@ -460,13 +1191,43 @@ std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
  * @param generators List of generator types to be used for the diagram
  * @param verbose Log level
  * @param progress Function to report translation unit progress
+ * @param profile Optional diagram profile to record timings
+ * @param dependencies Optional tracker of translation units dependencies
+ * @param costs Optional cost model of translation units
+ * @param index Optional definition index shared by sequence diagrams
  */
 void generate_diagram(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
     const common::compilation_database &db,
     const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config,
-    std::function<void()> &&progress);
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_profile *profile = nullptr,
+    dependency_tracker *dependencies = nullptr,
+    const cost_model *costs = nullptr,
+    sequence_diagram::model::definition_index *index = nullptr);
+
+/**
+ * @brief Regenerate diagrams from models saved with `--save-model`
+ *
+ * @param diagram_names List of diagram names to generate
+ * @param config Reference to config instance
+ * @param runtime_config Command line options
+ * @return 0 if success, otherwise error code
+ */
+int generate_diagrams_from_models(
+    const std::vector<std::string> &diagram_names,
+    clanguml::config::config &config,
+    const cli::runtime_config &runtime_config);
+
+/**
+ * @brief Get path of the saved model of a diagram
+ *
+ * @param output_directory Path to output directory
+ * @param name Name of the diagram
+ * @return Path to the saved model
+ */
+std::filesystem::path model_path(
+    const std::string &output_directory, const std::string &name);
 
 /**
  * @brief Generate diagrams
@@ -480,6 +1241,7 @@ void generate_diagram(const std::string &name,
  * @param progress Whether progress indicators should be displayed
  * @param generators List of generator types to use for each diagram
  * @param translation_units_map Map of translation units for each file
+ * @param dependencies Optional tracker of translation units dependencies
  *
  * @return 0 if success, otherwise error code
  */
@@ -488,7 +1250,8 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
     const common::compilation_database_ptr &db,
     const cli::runtime_config &runtime_config,
     const std::map<std::string, std::vector<std::string>>
-        &translation_units_map);
+        &translation_units_map,
+    dependency_tracker *dependencies = nullptr);
 
 /**
  * @brief Return indicators progress bar color for diagram type
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "common/generators/generator.h"
+#include "common/generators/graphml/xml_writer.h"
 #include "common/model/element_view.h"
 #include "common/model/filters/diagram_filter.h"
 #include "config/config.h"
@@ -30,7 +31,6 @@
 #include <clang/Tooling/CompilationDatabase.h>
 #include <clang/Tooling/Tooling.h>
 #include <glob/glob.hpp>
-#include <pugixml/pugixml.hpp>
 
 #include <ostream>
 
@@ -43,8 +43,8 @@ using clanguml::common::model::element;
 using clanguml::common::model::message_t;
 using clanguml::common::model::relationship_t;
 
-using graphml_t = pugi::xml_document;
-using graphml_node_t = pugi::xml_node;
+using graphml_t = xml_writer;
+using graphml_node_t = xml_element;
 
 /**
  * The types of graph nodes in the GraphML XML document
@@ -203,9 +203,9 @@ public:
     void generate_notes(const T &e, graphml_node_t &parent) const;
 
     /**
-     * @brief Generate metadata element with diagram metadata
+     * @brief Generate metadata comments with diagram metadata
      *
-     * @param parent Root JSON object
+     * @param parent GraphML document writer
      */
     void generate_metadata(graphml_t &parent) const;
 
@@ -237,7 +237,7 @@ public:
         const model::diagram_element &c, graphml_node_t &parent) const;
 
     template <typename T>
-    void generate_link(pugi::xml_node &node, const T &c) const;
+    void generate_link(graphml_node_t &node, const T &c) const;
 
     const property_keymap_t &graph_properties() const
     {
@@ -254,23 +254,23 @@ public:
         return edge_properties_;
     }
 
-    pugi::xml_node make_node(
+    graphml_node_t make_node(
         graphml_node_t &parent, const std::string &id) const;
 
-    pugi::xml_node make_graph(
+    graphml_node_t make_graph(
         graphml_node_t &parent, const std::string &id) const;
 
-    pugi::xml_node make_subgraph(graphml_node_t &parent, const std::string &id,
+    graphml_node_t make_subgraph(graphml_node_t &parent, const std::string &id,
         const std::string &name = "", const std::string &type = "") const;
 
-    void add_data(pugi::xml_node &node, const std::string &key,
+    void add_data(graphml_node_t &node, const std::string &key,
         const std::string &value, bool cdata = false) const;
 
-    void add_cdata(pugi::xml_node &node, const std::string &key,
+    void add_cdata(graphml_node_t &node, const std::string &key,
         const std::string &value) const;
 
 protected:
-    void generate_key(pugi::xml_node &parent, const std::string &attr_name,
+    void generate_key(graphml_node_t &parent, const std::string &attr_name,
         const std::string &for_value, const std::string &id_value,
         const std::string &attr_type = "string") const;
 
@@ -306,26 +306,24 @@ void generator<C, D>::generate(std::ostream &ostr) const
 {
     const auto &config = generators::generator<C, D>::config();
 
-    graphml_t graph;
+    // The document is written directly to the output stream, so all
+    // elements must be generated in the document order
+    graphml_t graph{ostr};
 
-    auto node_decl = graph.append_child(pugi::node_declaration);
-    node_decl.append_attribute("version") = "1.0";
-    node_decl.append_attribute("encoding") = "UTF-8";
+    graph.write_declaration("1.0", "UTF-8");
 
     generate_metadata(graph);
 
     auto graphml = graph.append_child("graphml");
-    graphml.append_attribute("xmlns") = "http://graphml.graphdrawing.org/xmlns";
-    graphml.append_attribute("xmlns:xsi") =
-        "http://www.w3.org/2001/XMLSchema-instance";
-    graphml.append_attribute("xsi:schemaLocation") =
+    graphml.append_attribute("xmlns", "http://graphml.graphdrawing.org/xmlns");
+    graphml.append_attribute(
+        "xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance");
+    graphml.append_attribute("xsi:schemaLocation",
         "http://graphml.graphdrawing.org/xmlns "
-        "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd";
+        "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd");
 
     if (config.title) {
-        graphml.append_child("desc")
-            .append_child(pugi::node_cdata)
-            .set_value(config.title());
+        graphml.append_child("desc").set_cdata(config.title());
     }
 
     generate_keys(graphml);
@@ -339,7 +337,7 @@ void generator<C, D>::generate(std::ostream &ostr) const
 
     generate_diagram(graph_node);
 
-    graph.save(ostr, "  ");
+    graph.close();
 }
 
 template <typename C, typename D>
@@ -377,9 +375,9 @@ void generator<C, D>::generate_relationships(
 
         auto edge_node = parent.append_child("edge");
 
-        edge_node.append_attribute("id") = fmt::format("e{}", edge_id_++);
-        edge_node.append_attribute("source") = *maybe_src_id;
-        edge_node.append_attribute("target") = *maybe_target_id;
+        edge_node.append_attribute("id", fmt::format("e{}", edge_id_++));
+        edge_node.append_attribute("source", *maybe_src_id);
+        edge_node.append_attribute("target", *maybe_target_id);
 
         const auto maybe_link = generator<C, D>::render_link(r);
 
@@ -455,9 +453,9 @@ void generator<C, D>::generate_notes(const T &p, graphml_node_t &parent) const
     for (const auto &[element_node_id, note_node_id] : note_id_map) {
         auto edge_node = parent.append_child("edge");
 
-        edge_node.append_attribute("id") = fmt::format("e{}", edge_id_++);
-        edge_node.append_attribute("source") = note_node_id;
-        edge_node.append_attribute("target") = element_node_id;
+        edge_node.append_attribute("id", fmt::format("e{}", edge_id_++));
+        edge_node.append_attribute("source", note_node_id);
+        edge_node.append_attribute("target", element_node_id);
 
         add_data(edge_node, "type", "none");
     }
@@ -467,45 +465,43 @@ template <typename C, typename D>
 void generator<C, D>::generate_metadata(graphml_t &parent) const
 {
     if (generators::generator<C, D>::config().generate_metadata()) {
-        auto comment = parent.append_child(pugi::node_comment);
-        comment.set_value(fmt::format(
+        parent.write_comment(fmt::format(
             " Generated with clang-uml {} ", clanguml::version::version()));
 
-        comment = parent.append_child(pugi::node_comment);
-        comment.set_value(
+        parent.write_comment(
             fmt::format(" LLVM version {} ", clang::getClangFullVersion()));
     }
 }
 
 template <typename C, typename D>
-pugi::xml_node generator<C, D>::make_node(
+graphml_node_t generator<C, D>::make_node(
     graphml_node_t &parent, const std::string &id) const
 {
     auto result = parent.append_child("node");
-    result.append_attribute("id") = id;
+    result.append_attribute("id", id);
     return result;
 }
 
 template <typename C, typename D>
-pugi::xml_node generator<C, D>::make_graph(
+graphml_node_t generator<C, D>::make_graph(
     graphml_node_t &parent, const std::string &id) const
 {
     auto result = parent.append_child("graph");
-    result.append_attribute("id") = graph_ids_.add(id);
-    result.append_attribute("edgedefault").set_value("directed");
-    result.append_attribute("parse.nodeids").set_value("canonical");
-    result.append_attribute("parse.edgeids").set_value("canonical");
-    result.append_attribute("parse.order").set_value("nodesfirst");
+    result.append_attribute("id", graph_ids_.add(id));
+    result.append_attribute("edgedefault", "directed");
+    result.append_attribute("parse.nodeids", "canonical");
+    result.append_attribute("parse.edgeids", "canonical");
+    result.append_attribute("parse.order", "nodesfirst");
     return result;
 }
 
 template <typename C, typename D>
-pugi::xml_node generator<C, D>::make_subgraph(graphml_node_t &parent,
+graphml_node_t generator<C, D>::make_subgraph(graphml_node_t &parent,
     const std::string &id, const std::string &name,
     const std::string &type) const
 {
     auto graph_node = parent.append_child("node");
-    graph_node.append_attribute("id") = node_ids_.add(id);
+    graph_node.append_attribute("id", node_ids_.add(id));
 
     if (!name.empty())
         add_data(graph_node, "name", name);
@@ -517,31 +513,31 @@ pugi::xml_node generator<C, D>::make_subgraph(graphml_node_t &parent,
 }
 
 template <typename C, typename D>
-void generator<C, D>::add_data(pugi::xml_node &node,
+void generator<C, D>::add_data(graphml_node_t &node,
     const std::string &key_name, const std::string &value, bool cdata) const
 {
-    using namespace std::string_literals;
+    using namespace std::string_view_literals;
 
     std::optional<std::pair<std::string, property_type>> key_id;
-    if (node.name() == "node"s)
+    if (node.name() == "node"sv)
         key_id = node_properties().get(key_name);
-    else if (node.name() == "graph"s)
+    else if (node.name() == "graph"sv)
         key_id = graph_properties().get(key_name);
-    else if (node.name() == "edge"s)
+    else if (node.name() == "edge"sv)
         key_id = edge_properties().get(key_name);
 
     if (key_id.has_value()) {
         auto data = node.append_child("data");
-        data.append_attribute("key") = key_id->first;
+        data.append_attribute("key", key_id->first);
         if (cdata)
-            data.append_child(pugi::node_cdata).set_value(value);
+            data.set_cdata(value);
         else
-            data.text().set(value);
+            data.set_text(value);
     }
 }
 
 template <typename C, typename D>
-void generator<C, D>::add_cdata(pugi::xml_node &node,
+void generator<C, D>::add_cdata(graphml_node_t &node,
     const std::string &key_name, const std::string &value) const
 {
     return add_data(node, key_name, value, true);
@@ -549,7 +545,7 @@ void generator<C, D>::add_cdata(pugi::xml_node &node,
 
 template <typename C, typename D>
 template <typename T>
-void generator<C, D>::generate_link(pugi::xml_node &node, const T &c) const
+void generator<C, D>::generate_link(graphml_node_t &node, const T &c) const
 {
     const auto maybe_link = generator<C, D>::render_link(c);
     const auto maybe_tooltip = generator<C, D>::render_tooltip(c);
@@ -564,15 +560,15 @@ void generator<C, D>::generate_link(pugi::xml_node &node, const T &c) const
 }
 
 template <typename C, typename D>
-void generator<C, D>::generator::generate_key(pugi::xml_node &parent,
+void generator<C, D>::generator::generate_key(graphml_node_t &parent,
     const std::string &attr_name, const std::string &for_value,
     const std::string &id_value, const std::string &attr_type) const
 {
     auto key = parent.append_child("key");
-    key.append_attribute("attr.name") = attr_name.c_str();
-    key.append_attribute("attr.type") = attr_type.c_str();
-    key.append_attribute("for") = for_value.c_str();
-    key.append_attribute("id") = id_value.c_str();
+    key.append_attribute("attr.name", attr_name);
+    key.append_attribute("attr.type", attr_type);
+    key.append_attribute("for", for_value);
+    key.append_attribute("id", id_value);
 }
 
 template <typename C, typename D>
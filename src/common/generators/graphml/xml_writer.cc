@@ -0,0 +1,289 @@
+/**
+ * @file src/common/generators/graphml/xml_writer.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xml_writer.h"
+
+#include <cassert>
+
+namespace clanguml::common::generators::graphml {
+
+xml_element::xml_element(xml_writer *writer, std::size_t level,
+    std::uint64_t serial, const char *name)
+    : writer_{writer}
+    , level_{level}
+    , serial_{serial}
+    , name_{name}
+{
+}
+
+xml_element xml_element::append_child(const char *name)
+{
+    if (writer_ == nullptr)
+        return {};
+
+    return writer_->append_child(*this, name);
+}
+
+xml_element &xml_element::append_attribute(
+    std::string_view name, std::string_view value)
+{
+    if (writer_ != nullptr)
+        writer_->append_attribute(*this, name, value);
+
+    return *this;
+}
+
+void xml_element::set_text(std::string_view value)
+{
+    if (writer_ != nullptr)
+        writer_->set_text(*this, value, false);
+}
+
+void xml_element::set_cdata(std::string_view value)
+{
+    if (writer_ != nullptr)
+        writer_->set_text(*this, value, true);
+}
+
+std::string_view xml_element::name() const
+{
+    if (name_ == nullptr)
+        return {};
+
+    return name_;
+}
+
+xml_writer::xml_writer(std::ostream &ostr, std::string indent)
+    : ostr_{ostr}
+    , indent_{std::move(indent)}
+{
+}
+
+xml_writer::~xml_writer() { close(); }
+
+void xml_writer::write_declaration(
+    std::string_view version, std::string_view encoding)
+{
+    close();
+
+    ostr_ << "<?xml version=\"" << version << "\" encoding=\"" << encoding
+          << "\"?>\n";
+}
+
+void xml_writer::write_comment(std::string_view value)
+{
+    close();
+
+    ostr_ << "<!--";
+
+    // Double hyphens are not allowed in comments
+    char previous{0};
+    for (const char c : value) {
+        if (c == '-' && previous == '-')
+            ostr_ << ' ';
+        ostr_ << c;
+        previous = c;
+    }
+
+    if (previous == '-')
+        ostr_ << ' ';
+
+    ostr_ << "-->\n";
+}
+
+xml_element xml_writer::append_child(const char *name)
+{
+    close();
+
+    stack_.push_back({name, next_serial_++, false, false});
+
+    ostr_ << '<' << name;
+
+    return {this, 0, stack_.back().serial, name};
+}
+
+void xml_writer::close()
+{
+    while (!stack_.empty())
+        close_last();
+}
+
+bool xml_writer::is_open(const xml_element &e) const
+{
+    return e.level_ < stack_.size() && stack_[e.level_].serial == e.serial_;
+}
+
+xml_element xml_writer::append_child(
+    const xml_element &parent, const char *name)
+{
+    if (!is_open(parent)) {
+        assert(false);
+        return {};
+    }
+
+    close_descendants(parent.level_);
+
+    auto &p = stack_.back();
+    assert(!p.has_content || p.has_children);
+
+    start_content(p);
+    if (!p.has_children) {
+        ostr_ << '\n';
+        p.has_children = true;
+    }
+
+    const auto level = stack_.size();
+
+    stack_.push_back({name, next_serial_++, false, false});
+
+    write_indent(level);
+    ostr_ << '<' << name;
+
+    return {this, level, stack_.back().serial, name};
+}
+
+void xml_writer::append_attribute(
+    const xml_element &e, std::string_view name, std::string_view value)
+{
+    if (!is_open(e) || e.level_ + 1 != stack_.size() ||
+        stack_.back().has_content) {
+        assert(false);
+        return;
+    }
+
+    ostr_ << ' ' << name << "=\"";
+    write_escaped(value, true);
+    ostr_ << '"';
+}
+
+void xml_writer::set_text(
+    const xml_element &e, std::string_view value, bool cdata)
+{
+    if (!is_open(e)) {
+        assert(false);
+        return;
+    }
+
+    close_descendants(e.level_);
+
+    auto &element = stack_.back();
+    if (element.has_content) {
+        assert(false);
+        return;
+    }
+
+    start_content(element);
+
+    if (!cdata) {
+        write_escaped(value, false);
+        return;
+    }
+
+    // CDATA section cannot contain ']]>', so it has to be split into
+    // multiple sections
+    ostr_ << "<![CDATA[";
+    std::size_t start{0};
+    for (auto pos = value.find("]]>"); pos != std::string_view::npos;
+         pos = value.find("]]>", start)) {
+        ostr_ << value.substr(start, pos + 2 - start) << "]]><![CDATA[";
+        start = pos + 2;
+    }
+    ostr_ << value.substr(start) << "]]>";
+}
+
+void xml_writer::close_descendants(std::size_t level)
+{
+    while (stack_.size() > level + 1)
+        close_last();
+}
+
+void xml_writer::close_last()
+{
+    const auto &e = stack_.back();
+
+    if (!e.has_content) {
+        ostr_ << " />\n";
+    }
+    else if (!e.has_children) {
+        ostr_ << "</" << e.name << ">\n";
+    }
+    else {
+        write_indent(stack_.size() - 1);
+        ostr_ << "</" << e.name << ">\n";
+    }
+
+    stack_.pop_back();
+}
+
+void xml_writer::start_content(open_element &e)
+{
+    if (!e.has_content) {
+        ostr_ << '>';
+        e.has_content = true;
+    }
+}
+
+void xml_writer::write_indent(std::size_t level)
+{
+    for (std::size_t i = 0; i < level; i++)
+        ostr_ << indent_;
+}
+
+void xml_writer::write_escaped(std::string_view value, bool attribute)
+{
+    constexpr auto kTab{9};
+    constexpr auto kLineFeed{10};
+    constexpr auto kCarriageReturn{13};
+    constexpr auto kSpace{32};
+    constexpr auto kDecimalBase{10};
+
+    std::size_t start{0};
+
+    for (std::size_t i = 0; i < value.size(); i++) {
+        const auto c = static_cast<unsigned char>(value[i]);
+
+        const char *escaped{nullptr};
+        if (c == '&')
+            escaped = "&amp;";
+        else if (c == '<')
+            escaped = "&lt;";
+        else if (c == '>' && !attribute)
+            escaped = "&gt;";
+        else if (c == '"' && attribute)
+            escaped = "&quot;";
+        else if (c >= kSpace ||
+            (!attribute &&
+                (c == kTab || c == kLineFeed || c == kCarriageReturn)))
+            continue;
+
+        ostr_ << value.substr(start, i - start);
+        start = i + 1;
+
+        if (escaped != nullptr) {
+            ostr_ << escaped;
+        }
+        else {
+            ostr_ << "&#" << static_cast<char>('0' + c / kDecimalBase)
+                  << static_cast<char>('0' + c % kDecimalBase) << ';';
+        }
+    }
+
+    ostr_ << value.substr(start);
+}
+
+} // namespace clanguml::common::generators::graphml
@@ -0,0 +1,192 @@
+/**
+ * @file src/common/generators/graphml/xml_writer.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clanguml::common::generators::graphml {
+
+class xml_writer;
+
+/**
+ * @brief Handle to an XML element written by an `xml_writer`.
+ *
+ * Default constructed handle is empty, and all operations on it are ignored,
+ * which allows to skip entire subtrees of the document.
+ *
+ * Since the document is written in a single pass, children and attributes
+ * can only be appended to elements which are still open, i.e. to elements
+ * on the path from the document root to the most recently appended
+ * element. Appending a child to an element closes all its open descendants.
+ * Attributes can only be appended before any children or text.
+ */
+class xml_element {
+public:
+    xml_element() = default;
+
+    /**
+     * @brief Append a child element.
+     *
+     * @param name Element name, must outlive the writer (e.g. a literal)
+     * @return Handle to the new element
+     */
+    xml_element append_child(const char *name);
+
+    /**
+     * @brief Append an attribute to the element.
+     *
+     * @param name Attribute name
+     * @param value Attribute value, escaped when written
+     * @return Reference to this element
+     */
+    xml_element &append_attribute(
+        std::string_view name, std::string_view value);
+
+    /**
+     * @brief Set the text contents of the element.
+     *
+     * @param value Text value, escaped when written
+     */
+    void set_text(std::string_view value);
+
+    /**
+     * @brief Set the contents of the element to a CDATA section.
+     *
+     * @param value CDATA contents
+     */
+    void set_cdata(std::string_view value);
+
+    /**
+     * @brief Get the name of the element.
+     *
+     * @return Element name or empty string for empty handle
+     */
+    std::string_view name() const;
+
+    explicit operator bool() const { return writer_ != nullptr; }
+
+private:
+    friend class xml_writer;
+
+    xml_element(xml_writer *writer, std::size_t level, std::uint64_t serial,
+        const char *name);
+
+    xml_writer *writer_{nullptr};
+    std::size_t level_{0};
+    std::uint64_t serial_{0};
+    const char *name_{nullptr};
+};
+
+/**
+ * @brief Streaming XML writer.
+ *
+ * The writer emits the document directly to the output stream, keeping only
+ * the currently open elements in memory. The output is formatted in the
+ * same way as `pugi::xml_document::save()` with default formatting flags,
+ * i.e. each element is written on a separate line indented by its depth,
+ * and elements containing only text or CDATA are written on a single line.
+ */
+class xml_writer {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param ostr Output stream
+     * @param indent Indentation string for each nesting level
+     */
+    explicit xml_writer(std::ostream &ostr, std::string indent = "  ");
+
+    xml_writer(const xml_writer &) = delete;
+    xml_writer(xml_writer &&) = delete;
+    xml_writer &operator=(const xml_writer &) = delete;
+    xml_writer &operator=(xml_writer &&) = delete;
+
+    /**
+     * @brief Destructor closes all open elements.
+     */
+    ~xml_writer();
+
+    /**
+     * @brief Write XML declaration.
+     *
+     * @param version XML version
+     * @param encoding Document encoding
+     */
+    void write_declaration(
+        std::string_view version, std::string_view encoding);
+
+    /**
+     * @brief Write a comment at the document level.
+     *
+     * @param value Comment text
+     */
+    void write_comment(std::string_view value);
+
+    /**
+     * @brief Append an element at the document level.
+     *
+     * @param name Element name, must outlive the writer (e.g. a literal)
+     * @return Handle to the new element
+     */
+    xml_element append_child(const char *name);
+
+    /**
+     * @brief Close all open elements.
+     */
+    void close();
+
+private:
+    friend class xml_element;
+
+    struct open_element {
+        const char *name{nullptr};
+        std::uint64_t serial{0};
+        bool has_content{false};
+        bool has_children{false};
+    };
+
+    bool is_open(const xml_element &e) const;
+
+    xml_element append_child(const xml_element &parent, const char *name);
+
+    void append_attribute(
+        const xml_element &e, std::string_view name, std::string_view value);
+
+    void set_text(const xml_element &e, std::string_view value, bool cdata);
+
+    void close_descendants(std::size_t level);
+
+    void close_last();
+
+    void start_content(open_element &e);
+
+    void write_indent(std::size_t level);
+
+    void write_escaped(std::string_view value, bool attribute);
+
+    std::ostream &ostr_;
+    std::string indent_;
+    std::vector<open_element> stack_;
+    std::uint64_t next_serial_{1};
+};
+
+} // namespace clanguml::common::generators::graphml
@@ -0,0 +1,144 @@
+/**
+ * @file src/common/generators/memory_governor.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_governor.h"
+
+#include "util/logging.h"
+#include "util/util.h"
+
+namespace clanguml::common::generators {
+
+namespace {
+constexpr auto kMebibyte{1024.0 * 1024.0};
+
+double to_mib(std::size_t bytes)
+{
+    return static_cast<double>(bytes) / kMebibyte;
+}
+} // namespace
+
+memory_governor::slot::slot(memory_governor *governor)
+    : governor_{governor}
+{
+}
+
+memory_governor::slot::slot(slot &&other) noexcept
+    : governor_{other.governor_}
+{
+    other.governor_ = nullptr;
+}
+
+memory_governor::slot::~slot()
+{
+    if (governor_ != nullptr)
+        governor_->release();
+}
+
+memory_governor::memory_governor()
+    : rss_{util::get_current_rss}
+{
+}
+
+memory_governor &memory_governor::instance()
+{
+    static memory_governor governor;
+    return governor;
+}
+
+void memory_governor::set_limit(std::size_t limit)
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        limit_ = limit;
+    }
+
+    cond_.notify_all();
+}
+
+std::size_t memory_governor::limit() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return limit_;
+}
+
+bool memory_governor::enabled() const { return limit() > 0; }
+
+void memory_governor::set_rss_source(std::function<std::size_t()> rss)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    rss_ = std::move(rss);
+}
+
+memory_governor::slot memory_governor::acquire(
+    const std::string &translation_unit)
+{
+    std::unique_lock<std::mutex> l(mutex_);
+
+    bool throttled{false};
+    while (limit_ > 0 && active_ > 0) {
+        const auto rss = rss_();
+        if (rss <= limit_)
+            break;
+
+        if (!throttled) {
+            LOG_INFO("Memory usage {:.1f} MiB exceeds limit of {:.1f} MiB - "
+                     "translation unit {} waits for {} translation units in "
+                     "progress",
+                to_mib(rss), to_mib(limit_), translation_unit, active_);
+
+            throttled = true;
+            throttled_count_++;
+        }
+
+        // Memory usage can also drop without any translation unit being
+        // finished, e.g. when a diagram is completed
+        cond_.wait_for(l, kPollInterval);
+    }
+
+    active_++;
+
+    return slot{this};
+}
+
+std::size_t memory_governor::active() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return active_;
+}
+
+std::size_t memory_governor::throttled_count() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return throttled_count_;
+}
+
+void memory_governor::release()
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        active_--;
+    }
+
+    cond_.notify_all();
+}
+
+} // namespace clanguml::common::generators
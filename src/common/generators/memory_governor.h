@@ -0,0 +1,136 @@
+/**
+ * @file src/common/generators/memory_governor.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Limits the number of translation units parsed concurrently based
+ *        on the resident set size of the process.
+ *
+ * Before a translation unit is parsed, a slot has to be acquired from the
+ * governor. If the resident set size of the process exceeds the limit,
+ * acquiring a slot blocks until other translation units are finished and
+ * the memory usage drops below the limit. At least one translation unit is
+ * always allowed to proceed, so the generation never stalls, even if the
+ * limit is exceeded by the diagram models alone.
+ *
+ * The resident set size is shared by all threads of the process, so there
+ * is a single governor per process.
+ */
+class memory_governor {
+public:
+    /**
+     * @brief Interval in which the memory usage is checked again by
+     *        throttled translation units.
+     */
+    static constexpr std::chrono::milliseconds kPollInterval{100};
+
+    /**
+     * @brief Slot of a translation unit, released on destruction.
+     */
+    class slot {
+    public:
+        explicit slot(memory_governor *governor);
+
+        slot(const slot &) = delete;
+        slot(slot &&other) noexcept;
+        slot &operator=(const slot &) = delete;
+        slot &operator=(slot &&) = delete;
+
+        ~slot();
+
+    private:
+        memory_governor *governor_;
+    };
+
+    memory_governor();
+
+    /**
+     * @brief Get the process wide governor instance.
+     *
+     * @return Reference to the governor
+     */
+    static memory_governor &instance();
+
+    /**
+     * @brief Set the memory limit.
+     *
+     * @param limit Resident set size limit in bytes, 0 disables the limit
+     */
+    void set_limit(std::size_t limit);
+
+    /**
+     * @brief Get the memory limit.
+     *
+     * @return Resident set size limit in bytes, or 0 if there is no limit
+     */
+    std::size_t limit() const;
+
+    /**
+     * @brief Whether the memory limit is set.
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Override the function measuring memory usage, e.g. in tests.
+     *
+     * @param rss Function returning the resident set size in bytes
+     */
+    void set_rss_source(std::function<std::size_t()> rss);
+
+    /**
+     * @brief Acquire a slot to parse a translation unit.
+     *
+     * Blocks while the memory usage exceeds the limit and any other
+     * translation unit is being parsed.
+     *
+     * @param translation_unit Path of the translation unit, for logging
+     * @return Slot, which has to be kept until the translation unit is parsed
+     */
+    slot acquire(const std::string &translation_unit);
+
+    /**
+     * @brief Number of translation units currently being parsed.
+     */
+    std::size_t active() const;
+
+    /**
+     * @brief Number of times translation units had to wait for memory.
+     */
+    std::size_t throttled_count() const;
+
+private:
+    void release();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::size_t limit_{0};
+    std::size_t active_{0};
+    std::size_t throttled_count_{0};
+    std::function<std::size_t()> rss_;
+};
+
+} // namespace clanguml::common::generators
@@ -31,6 +31,8 @@
 #include <glob/glob.hpp>
 #include <inja/inja.hpp>
 
+#include <iterator>
+
 namespace clanguml::common::generators::plantuml {
 
 using clanguml::common::jinja::element_context;
@@ -176,6 +178,15 @@ public:
      */
     void generate_link(std::ostream &ostr, const relationship &e) const;
 
+    /**
+     * @brief generate_link specialization for relationship, which appends
+     *        the link to a memory buffer
+     *
+     * @param buffer Output buffer
+     * @param e Reference to diagram relationship
+     */
+    void generate_link(fmt::memory_buffer &buffer, const relationship &e) const;
+
     /**
      * @brief Print debug information in diagram comments
      *
@@ -430,6 +441,17 @@ void generator<C, D>::generate_link(std::ostream &ostr, const E &e) const
 template <typename C, typename D>
 void generator<C, D>::generate_link(
     std::ostream &ostr, const common::model::relationship &r) const
+{
+    fmt::memory_buffer buffer;
+
+    generate_link(buffer, r);
+
+    ostr.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+template <typename C, typename D>
+void generator<C, D>::generate_link(
+    fmt::memory_buffer &buffer, const common::model::relationship &r) const
 {
     const auto maybe_link = generator<C, D>::render_link(r);
     const auto maybe_tooltip = generator<C, D>::render_tooltip(r);
@@ -437,14 +459,14 @@ void generator<C, D>::generate_link(
     if (!maybe_link && !maybe_tooltip)
         return;
 
-    ostr << " [[";
+    auto out = std::back_inserter(buffer);
 
-    ostr << maybe_link.value_or("");
+    fmt::format_to(out, " [[{}", maybe_link.value_or(""));
 
     if (maybe_tooltip)
-        ostr << "{" << *maybe_tooltip << "}";
+        fmt::format_to(out, "{{{}}}", *maybe_tooltip);
 
-    ostr << "]]";
+    fmt::format_to(out, "]]");
 }
 
 template <typename C, typename D>
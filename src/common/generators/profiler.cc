@@ -0,0 +1,325 @@
+/**
+ * @file src/common/generators/profiler.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler.h"
+
+#include "util/util.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace clanguml::common::generators {
+
+namespace {
+constexpr auto kMebibyte{1024.0 * 1024.0};
+
+double to_ms(std::chrono::nanoseconds ns)
+{
+    return std::chrono::duration<double, std::milli>(ns).count();
+}
+
+nlohmann::json timing_to_json(const timing &t)
+{
+    nlohmann::json j;
+    j["wall_ms"] = t.wall_ms();
+    j["cpu_ms"] = t.cpu_ms();
+    return j;
+}
+
+void write_timing(const timing &t, model::binary_writer &w)
+{
+    w.write_uint(static_cast<std::uint64_t>(t.wall.count()));
+    w.write_uint(static_cast<std::uint64_t>(t.cpu.count()));
+}
+
+timing read_timing(model::binary_reader &r)
+{
+    using rep_t = std::chrono::nanoseconds::rep;
+
+    timing t;
+    t.wall = std::chrono::nanoseconds{static_cast<rep_t>(r.read_uint())};
+    t.cpu = std::chrono::nanoseconds{static_cast<rep_t>(r.read_uint())};
+    return t;
+}
+} // namespace
+
+timing &timing::operator+=(const timing &t)
+{
+    wall += t.wall;
+    cpu += t.cpu;
+    return *this;
+}
+
+double timing::wall_ms() const { return to_ms(wall); }
+
+double timing::cpu_ms() const { return to_ms(cpu); }
+
+stopwatch::stopwatch() { restart(); }
+
+timing stopwatch::elapsed() const
+{
+    timing result;
+    result.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wall_start_);
+    result.cpu = util::get_thread_cpu_time() - cpu_start_;
+    return result;
+}
+
+void stopwatch::restart()
+{
+    wall_start_ = std::chrono::steady_clock::now();
+    cpu_start_ = util::get_thread_cpu_time();
+}
+
+void diagram_profile::add_phase(const std::string &phase, const timing &t)
+{
+    auto it = std::find_if(phases.begin(), phases.end(),
+        [&phase](const auto &p) { return p.first == phase; });
+
+    if (it != phases.end()) {
+        it->second += t;
+        return;
+    }
+
+    phases.emplace_back(phase, t);
+}
+
+void diagram_profile::add_translation_unit(
+    const std::string &path, const timing &t)
+{
+    translation_units.push_back({path, t});
+}
+
+void diagram_profile::merge(const diagram_profile &p)
+{
+    for (const auto &[phase, t] : p.phases)
+        add_phase(phase, t);
+
+    translation_units.insert(translation_units.end(),
+        p.translation_units.begin(), p.translation_units.end());
+}
+
+void serialize(const diagram_profile &p, model::binary_writer &w)
+{
+    w.write_uint(p.phases.size());
+    for (const auto &[phase, t] : p.phases) {
+        w.write_string(phase);
+        write_timing(t, w);
+    }
+
+    w.write_uint(p.translation_units.size());
+    for (const auto &tu : p.translation_units) {
+        w.write_string(tu.path);
+        write_timing(tu.time, w);
+    }
+}
+
+void deserialize(model::binary_reader &r, diagram_profile &p)
+{
+    const auto phases_count = r.read_uint();
+    for (auto i = 0U; i < phases_count; i++) {
+        auto phase = r.read_string();
+        p.add_phase(phase, read_timing(r));
+    }
+
+    const auto translation_units_count = r.read_uint();
+    for (auto i = 0U; i < translation_units_count; i++) {
+        auto path = r.read_string();
+        p.add_translation_unit(path, read_timing(r));
+    }
+}
+
+diagram_profile &profiler::add_diagram(
+    const std::string &name, model::diagram_t type)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto &profile = diagrams_[name];
+    profile.name = name;
+    profile.type = type;
+
+    return profile;
+}
+
+void profiler::set_run(const timing &t, unsigned cores)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    run_ = t;
+    cores_ = cores;
+}
+
+double profiler::utilization() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return utilization_unlocked();
+}
+
+double profiler::utilization_unlocked() const
+{
+    if (cores_ == 0 || run_.wall.count() == 0)
+        return 0;
+
+    return std::min(1.0,
+        run_.cpu_ms() / (run_.wall_ms() * static_cast<double>(cores_)));
+}
+
+std::vector<std::pair<std::string, translation_unit_profile>>
+profiler::slowest_translation_units(unsigned top_n) const
+{
+    std::vector<std::pair<std::string, translation_unit_profile>> result;
+
+    for (const auto &[name, profile] : diagrams_) {
+        for (const auto &tu : profile.translation_units)
+            result.emplace_back(name, tu);
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.second.time.wall > b.second.time.wall;
+    });
+
+    if (result.size() > top_n)
+        result.resize(top_n);
+
+    return result;
+}
+
+void profiler::print(std::ostream &os, unsigned top_n) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    const auto kPhaseWidth = 32U;
+
+    for (const auto &[name, profile] : diagrams_) {
+        os << fmt::format("Diagram '{}' [{}]: {} elements, {} relationships\n",
+            name, profile.type, profile.elements_count,
+            profile.relationships_count);
+        os << fmt::format("  {:<{}} {:>12} {:>12}\n", "Phase", kPhaseWidth,
+            "Wall [ms]", "CPU [ms]");
+        for (const auto &[phase, t] : profile.phases) {
+            os << fmt::format("  {:<{}} {:>12.1f} {:>12.1f}\n", phase,
+                kPhaseWidth, t.wall_ms(), t.cpu_ms());
+        }
+        os << fmt::format("  {:<{}} {:>12.1f} {:>12.1f}\n", "total",
+            kPhaseWidth, profile.total.wall_ms(), profile.total.cpu_ms());
+        os << '\n';
+    }
+
+    // Diagrams can be generated concurrently in the same process, so peak
+    // memory usage cannot be attributed to individual diagrams
+    os << fmt::format("Peak RSS of the process: {:.1f} MiB\n\n",
+        static_cast<double>(util::get_peak_rss()) / kMebibyte);
+
+    const auto slowest = slowest_translation_units(top_n);
+    if (!slowest.empty()) {
+        os << fmt::format("Slowest {} translation units:\n", slowest.size());
+        os << fmt::format("  {:>12} {:>12}  {}\n", "Wall [ms]", "CPU [ms]",
+            "Translation unit [diagram]");
+        for (const auto &[name, tu] : slowest) {
+            os << fmt::format("  {:>12.1f} {:>12.1f}  {} [{}]\n",
+                tu.time.wall_ms(), tu.time.cpu_ms(), tu.path, name);
+        }
+    }
+
+    if (cores_ == 0)
+        return;
+
+    // Diagrams are started in the order of their estimated cost
+    std::vector<const diagram_profile *> schedule;
+    for (const auto &[name, profile] : diagrams_)
+        schedule.push_back(&profile);
+    std::stable_sort(schedule.begin(), schedule.end(),
+        [](const auto *a, const auto *b) {
+            return a->estimated_cost > b->estimated_cost;
+        });
+
+    if (!slowest.empty())
+        os << '\n';
+
+    os << "Schedule:\n";
+    os << fmt::format(
+        "  {:>14} {:>12}  {}\n", "Estimate [ms]", "Wall [ms]", "Diagram");
+    for (const auto *profile : schedule) {
+        os << fmt::format("  {:>14.1f} {:>12.1f}  {}\n",
+            profile->estimated_cost, profile->total.wall_ms(), profile->name);
+    }
+    os << fmt::format("Core utilization: {:.0f}% of {} cores in {:.1f} ms\n",
+        utilization_unlocked() * 100.0, cores_, run_.wall_ms());
+}
+
+nlohmann::json profiler::to_json(unsigned top_n) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    nlohmann::json j;
+    j["diagrams"] = nlohmann::json::array();
+
+    for (const auto &[name, profile] : diagrams_) {
+        nlohmann::json d;
+        d["name"] = name;
+        d["type"] = to_string(profile.type);
+        d["elements_count"] = profile.elements_count;
+        d["relationships_count"] = profile.relationships_count;
+        d["estimated_cost_ms"] = profile.estimated_cost;
+        d["total"] = timing_to_json(profile.total);
+        d["phases"] = nlohmann::json::array();
+        for (const auto &[phase, t] : profile.phases) {
+            auto p = timing_to_json(t);
+            p["name"] = phase;
+            d["phases"].emplace_back(std::move(p));
+        }
+        d["translation_units"] = nlohmann::json::array();
+        for (const auto &tu : profile.translation_units) {
+            auto t = timing_to_json(tu.time);
+            t["path"] = tu.path;
+            d["translation_units"].emplace_back(std::move(t));
+        }
+        j["diagrams"].emplace_back(std::move(d));
+    }
+
+    j["slowest_translation_units"] = nlohmann::json::array();
+    for (const auto &[name, tu] : slowest_translation_units(top_n)) {
+        auto t = timing_to_json(tu.time);
+        t["path"] = tu.path;
+        t["diagram"] = name;
+        j["slowest_translation_units"].emplace_back(std::move(t));
+    }
+
+    j["peak_rss"] = util::get_peak_rss();
+
+    if (cores_ > 0) {
+        j["run"] = timing_to_json(run_);
+        j["run"]["cores"] = cores_;
+        j["run"]["utilization"] = utilization_unlocked();
+    }
+
+    return j;
+}
+
+void profiler::save(const std::filesystem::path &path, unsigned top_n) const
+{
+    std::ofstream ofs;
+    ofs.open(path, std::ofstream::out | std::ofstream::trunc);
+    ofs << to_json(top_n).dump(2);
+    ofs.close();
+
+    LOG_INFO("Written profile report to {}", path.string());
+}
+
+} // namespace clanguml::common::generators
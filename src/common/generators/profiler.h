@@ -0,0 +1,235 @@
+/**
+ * @file src/common/generators/profiler.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/enums.h"
+#include "common/model/serialization.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Wall and CPU time spent in a single profiled step.
+ */
+struct timing {
+    std::chrono::nanoseconds wall{};
+    std::chrono::nanoseconds cpu{};
+
+    timing &operator+=(const timing &t);
+
+    /**
+     * @brief Wall time in milliseconds
+     */
+    double wall_ms() const;
+
+    /**
+     * @brief CPU time in milliseconds
+     */
+    double cpu_ms() const;
+};
+
+/**
+ * @brief Simple stopwatch measuring both wall and calling thread CPU time.
+ *
+ * The stopwatch starts measuring time on construction.
+ */
+class stopwatch {
+public:
+    stopwatch();
+
+    /**
+     * @brief Get time elapsed since construction or last restart.
+     *
+     * @return Elapsed wall and CPU time
+     */
+    timing elapsed() const;
+
+    /**
+     * @brief Restart the stopwatch.
+     */
+    void restart();
+
+private:
+    std::chrono::steady_clock::time_point wall_start_;
+    std::chrono::nanoseconds cpu_start_;
+};
+
+/**
+ * @brief Time spent processing a single translation unit.
+ */
+struct translation_unit_profile {
+    std::string path;
+    timing time;
+};
+
+/**
+ * @brief Profile of a single diagram generation.
+ *
+ * The profile instance is not synchronized. Tasks processing parts of
+ * a diagram concurrently record their timings in their own profiles, which
+ * are then merged using @ref merge().
+ */
+struct diagram_profile {
+    std::string name;
+    model::diagram_t type{model::diagram_t::kClass};
+
+    /**
+     * @brief Add time to a named phase.
+     *
+     * If the phase is already recorded, the time is accumulated, otherwise
+     * the phase is appended to preserve the order of phases.
+     *
+     * @param phase Name of the phase
+     * @param t Time spent in the phase
+     */
+    void add_phase(const std::string &phase, const timing &t);
+
+    /**
+     * @brief Record time spent processing a translation unit.
+     *
+     * @param path Path to the translation unit
+     * @param t Time spent in parsing and traversing the translation unit
+     */
+    void add_translation_unit(const std::string &path, const timing &t);
+
+    /**
+     * @brief Merge timings of phases and translation units of another
+     *        profile.
+     *
+     * @param p Profile to merge into this profile
+     */
+    void merge(const diagram_profile &p);
+
+    /** Phases in the order of execution, phases can be nested */
+    std::vector<std::pair<std::string, timing>> phases;
+    std::vector<translation_unit_profile> translation_units;
+    std::size_t elements_count{0};
+    std::size_t relationships_count{0};
+    /** Estimated cost of the diagram translation units [ms] */
+    double estimated_cost{0};
+    /** Total time of the diagram generation */
+    timing total;
+};
+
+/**
+ * @brief Serialize timings of phases and translation units of a diagram
+ *        profile.
+ *
+ * This allows worker processes to pass their timings along with the partial
+ * diagram model to the parent process.
+ *
+ * @param p Diagram profile
+ * @param w Binary writer
+ */
+void serialize(const diagram_profile &p, model::binary_writer &w);
+
+/**
+ * @brief Merge serialized timings into a diagram profile.
+ *
+ * Times of phases are added to the phases already in the profile, and
+ * translation units are appended.
+ *
+ * @param r Binary reader
+ * @param p Diagram profile to merge the timings into
+ */
+void deserialize(model::binary_reader &r, diagram_profile &p);
+
+/**
+ * @brief Collects per diagram profiles and renders the profile report.
+ */
+class profiler {
+public:
+    static constexpr auto kDefaultTopTranslationUnits{10U};
+
+    /**
+     * @brief Create a new diagram profile.
+     *
+     * @param name Diagram name
+     * @param type Diagram type
+     * @return Reference to the new diagram profile, which remains valid
+     *         for the lifetime of the profiler
+     */
+    diagram_profile &add_diagram(
+        const std::string &name, model::diagram_t type);
+
+    /**
+     * @brief Record the time of the whole run.
+     *
+     * @param t Wall time of the run and CPU time of the process, including
+     *          its worker processes
+     * @param cores Number of cores available to the run
+     */
+    void set_run(const timing &t, unsigned cores);
+
+    /**
+     * @brief Ratio of CPU time of the run to the time available on all its
+     *        cores.
+     *
+     * @return Core utilization between 0 and 1, or 0 if the run was not
+     *         recorded
+     */
+    double utilization() const;
+
+    /**
+     * @brief Print the profile report as a text table.
+     *
+     * @param os Output stream
+     * @param top_n Number of slowest translation units to list
+     */
+    void print(std::ostream &os,
+        unsigned top_n = kDefaultTopTranslationUnits) const;
+
+    /**
+     * @brief Render the profile report as JSON.
+     *
+     * @param top_n Number of slowest translation units to list
+     * @return JSON object with the report
+     */
+    nlohmann::json to_json(unsigned top_n = kDefaultTopTranslationUnits) const;
+
+    /**
+     * @brief Write the JSON profile report to a file.
+     *
+     * @param path Path to the output file
+     * @param top_n Number of slowest translation units to list
+     */
+    void save(const std::filesystem::path &path,
+        unsigned top_n = kDefaultTopTranslationUnits) const;
+
+private:
+    std::vector<std::pair<std::string, translation_unit_profile>>
+    slowest_translation_units(unsigned top_n) const;
+
+    double utilization_unlocked() const;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, diagram_profile> diagrams_;
+    timing run_;
+    unsigned cores_{0};
+};
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,354 @@
+/**
+ * @file src/common/generators/watcher.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "watcher.h"
+
+#include "common/generators/generators.h"
+#include "util/logging.h"
+
+#include <csignal>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace clanguml::common::generators {
+
+namespace {
+volatile std::sig_atomic_t watch_interrupted{0}; // NOLINT
+
+void handle_interrupt(int /*signal*/) { watch_interrupted = 1; }
+} // namespace
+
+void dependency_tracker::set_dependencies(const std::string &diagram,
+    const std::string &translation_unit,
+    const std::vector<std::string> &dependencies)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    const key_t key{diagram, translation_unit};
+
+    for (const auto &file : dependencies_[key]) {
+        auto it = dependents_.find(file);
+        if (it == dependents_.end())
+            continue;
+
+        it->second.erase(key);
+        if (it->second.empty())
+            dependents_.erase(it);
+    }
+
+    std::set<std::string> files{dependencies.begin(), dependencies.end()};
+    // Translation unit always depends on itself, even if it failed to parse
+    files.emplace(translation_unit);
+
+    for (const auto &file : files)
+        dependents_[file].emplace(key);
+
+    dependencies_[key] = std::move(files);
+}
+
+std::set<std::string> dependency_tracker::affected_diagrams(
+    const std::set<std::string> &files) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    std::set<std::string> result;
+
+    for (const auto &file : files) {
+        auto it = dependents_.find(file);
+        if (it == dependents_.end())
+            continue;
+
+        for (const auto &[diagram, translation_unit] : it->second)
+            result.emplace(diagram);
+    }
+
+    return result;
+}
+
+std::set<std::string> dependency_tracker::invalidate(
+    const std::set<std::string> &files)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    std::set<std::string> result;
+
+    for (const auto &file : files) {
+        auto it = dependents_.find(file);
+        if (it == dependents_.end())
+            continue;
+
+        for (const auto &key : it->second) {
+            if (auto pm = partial_models_.find(key);
+                pm != partial_models_.end())
+                pm->second.outdated = true;
+
+            result.emplace(key.first);
+        }
+    }
+
+    return result;
+}
+
+bool dependency_tracker::set_context(const std::string &diagram,
+    std::size_t context, const std::vector<std::string> &translation_units)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto it = contexts_.find(diagram);
+    if (it == contexts_.end()) {
+        contexts_.emplace(diagram, context_t{context, translation_units});
+        return true;
+    }
+
+    if (it->second.hash != context) {
+        for (auto pm = partial_models_.begin(); pm != partial_models_.end();) {
+            if (pm->first.first == diagram)
+                pm = partial_models_.erase(pm);
+            else
+                ++pm;
+        }
+    }
+
+    const bool changed = it->second.hash != context ||
+        it->second.translation_units != translation_units;
+
+    it->second = {context, translation_units};
+
+    return changed;
+}
+
+void dependency_tracker::reset_context(const std::string &diagram)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    contexts_.erase(diagram);
+}
+
+std::vector<std::string> dependency_tracker::outdated_translation_units(
+    const std::string &diagram,
+    const std::vector<std::string> &translation_units) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    std::vector<std::string> result;
+
+    for (const auto &tu : translation_units) {
+        auto it = partial_models_.find({diagram, tu});
+        if (it == partial_models_.end() || it->second.outdated)
+            result.emplace_back(tu);
+    }
+
+    return result;
+}
+
+bool dependency_tracker::set_partial_model(const std::string &diagram,
+    const std::string &translation_unit, std::string model)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto &pm = partial_models_[{diagram, translation_unit}];
+
+    const bool changed = !pm.model || *pm.model != model;
+
+    if (changed)
+        pm.model = std::make_shared<const std::string>(std::move(model));
+    pm.outdated = false;
+
+    return changed;
+}
+
+std::shared_ptr<const std::string> dependency_tracker::partial_model(
+    const std::string &diagram, const std::string &translation_unit) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto it = partial_models_.find({diagram, translation_unit});
+    if (it == partial_models_.end())
+        return {};
+
+    return it->second.model;
+}
+
+std::set<std::string> dependency_tracker::files() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    std::set<std::string> result;
+    for (const auto &[file, keys] : dependents_)
+        result.emplace(file);
+
+    return result;
+}
+
+std::map<std::pair<std::string, std::string>, std::set<std::string>>
+dependency_tracker::dependencies() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return dependencies_;
+}
+
+void serialize(const dependency_tracker &d, model::binary_writer &w)
+{
+    const auto dependencies = d.dependencies();
+
+    w.write_uint(dependencies.size());
+    for (const auto &[key, files] : dependencies) {
+        w.write_string(key.first);
+        w.write_string(key.second);
+        w.write_strings({files.begin(), files.end()});
+    }
+}
+
+void deserialize(model::binary_reader &r, dependency_tracker &d)
+{
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++) {
+        auto diagram = r.read_string();
+        auto translation_unit = r.read_string();
+        d.set_dependencies(diagram, translation_unit, r.read_strings());
+    }
+}
+
+std::set<std::string> file_change_detector::update(
+    const std::set<std::string> &files)
+{
+    std::set<std::string> result;
+
+    for (const auto &file : files) {
+        std::error_code ec;
+        const auto last_write_time = std::filesystem::last_write_time(file, ec);
+
+        auto it = files_.find(file);
+        if (it == files_.end()) {
+            files_.emplace(file, read_state(file));
+            continue;
+        }
+
+        auto &state = it->second;
+
+        if (!ec && state.last_write_time == last_write_time)
+            continue;
+
+        auto new_state = read_state(file);
+
+        if (new_state.hash != state.hash ||
+            new_state.last_write_time.has_value() !=
+                state.last_write_time.has_value()) {
+            result.emplace(file);
+        }
+
+        state = new_state;
+    }
+
+    return result;
+}
+
+file_change_detector::file_state file_change_detector::read_state(
+    const std::filesystem::path &path)
+{
+    file_state state;
+
+    std::error_code ec;
+    const auto last_write_time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return state;
+
+    state.last_write_time = last_write_time;
+
+    std::ifstream ifs{path, std::ios::binary};
+    const std::string contents{
+        std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+    state.hash = std::hash<std::string>{}(contents);
+
+    return state;
+}
+
+int watch_diagrams(const std::vector<std::string> &diagram_names,
+    clanguml::config::config &config,
+    const common::compilation_database_ptr &db,
+    const cli::runtime_config &runtime_config,
+    const std::map<std::string, std::vector<std::string>>
+        &translation_units_map)
+{
+    dependency_tracker dependencies;
+    file_change_detector detector;
+
+    // Make sure that diagrams are regenerated on changes to their
+    // translation units, even if initial generation failed
+    for (const auto &[name, translation_units] : translation_units_map) {
+        if (!diagram_names.empty() && !util::contains(diagram_names, name))
+            continue;
+
+        for (const auto &tu : translation_units)
+            dependencies.set_dependencies(name, tu, {});
+    }
+
+    // Record state of the translation units before they are parsed, so that
+    // changes made while the diagrams are generated are not missed
+    detector.update(dependencies.files());
+
+    auto result = generate_diagrams(diagram_names, config, db, runtime_config,
+        translation_units_map, &dependencies);
+
+    // Files modified during generation are handled in the first iteration,
+    // files included by the translation units are only recorded
+    auto pending_changes = detector.update(dependencies.files());
+
+    watch_interrupted = 0;
+    auto *previous_handler = std::signal(SIGINT, handle_interrupt);
+
+    LOG_INFO("Watching {} files for changes - press Ctrl-C to stop...",
+        dependencies.files().size());
+
+    while (watch_interrupted == 0) {
+        std::this_thread::sleep_for(runtime_config.watch_interval);
+
+        auto changed_files = detector.update(dependencies.files());
+        changed_files.merge(pending_changes);
+        pending_changes.clear();
+
+        if (changed_files.empty())
+            continue;
+
+        const auto affected = dependencies.invalidate(changed_files);
+        if (affected.empty())
+            continue;
+
+        LOG_INFO("Detected changes in {} - regenerating diagrams: {}",
+            fmt::join(changed_files, ", "), fmt::join(affected, ", "));
+
+        result = generate_diagrams({affected.begin(), affected.end()}, config,
+            db, runtime_config, translation_units_map, &dependencies);
+
+        // Record state of any new files included by the changed sources,
+        // files modified during regeneration are handled in the next
+        // iteration
+        pending_changes = detector.update(dependencies.files());
+    }
+
+    std::signal(SIGINT, previous_handler);
+
+    LOG_INFO("Stopped watching for changes");
+
+    return result;
+}
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,257 @@
+/**
+ * @file src/common/generators/watcher.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "cli/cli_handler.h"
+#include "common/compilation_database.h"
+#include "common/model/serialization.h"
+#include "config/config.h"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Keeps track of files each translation unit depends on.
+ *
+ * The tracker is updated by the diagram frontend actions after each
+ * translation unit is processed, and maintains a reverse include map, which
+ * allows to find all diagrams affected by a change in any of the source
+ * files. The tracker can be updated concurrently by multiple diagram
+ * generators.
+ *
+ * In watch mode, the tracker also keeps serialized partial models built from
+ * each translation unit of each diagram, so that only translation units
+ * invalidated by changes to their dependencies are parsed again, and only
+ * diagrams whose models changed are regenerated.
+ */
+class dependency_tracker {
+public:
+    /**
+     * @brief Set the dependencies of a translation unit in a diagram.
+     *
+     * Any dependencies previously recorded for the translation unit in the
+     * diagram are replaced.
+     *
+     * @param diagram Diagram name
+     * @param translation_unit Path to the translation unit
+     * @param dependencies Paths to files included by the translation unit
+     */
+    void set_dependencies(const std::string &diagram,
+        const std::string &translation_unit,
+        const std::vector<std::string> &dependencies);
+
+    /**
+     * @brief Find diagrams which depend on any of the files.
+     *
+     * @param files Paths of changed files
+     * @return Names of affected diagrams
+     */
+    std::set<std::string> affected_diagrams(
+        const std::set<std::string> &files) const;
+
+    /**
+     * @brief Invalidate partial models of translation units depending on any
+     *        of the files.
+     *
+     * @param files Paths of changed files
+     * @return Names of affected diagrams
+     */
+    std::set<std::string> invalidate(const std::set<std::string> &files);
+
+    /**
+     * @brief Set the context in which partial models of a diagram are built.
+     *
+     * If the context differs from the previous one (e.g. when functions
+     * reachable in a sequence diagram changed), all partial models of the
+     * diagram are dropped.
+     *
+     * @param diagram Diagram name
+     * @param context Hash of the context
+     * @param translation_units Translation units of the diagram
+     * @return True, if the context or the list of translation units
+     *         changed, or the diagram is generated for the first time
+     */
+    bool set_context(const std::string &diagram, std::size_t context,
+        const std::vector<std::string> &translation_units);
+
+    /**
+     * @brief Forget the context of a diagram, so that it is regenerated on
+     *        the next call to @ref set_context(), even if none of its partial
+     *        models changes.
+     *
+     * @param diagram Diagram name
+     */
+    void reset_context(const std::string &diagram);
+
+    /**
+     * @brief Find translation units, which have to be parsed again.
+     *
+     * @param diagram Diagram name
+     * @param translation_units Translation units of the diagram
+     * @return Translation units without a valid partial model, in the order
+     *         of `translation_units`
+     */
+    std::vector<std::string> outdated_translation_units(
+        const std::string &diagram,
+        const std::vector<std::string> &translation_units) const;
+
+    /**
+     * @brief Store the partial model of a translation unit.
+     *
+     * @param diagram Diagram name
+     * @param translation_unit Path to the translation unit
+     * @param model Serialized partial model
+     * @return True, if the model differs from the previous model of the
+     *         translation unit
+     */
+    bool set_partial_model(const std::string &diagram,
+        const std::string &translation_unit, std::string model);
+
+    /**
+     * @brief Get the partial model of a translation unit.
+     *
+     * @param diagram Diagram name
+     * @param translation_unit Path to the translation unit
+     * @return Serialized partial model, or nullptr if it was not stored
+     */
+    std::shared_ptr<const std::string> partial_model(
+        const std::string &diagram, const std::string &translation_unit) const;
+
+    /**
+     * @brief Get all files any of the diagrams depends on.
+     *
+     * @return Set of file paths
+     */
+    std::set<std::string> files() const;
+
+    /**
+     * @brief Get the dependencies of each translation unit of each diagram.
+     *
+     * @return Map of (diagram, translation unit) pairs to their dependencies
+     */
+    std::map<std::pair<std::string, std::string>, std::set<std::string>>
+    dependencies() const;
+
+private:
+    using key_t = std::pair<std::string /* diagram */,
+        std::string /* translation unit */>;
+
+    struct partial_model_t {
+        std::shared_ptr<const std::string> model;
+        bool outdated{false};
+    };
+
+    struct context_t {
+        std::size_t hash{0};
+        std::vector<std::string> translation_units;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<key_t, std::set<std::string>> dependencies_;
+    std::map<std::string, std::set<key_t>> dependents_;
+    std::map<key_t, partial_model_t> partial_models_;
+    std::map<std::string, context_t> contexts_;
+};
+
+/**
+ * @brief Serialize dependencies of all translation units in the tracker.
+ *
+ * This allows worker processes to pass the dependencies of their
+ * translation units along with the partial diagram model to the parent
+ * process.
+ *
+ * @param d Dependency tracker
+ * @param w Binary writer
+ */
+void serialize(const dependency_tracker &d, model::binary_writer &w);
+
+/**
+ * @brief Set dependencies of serialized translation units in a tracker.
+ *
+ * @param r Binary reader
+ * @param d Dependency tracker to update
+ */
+void deserialize(model::binary_reader &r, dependency_tracker &d);
+
+/**
+ * @brief Detects changes to the contents of a set of files.
+ *
+ * Files are first compared by their modification time, and only if it
+ * differs their contents hash is calculated, so that touching a file or
+ * saving it without modifications does not trigger regeneration.
+ */
+class file_change_detector {
+public:
+    /**
+     * @brief Compare current state of the files with their last known state.
+     *
+     * Files seen for the first time are recorded, but are not reported as
+     * changed.
+     *
+     * @param files Paths to files to check
+     * @return Paths to files which contents changed since the last call
+     */
+    std::set<std::string> update(const std::set<std::string> &files);
+
+private:
+    struct file_state {
+        std::optional<std::filesystem::file_time_type> last_write_time;
+        std::size_t hash{0};
+    };
+
+    static file_state read_state(const std::filesystem::path &path);
+
+    std::map<std::string, file_state> files_;
+};
+
+/**
+ * @brief Generate diagrams and regenerate them on source file changes.
+ *
+ * After the initial generation, the files included by each translation unit
+ * of each diagram are polled for changes. Only translation units depending
+ * on modified files are parsed again, and only diagrams whose models changed
+ * are regenerated. Configuration and compilation database are
+ * loaded only once, so changes to them require restarting `clang-uml`.
+ *
+ * The function returns when interrupted with `SIGINT`.
+ *
+ * @param diagram_names List of diagram names to generate
+ * @param config Reference to config instance
+ * @param db Reference to compilation database
+ * @param runtime_config Runtime configuration
+ * @param translation_units_map Map of translation units for each diagram
+ *
+ * @return 0 if success, otherwise error code
+ */
+int watch_diagrams(const std::vector<std::string> &diagram_names,
+    clanguml::config::config &config,
+    const common::compilation_database_ptr &db,
+    const cli::runtime_config &runtime_config,
+    const std::map<std::string, std::vector<std::string>>
+        &translation_units_map);
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,352 @@
+/**
+ * @file src/common/generators/worker_processes.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "worker_processes.h"
+
+#include "util/logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace clanguml::common::generators {
+
+std::vector<std::vector<std::string>> make_shards(
+    const std::vector<std::string> &translation_units, unsigned jobs,
+    const translation_unit_cost_t &cost)
+{
+    std::vector<std::vector<std::string>> result;
+
+    if (translation_units.empty())
+        return result;
+
+    const auto shard_count = std::min<std::size_t>(
+        std::max(jobs, 1U), translation_units.size());
+
+    if (cost) {
+        std::vector<std::pair<double, std::size_t>> costs;
+        costs.reserve(translation_units.size());
+        for (auto i = 0U; i < translation_units.size(); i++)
+            costs.emplace_back(cost(translation_units[i]), i);
+
+        std::stable_sort(costs.begin(), costs.end(),
+            [](const auto &a, const auto &b) { return a.first > b.first; });
+
+        // Empty shards are preferred over shards with equal total cost, so
+        // that no shard is left empty
+        std::vector<std::pair<double, std::vector<std::size_t>>> shards(
+            shard_count);
+        for (const auto &[tu_cost, index] : costs) {
+            auto &shard = *std::min_element(shards.begin(), shards.end(),
+                [](const auto &a, const auto &b) {
+                    return std::make_pair(a.first, a.second.size()) <
+                        std::make_pair(b.first, b.second.size());
+                });
+            shard.first += tu_cost;
+            shard.second.push_back(index);
+        }
+
+        for (auto &[shard_cost, indexes] : shards) {
+            std::sort(indexes.begin(), indexes.end());
+
+            auto &shard = result.emplace_back();
+            for (const auto index : indexes)
+                shard.push_back(translation_units[index]);
+        }
+
+        return result;
+    }
+    const auto base_size = translation_units.size() / shard_count;
+    const auto remainder = translation_units.size() % shard_count;
+
+    auto it = translation_units.begin();
+    for (auto i = 0U; i < shard_count; i++) {
+        const auto size = base_size + (i < remainder ? 1 : 0);
+        result.emplace_back(it, it + static_cast<std::ptrdiff_t>(size));
+        it += static_cast<std::ptrdiff_t>(size);
+    }
+
+    return result;
+}
+
+#if defined(_WIN32)
+std::vector<std::string> run_worker_processes(
+    const std::vector<std::string> & /*translation_units*/, unsigned /*jobs*/,
+    const std::function<std::string(const std::vector<std::string> &)>
+        & /*process_shard*/,
+    const std::function<void(const std::vector<std::string> &,
+        std::string_view)> & /*merge_shard*/,
+    const translation_unit_cost_t & /*cost*/)
+{
+    throw std::runtime_error(
+        "Worker processes are not supported on this platform");
+}
+#else
+namespace {
+/**
+ * Exit code of a worker, which failed with an exception, as opposed to a
+ * crash.
+ */
+constexpr int kWorkerErrorExitCode{2};
+
+enum class worker_status_t { kOk, kError, kCrashed };
+
+struct worker {
+    explicit worker(std::vector<std::string> tus)
+        : translation_units{std::move(tus)}
+    {
+    }
+
+    std::vector<std::string> translation_units;
+    pid_t pid{-1};
+    int fd{-1};
+    worker_status_t status{worker_status_t::kOk};
+    std::string result;
+};
+
+bool write_all(int fd, std::string_view data)
+{
+    while (!data.empty()) {
+        const auto written = ::write(fd, data.data(), data.size());
+        if (written < 0)
+            return false;
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+std::string read_all(int fd)
+{
+    std::string result;
+
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        result.reserve(static_cast<std::size_t>(st.st_size));
+
+    ::lseek(fd, 0, SEEK_SET);
+
+    char buffer[64 * 1024];
+    ssize_t count{0};
+    while ((count = ::read(fd, buffer, sizeof(buffer))) > 0)
+        result.append(buffer, static_cast<std::size_t>(count));
+
+    return result;
+}
+
+/**
+ * Create an anonymous temporary file, where the worker stores its result.
+ * The file is unlinked immediately, so it is removed when both processes
+ * close it.
+ */
+int make_result_file()
+{
+    auto path =
+        (std::filesystem::temp_directory_path() / "clang-uml-XXXXXX").string();
+
+    const int fd = ::mkstemp(path.data());
+    if (fd < 0)
+        throw std::runtime_error("Cannot create worker result file");
+
+    ::unlink(path.c_str());
+
+    return fd;
+}
+
+void start_worker(worker &w,
+    const std::function<std::string(const std::vector<std::string> &)>
+        &process_shard)
+{
+    w.fd = make_result_file();
+
+    // Make sure buffered output is not written twice
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    w.pid = ::fork();
+    if (w.pid < 0) {
+        ::close(w.fd);
+        throw std::runtime_error("Cannot fork worker process");
+    }
+
+    if (w.pid == 0) {
+        int exit_code{0};
+        try {
+            if (!write_all(w.fd, process_shard(w.translation_units)))
+                exit_code = 1;
+        }
+        catch (const std::exception &e) {
+            write_all(w.fd, e.what());
+            exit_code = kWorkerErrorExitCode;
+        }
+        catch (...) {
+            exit_code = 1;
+        }
+        ::_exit(exit_code);
+    }
+}
+
+void finish_worker(worker &w, int status)
+{
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        w.status = worker_status_t::kOk;
+    else if (WIFEXITED(status) && WEXITSTATUS(status) == kWorkerErrorExitCode)
+        w.status = worker_status_t::kError;
+    else
+        w.status = worker_status_t::kCrashed;
+
+    if (w.status != worker_status_t::kCrashed)
+        w.result = read_all(w.fd);
+
+    ::close(w.fd);
+    w.fd = -1;
+}
+
+/**
+ * Wait until any of the running workers finishes and remove it from
+ * `running`. Workers are the only child processes while they are running,
+ * so any child process can be waited for.
+ */
+void wait_any_worker(std::vector<worker *> &running)
+{
+    while (!running.empty()) {
+        int status{0};
+        const auto pid = ::waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR)
+                continue;
+
+            // The workers cannot be waited for anymore
+            for (auto *w : running)
+                finish_worker(*w, -1);
+            running.clear();
+            return;
+        }
+
+        auto it = std::find_if(running.begin(), running.end(),
+            [pid](const worker *w) { return w->pid == pid; });
+        if (it == running.end())
+            continue;
+
+        finish_worker(**it, status);
+        running.erase(it);
+        return;
+    }
+}
+
+void run_workers(std::vector<worker> &workers, unsigned jobs,
+    const std::function<std::string(const std::vector<std::string> &)>
+        &process_shard)
+{
+    std::vector<worker *> running;
+
+    for (auto &w : workers) {
+        // Start next worker as soon as any of the running workers finishes
+        if (running.size() >= std::max(jobs, 1U))
+            wait_any_worker(running);
+
+        start_worker(w, process_shard);
+        running.push_back(&w);
+    }
+
+    while (!running.empty())
+        wait_any_worker(running);
+}
+} // namespace
+
+std::vector<std::string> run_worker_processes(
+    const std::vector<std::string> &translation_units, unsigned jobs,
+    const std::function<std::string(const std::vector<std::string> &)>
+        &process_shard,
+    const std::function<void(const std::vector<std::string> &,
+        std::string_view)> &merge_shard,
+    const translation_unit_cost_t &cost)
+{
+    std::vector<worker> workers;
+    for (auto &shard : make_shards(translation_units, jobs, cost))
+        workers.emplace_back(std::move(shard));
+
+    run_workers(workers, jobs, process_shard);
+
+    // Retry translation units from crashed shards one by one, to find the
+    // ones which cannot be processed
+    std::vector<worker> retried;
+    for (const auto &w : workers) {
+        if (w.status != worker_status_t::kCrashed ||
+            w.translation_units.size() < 2)
+            continue;
+
+        LOG_WARN("Worker processing {} translation units crashed, retrying "
+                 "them separately",
+            w.translation_units.size());
+
+        for (const auto &tu : w.translation_units)
+            retried.emplace_back(std::vector<std::string>{tu});
+    }
+
+    run_workers(retried, jobs, process_shard);
+
+    std::vector<const worker *> results;
+    auto retried_it = retried.cbegin();
+    for (const auto &w : workers) {
+        if (w.status == worker_status_t::kCrashed &&
+            w.translation_units.size() > 1) {
+            for (auto i = 0U; i < w.translation_units.size(); i++)
+                results.push_back(&*retried_it++);
+        }
+        else
+            results.push_back(&w);
+    }
+
+    std::vector<std::string> skipped;
+    std::optional<std::string> error;
+    for (const auto *w : results) {
+        if (w->status == worker_status_t::kError && !error)
+            error = w->result;
+        else if (w->status == worker_status_t::kCrashed) {
+            LOG_ERROR("Worker process crashed while processing translation "
+                      "unit {} - skipping",
+                w->translation_units.front());
+            skipped.push_back(w->translation_units.front());
+        }
+    }
+
+    if (error)
+        throw std::runtime_error(*error);
+
+    for (const auto *w : results) {
+        if (w->status == worker_status_t::kOk)
+            merge_shard(w->translation_units, w->result);
+    }
+
+    return skipped;
+}
+#endif
+
+} // namespace clanguml::common::generators
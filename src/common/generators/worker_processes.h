@@ -0,0 +1,94 @@
+/**
+ * @file src/common/generators/worker_processes.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Estimated cost of processing a translation unit.
+ */
+using translation_unit_cost_t = std::function<double(const std::string &)>;
+
+/**
+ * @brief Split translation units into shards.
+ *
+ * Without `cost`, translation units are split into contiguous shards of
+ * equal size. Otherwise, translation units are assigned longest first to
+ * the shard with the lowest total estimated cost, so that all shards take
+ * roughly the same time. Translation units in each shard retain their
+ * original order.
+ *
+ * @param translation_units List of translation units
+ * @param jobs Maximum number of shards
+ * @param cost Optional estimated cost of translation units
+ * @return List of at most `jobs` non-empty shards
+ */
+std::vector<std::vector<std::string>> make_shards(
+    const std::vector<std::string> &translation_units, unsigned jobs,
+    const translation_unit_cost_t &cost = {});
+
+/**
+ * @brief Process translation units in forked worker processes.
+ *
+ * Translation units are split into shards, each of which is processed in a
+ * separate worker process by `process_shard`, which returns the serialized
+ * partial model. The partial models are then passed to `merge_shard` in the
+ * parent process, in the order of the shards.
+ *
+ * If a worker crashes (e.g. due to a Clang assertion on a single
+ * translation unit), translation units from its shard are retried one by
+ * one and the ones which crash again are skipped. At most `jobs` workers run
+ * at the same time, and a new worker is started as soon as any of them
+ * finishes. As the caller waits for any of its child processes, it must not
+ * start any other child processes while the workers are running.
+ *
+ * If `process_shard` throws, the worker's error message is rethrown as
+ * `std::runtime_error` in the parent process, after all workers finished.
+ *
+ * Workers are created using `fork()`, so they only inherit the calling
+ * thread, along with the state of all locks in the parent process. This is
+ * only safe if no other thread can hold a lock which a worker may need
+ * (e.g. of a logger sink) at the time of `fork()`. The caller must ensure
+ * that no other thread is running anything except waiting for the calling
+ * thread, as `generate_diagrams()` does by generating diagrams on a single
+ * thread when worker processes are enabled. Neither the loggers nor the
+ * progress indicators run their own threads - they log synchronously from
+ * the thread generating the diagram.
+ *
+ * @param translation_units List of translation units
+ * @param jobs Maximum number of concurrent worker processes
+ * @param process_shard Function generating a partial model in the worker
+ * @param merge_shard Function merging the partial model in the parent
+ * @param cost Optional estimated cost of translation units used to balance
+ *             the shards
+ * @return List of skipped translation units
+ */
+std::vector<std::string> run_worker_processes(
+    const std::vector<std::string> &translation_units, unsigned jobs,
+    const std::function<std::string(const std::vector<std::string> &)>
+        &process_shard,
+    const std::function<void(const std::vector<std::string> &,
+        std::string_view)> &merge_shard,
+    const translation_unit_cost_t &cost = {});
+
+} // namespace clanguml::common::generators
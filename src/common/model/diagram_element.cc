@@ -27,6 +27,24 @@ namespace clanguml::common::model {
 
 diagram_element::diagram_element() = default;
 
+const std::string &diagram_element::incomplete_full_name(bool relative) const
+{
+    auto &names = incomplete_full_names_.at(relative ? 1 : 0);
+
+    const auto retain = [&names](auto &&name) -> const std::string & {
+        if (names.empty() || names.back() != name)
+            names.emplace_back(std::forward<decltype(name)>(name));
+        return names.back();
+    };
+
+    if (is_full_name_cacheable()) {
+        return retain(full_name_cache_.at(relative ? 1 : 0).get(
+            true, [this, relative]() { return full_name_impl(relative); }));
+    }
+
+    return retain(full_name_impl(relative));
+}
+
 const eid_t &diagram_element::id() const { return id_; }
 
 void diagram_element::set_id(eid_t id) { id_ = id; }
@@ -25,8 +25,10 @@
 
 #include <inja/inja.hpp>
 
+#include <array>
 #include <atomic>
 #include <exception>
+#include <list>
 #include <set>
 #include <string>
 #include <vector>
@@ -35,7 +37,6 @@ namespace clanguml::common::model {
 
 class diagram_filter;
 
-struct full_name_tag_t { };
 struct name_and_ns_tag { };
 
 /**
@@ -47,7 +48,6 @@ struct name_and_ns_tag { };
 class diagram_element
     : public decorated_element,
       public source_location,
-      public util::memoized<full_name_tag_t, std::string, bool>,
       public util::memoized<name_and_ns_tag, std::string> {
 public:
     diagram_element();
@@ -104,6 +104,7 @@ public:
     void set_name(const std::string &name)
     {
         util::memoized<name_and_ns_tag, std::string>::invalidate();
+        invalidate_full_name();
         name_ = name;
     }
 
@@ -123,7 +124,7 @@ public:
      *
      * @return Diagram element name.
      */
-    std::string name() const { return name_; }
+    const std::string &name() const { return name_; }
 
     /**
      * Return the type name of the diagram element.
@@ -138,14 +139,24 @@ public:
      * This method should be implemented in each subclass, and ensure that
      * for instance it includes fully qualified namespace, template params, etc.
      *
+     * Once the element is complete, a reference to the memoized name is
+     * returned, which can be read concurrently.
+     *
+     * Names of incomplete elements can change with any setter, so they are
+     * rendered on each call (or taken from the cache kept during visitation,
+     * see @ref is_full_name_cacheable()) and each distinct name is retained
+     * by the element, so that references returned earlier are never changed
+     * by later calls.
+     *
      * @return Full elements name.
      */
-    std::string full_name(bool relative) const
+    const std::string &full_name(bool relative) const
     {
-        return util::memoized<full_name_tag_t, std::string, bool>::memoize(
-            complete(),
-            [this](bool relative) { return full_name_impl(relative); },
-            relative);
+        if (!complete())
+            return incomplete_full_name(relative);
+
+        return full_name_cache_.at(relative ? 1 : 0).get(
+            true, [this, relative]() { return full_name_impl(relative); });
     }
 
     /**
@@ -225,7 +236,32 @@ protected:
         return name();
     }
 
+    /**
+     * @brief Whether the full name can be cached before element is complete.
+     *
+     * Elements should only return true, if all their setters which affect
+     * the result of `full_name_impl()` call `invalidate_full_name()`.
+     *
+     * @return True, if full name can be cached during visitation.
+     */
+    virtual bool is_full_name_cacheable() const { return false; }
+
+    /**
+     * @brief Invalidate cached full name.
+     */
+    void invalidate_full_name() const
+    {
+        for (auto &cache : full_name_cache_)
+            cache.invalidate();
+    }
+
 private:
+    const std::string &incomplete_full_name(bool relative) const;
+
+    std::array<util::memoized_value<std::string>, 2> full_name_cache_;
+    /** Distinct names returned by full_name() before the element is
+     *  complete */
+    mutable std::array<std::list<std::string>, 2> incomplete_full_names_;
     eid_t id_{};
     std::optional<eid_t> parent_element_id_{};
     std::string name_;
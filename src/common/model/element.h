@@ -61,6 +61,7 @@ public:
     void set_namespace(const namespace_ &ns)
     {
         util::memoized<name_and_ns_tag, std::string>::invalidate();
+        invalidate_full_name();
         ns_ = ns;
     }
 
@@ -20,25 +20,197 @@
 
 #include "common/generators/display_adapters.h"
 
+#include <algorithm>
+
 namespace clanguml::common::jinja {
 
 using clanguml::common::generators::display_name_adapter;
 
 using namespace clanguml::common::model;
 
+namespace {
+/**
+ * @brief Collects names of data variables referenced in a parsed template.
+ */
+class template_variables_collector : public inja::NodeVisitor {
+public:
+    void visit(const inja::BlockNode &node) override
+    {
+        for (const auto &n : node.nodes)
+            n->accept(*this);
+    }
+
+    void visit(const inja::TextNode & /*node*/) override { }
+
+    void visit(const inja::ExpressionNode & /*node*/) override { }
+
+    void visit(const inja::LiteralNode & /*node*/) override { }
+
+    void visit(const inja::DataNode &node) override
+    {
+        names.emplace_back(node.name);
+    }
+
+    void visit(const inja::FunctionNode &node) override
+    {
+        using op_t = inja::FunctionStorage::Operation;
+
+        // These functions refer to variables by name in string literals
+        if (node.operation == op_t::Exists ||
+            node.operation == op_t::ExistsInObject)
+            all = true;
+
+        for (const auto &n : node.arguments)
+            n->accept(*this);
+    }
+
+    void visit(const inja::ExpressionListNode &node) override
+    {
+        if (node.root)
+            node.root->accept(*this);
+    }
+
+    void visit(const inja::StatementNode & /*node*/) override { }
+
+    void visit(const inja::ForStatementNode & /*node*/) override { }
+
+    void visit(const inja::ForArrayStatementNode &node) override
+    {
+        node.condition.accept(*this);
+        node.body.accept(*this);
+    }
+
+    void visit(const inja::ForObjectStatementNode &node) override
+    {
+        node.condition.accept(*this);
+        node.body.accept(*this);
+    }
+
+    void visit(const inja::IfStatementNode &node) override
+    {
+        node.condition.accept(*this);
+        node.true_statement.accept(*this);
+        node.false_statement.accept(*this);
+    }
+
+    void visit(const inja::IncludeStatementNode & /*node*/) override
+    {
+        all = true;
+    }
+
+    void visit(const inja::ExtendsStatementNode & /*node*/) override
+    {
+        all = true;
+    }
+
+    void visit(const inja::BlockStatementNode &node) override
+    {
+        node.block.accept(*this);
+    }
+
+    void visit(const inja::SetStatementNode &node) override
+    {
+        node.expression.accept(*this);
+    }
+
+    bool all{false};
+    std::vector<std::string> names;
+};
+
+template <typename F>
+std::optional<std::string> render_or_warn(
+    const std::string &jinja_template, F &&render)
+{
+    std::optional<std::string> result;
+
+    try {
+        result = render();
+    }
+    catch (const clanguml::error::uml_alias_missing &e) {
+        LOG_WARN("Failed to render Jinja template '{}' due to unresolvable "
+                 "alias: {}",
+            jinja_template, e.what());
+    }
+    catch (const inja::json::parse_error &e) {
+        LOG_WARN("Failed to parse Jinja template: {}", jinja_template);
+    }
+    catch (const inja::json::exception &e) {
+        LOG_WARN("Failed to render Jinja template: \n{}\n due to: {}",
+            jinja_template, e.what());
+    }
+    catch (const std::regex_error &e) {
+        LOG_WARN("Failed to render Jinja template: \n{}\n due to "
+                 "std::regex_error: {}",
+            jinja_template, e.what());
+    }
+    catch (const std::exception &e) {
+        LOG_WARN("Failed to render Jinja template: \n{}\n due to: {}",
+            jinja_template, e.what());
+    }
+
+    return result;
+}
+
+bool is_same_or_parent(std::string_view parent, std::string_view name)
+{
+    return util::starts_with(name, parent) &&
+        (name.size() == parent.size() || name[parent.size()] == '.');
+}
+} // namespace
+
+template_variables::template_variables(const inja::Template &t)
+{
+    template_variables_collector collector;
+    t.root.accept(collector);
+
+    all_ = collector.all;
+    names_ = std::move(collector.names);
+}
+
+const template_variables &template_variables::all()
+{
+    static const template_variables all_variables;
+    return all_variables;
+}
+
+bool template_variables::references(std::string_view name) const
+{
+    if (all_)
+        return true;
+
+    return std::any_of(names_.begin(), names_.end(), [name](const auto &n) {
+        return is_same_or_parent(n, name) || is_same_or_parent(name, n);
+    });
+}
+
+const std::string &git_relative_paths::get(
+    const std::filesystem::path &file, const std::string &toplevel)
+{
+    auto it = paths_.find(file.string());
+    if (it != paths_.end())
+        return it->second;
+
+    return paths_
+        .emplace(file.string(),
+            std::filesystem::relative(weakly_canonical(file), toplevel)
+                .string())
+        .first->second;
+}
+
 void to_json(inja::json &ctx,
     const element_context<common::model::decorated_element> &jc)
 {
     if (const auto maybe_comment = jc.get().comment();
-        maybe_comment.has_value()) {
+        maybe_comment.has_value() && jc.references("element.comment")) {
         ctx["element"]["comment"] = maybe_comment.value();
     }
 
-    if (jc.diagram_context().contains("git")) {
+    if (jc.diagram_context().contains("git") && jc.references("git")) {
         ctx["git"] = jc.diagram_context()["git"];
     }
 
-    if (jc.diagram_context().contains("user_data")) {
+    if (jc.diagram_context().contains("user_data") &&
+        jc.references("user_data")) {
         ctx["user_data"] = jc.diagram_context()["user_data"];
     }
 }
@@ -47,14 +219,20 @@ void to_json(inja::json &ctx, const element_context<diagram_element> &jc)
 {
     to_json(ctx, jc.as<decorated_element>());
 
-    ctx["element"]["name"] = display_name_adapter(jc.get()).name();
-    ctx["element"]["type"] = jc.get().type_name();
-    ctx["element"]["alias"] = jc.get().alias();
-    ctx["element"]["full_name"] =
-        display_name_adapter(jc.get()).full_name(false);
-    auto maybe_doxygen_link = jc.get().doxygen_link();
-    if (maybe_doxygen_link)
-        ctx["element"]["doxygen_link"] = maybe_doxygen_link.value();
+    if (jc.references("element.name"))
+        ctx["element"]["name"] = display_name_adapter(jc.get()).name();
+    if (jc.references("element.type"))
+        ctx["element"]["type"] = jc.get().type_name();
+    if (jc.references("element.alias"))
+        ctx["element"]["alias"] = jc.get().alias();
+    if (jc.references("element.full_name"))
+        ctx["element"]["full_name"] =
+            display_name_adapter(jc.get()).full_name(false);
+    if (jc.references("element.doxygen_link")) {
+        auto maybe_doxygen_link = jc.get().doxygen_link();
+        if (maybe_doxygen_link)
+            ctx["element"]["doxygen_link"] = maybe_doxygen_link.value();
+    }
 
     to_json(ctx, jc.as<source_location>());
 }
@@ -63,8 +241,11 @@ void to_json(inja::json &ctx, const element_context<element> &jc)
 {
     to_json(ctx, jc.as<diagram_element>());
 
-    ctx["element"]["using_namespace"] = jc.get().using_namespace().to_string();
-    ctx["element"]["namespace"] = jc.get().get_namespace().to_string();
+    if (jc.references("element.using_namespace"))
+        ctx["element"]["using_namespace"] =
+            jc.get().using_namespace().to_string();
+    if (jc.references("element.namespace"))
+        ctx["element"]["namespace"] = jc.get().get_namespace().to_string();
 }
 
 void to_json(
@@ -87,6 +268,9 @@ void to_json(inja::json &ctx, const element_context<source_file> &jc)
 {
     to_json(ctx, jc.as<diagram_element>());
 
+    if (!ctx.contains("element") || !ctx["element"].contains("full_name"))
+        return;
+
     std::filesystem::path fullNamePath{
         ctx["element"]["full_name"].get<std::string>()};
     fullNamePath.make_preferred();
@@ -130,28 +314,29 @@ void to_json(inja::json &ctx, const element_context<source_location> &jc)
 {
     const auto &e = jc.get();
 
-    if (!e.file().empty()) {
+    if (!ctx.contains("git") && jc.diagram_context().contains("git") &&
+        jc.references("git")) {
+        ctx["git"] = jc.diagram_context()["git"];
+    }
+
+    if (!ctx.contains("user_data") &&
+        jc.diagram_context().contains("user_data") &&
+        jc.references("user_data")) {
+        ctx["user_data"] = jc.diagram_context()["user_data"];
+    }
+
+    if (!e.file().empty() && jc.references("element.source")) {
         const std::filesystem::path file{e.file()};
-        std::string git_relative_path = file.string();
         if (!e.file_relative().empty()) {
-#if _MSC_VER
-            if (file.is_absolute() && ctx.contains("git")) {
-#else
-            if (file.is_absolute() && ctx.contains("git")) {
-#endif
-                git_relative_path = std::filesystem::relative(
-                    weakly_canonical(file), ctx["git"]["toplevel"])
-                                        .string();
-
+            if (file.is_absolute() && jc.diagram_context().contains("git")) {
                 ctx["element"]["source"]["path"] =
-                    util::path_to_url(git_relative_path);
+                    util::path_to_url(jc.git_relative_path(file));
             }
             else {
                 ctx["element"]["source"]["path"] = e.file();
             }
         }
         else {
-            git_relative_path = "";
             ctx["element"]["source"]["path"] = e.file();
         }
 
@@ -210,41 +395,41 @@ void to_json(inja::json &ctx, const diagram_context<source_file> &jc)
 std::optional<std::string> render_template(inja::Environment &env,
     const inja::json &context, const std::string &jinja_template)
 {
-    std::optional<std::string> result;
+    if (jinja_template.empty())
+        return {};
 
+    return render_or_warn(jinja_template, [&]() {
+        // Render the directive with template engine first
+        return env.render(std::string_view{jinja_template}, context);
+    });
+}
+
+std::optional<std::string> render_template(inja::Environment &env,
+    const inja::json &context, const parsed_template &jinja_template)
+{
+    return render_or_warn(jinja_template.tmpl.content,
+        [&]() { return env.render(jinja_template.tmpl, context); });
+}
+
+std::unique_ptr<parsed_template> parse_template(
+    inja::Environment &env, const std::string &jinja_template)
+{
     if (jinja_template.empty())
-        return result;
+        return {};
 
     try {
-        // Render the directive with template engine first
-        auto rendered_template =
-            env.render(std::string_view{jinja_template}, context);
+        auto tmpl = env.parse(jinja_template);
+        template_variables variables{tmpl};
 
-        result = std::move(rendered_template);
-    }
-    catch (const clanguml::error::uml_alias_missing &e) {
-        LOG_WARN("Failed to render Jinja template '{}' due to unresolvable "
-                 "alias: {}",
-            jinja_template, e.what());
-    }
-    catch (const inja::json::parse_error &e) {
-        LOG_WARN("Failed to parse Jinja template: {}", jinja_template);
-    }
-    catch (const inja::json::exception &e) {
-        LOG_WARN("Failed to render Jinja template: \n{}\n due to: {}",
-            jinja_template, e.what());
-    }
-    catch (const std::regex_error &e) {
-        LOG_WARN("Failed to render Jinja template: \n{}\n due to "
-                 "std::regex_error: {}",
-            jinja_template, e.what());
+        return std::make_unique<parsed_template>(
+            parsed_template{std::move(tmpl), std::move(variables)});
     }
     catch (const std::exception &e) {
-        LOG_WARN("Failed to render Jinja template: \n{}\n due to: {}",
+        LOG_WARN("Failed to parse Jinja template: \n{}\n due to: {}",
             jinja_template, e.what());
     }
 
-    return result;
+    return {};
 }
 
 std::optional<std::string> render_template(
@@ -25,13 +25,94 @@
 
 #include <inja/inja.hpp>
 
+#include <filesystem>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace clanguml::common::jinja {
 
 struct diagram_context_tag;
 struct element_context_tag;
 
+/**
+ * @brief Data variables referenced by a Jinja template.
+ *
+ * Element contexts only compute the fields, which are referenced by the
+ * template they will be rendered with.
+ */
+class template_variables {
+public:
+    /**
+     * @brief Collect data variables referenced in a parsed template.
+     *
+     * Templates including other templates, or checking existence of
+     * variables by name, are assumed to reference all variables.
+     *
+     * @param t Parsed Jinja template
+     */
+    explicit template_variables(const inja::Template &t);
+
+    /**
+     * @brief Variables of a template, which references the entire context.
+     *
+     * @return Reference to template variables matching all names
+     */
+    static const template_variables &all();
+
+    /**
+     * @brief Check whether the template references a context variable.
+     *
+     * A variable is referenced, if the template references it, any of its
+     * members or any of its parents (e.g. `element.source` is referenced
+     * by both `element.source.path` and `element`).
+     *
+     * @param name Dot separated variable name
+     * @return True, if the variable is referenced by the template
+     */
+    bool references(std::string_view name) const;
+
+private:
+    template_variables() = default;
+
+    bool all_{true};
+    std::vector<std::string> names_;
+};
+
+/**
+ * @brief Jinja template parsed once and rendered for multiple elements.
+ */
+struct parsed_template {
+    inja::Template tmpl;
+    template_variables variables;
+};
+
+/**
+ * @brief Memoizes paths of source files relative to the Git toplevel
+ *        directory.
+ *
+ * Computing the relative path requires resolving the canonical path of the
+ * file, which accesses the filesystem. All paths in a single cache must be
+ * relative to the same toplevel directory.
+ */
+class git_relative_paths {
+public:
+    /**
+     * @brief Get path of the file relative to the Git toplevel directory.
+     *
+     * @param file Absolute path to the source file
+     * @param toplevel Git toplevel directory
+     * @return Relative path to the file
+     */
+    const std::string &get(
+        const std::filesystem::path &file, const std::string &toplevel);
+
+private:
+    std::unordered_map<std::string, std::string> paths_;
+};
+
 /**
  * @brief Jinja diagram element context wrapper
  *
@@ -42,10 +123,21 @@ struct element_context_tag;
  */
 template <typename T, typename Tag> class jinja_context {
 public:
-    explicit jinja_context(
-        const T &e, const inja::json &diagram_context) noexcept
+    /**
+     * @brief Constructor.
+     *
+     * @param e Diagram model element
+     * @param diagram_context Diagram-wide Jinja context
+     * @param variables Variables referenced by the rendered template
+     * @param paths Optional cache of Git relative paths of source files
+     */
+    explicit jinja_context(const T &e, const inja::json &diagram_context,
+        const template_variables &variables = template_variables::all(),
+        git_relative_paths *paths = nullptr) noexcept
         : value_{e}
         , diagram_context_{diagram_context}
+        , variables_{variables}
+        , paths_{paths}
     {
     }
 
@@ -58,15 +150,48 @@ public:
 
     template <typename U> const jinja_context<U, Tag> as() const
     {
-        return jinja_context<U, Tag>(
-            dynamic_cast<const U &>(value_), diagram_context_);
+        return jinja_context<U, Tag>(dynamic_cast<const U &>(value_),
+            diagram_context_, variables_, paths_);
     }
 
     const inja::json &diagram_context() const { return diagram_context_; }
 
+    /**
+     * @brief Check whether the rendered template references a variable.
+     *
+     * @param name Dot separated variable name
+     * @return True, if the variable should be added to the context
+     */
+    bool references(std::string_view name) const
+    {
+        return variables_.references(name);
+    }
+
+    /**
+     * @brief Get path of a file relative to the Git toplevel directory
+     *        from the diagram context.
+     *
+     * @param file Absolute path to the source file
+     * @return Relative path to the file
+     */
+    std::string git_relative_path(const std::filesystem::path &file) const
+    {
+        const auto &toplevel = diagram_context_.at("git")
+                                   .at("toplevel")
+                                   .get_ref<const std::string &>();
+
+        if (paths_ != nullptr)
+            return paths_->get(file, toplevel);
+
+        return std::filesystem::relative(weakly_canonical(file), toplevel)
+            .string();
+    }
+
 private:
     const T &value_;
     const inja::json &diagram_context_;
+    const template_variables &variables_;
+    git_relative_paths *paths_;
 };
 
 template <typename T>
@@ -110,6 +235,27 @@ void to_json(
 std::optional<std::string> render_template(inja::Environment &env,
     const inja::json &context, const std::string &jinja_template);
 
+/**
+ * @brief Render template parsed with @ref parse_template.
+ *
+ * @param env Jinja environment
+ * @param context Jinja context
+ * @param jinja_template Parsed template
+ * @return Rendered template, or empty optional in case of an error
+ */
+std::optional<std::string> render_template(inja::Environment &env,
+    const inja::json &context, const parsed_template &jinja_template);
+
+/**
+ * @brief Parse Jinja template, in order to render it multiple times.
+ *
+ * @param env Jinja environment
+ * @param jinja_template Jinja template
+ * @return Parsed template, or nullptr in case of an error
+ */
+std::unique_ptr<parsed_template> parse_template(
+    inja::Environment &env, const std::string &jinja_template);
+
 std::optional<std::string> render_template(
     inja::Environment &env, const std::string &jinja_template);
 
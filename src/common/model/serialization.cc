@@ -0,0 +1,692 @@
+/**
+ * @file src/common/model/serialization.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization.h"
+
+#include "decorators/decorators.h"
+#include "util/error.h"
+#include "util/util.h"
+
+#include <fmt/format.h>
+
+namespace clanguml::common::model {
+
+namespace {
+constexpr auto kVarintPayloadBits{7U};
+constexpr std::uint8_t kVarintPayloadMask{0x7FU};
+constexpr std::uint8_t kVarintContinuationBit{0x80U};
+constexpr auto kMaxVarintShift{63U};
+constexpr auto kIdBytes{8U};
+constexpr auto kBitsInByte{8U};
+
+template <typename T>
+std::shared_ptr<decorators::decorator> make_decorator(binary_reader &r)
+{
+    auto d = std::make_shared<T>();
+    d->diagrams = r.read_strings();
+    return d;
+}
+} // namespace
+
+void binary_writer::write_bool(bool v) { buffer_.push_back(v ? 1 : 0); }
+
+void binary_writer::write_uint(std::uint64_t v)
+{
+    while (v > kVarintPayloadMask) {
+        buffer_.push_back(static_cast<char>(
+            (v & kVarintPayloadMask) | kVarintContinuationBit));
+        v >>= kVarintPayloadBits;
+    }
+    buffer_.push_back(static_cast<char>(v));
+}
+
+void binary_writer::write_id(const eid_t &id)
+{
+    if (id.is_global()) {
+        if (auto it = ids_.find(id.value()); it != ids_.end()) {
+            write_uint(it->second + 1);
+            return;
+        }
+    }
+
+    write_uint(0);
+    write_bool(id.is_global());
+
+    auto v = id.value();
+    for (auto i = 0U; i < kIdBytes; i++) {
+        buffer_.push_back(static_cast<char>(v & 0xFFU));
+        v >>= kBitsInByte;
+    }
+
+    // Only global ids are interned, local ids should not end up in the
+    // model in the first place
+    if (id.is_global())
+        ids_.emplace(id.value(), ids_.size());
+}
+
+void binary_writer::write_string(std::string_view s)
+{
+    if (auto it = strings_.find(s); it != strings_.end()) {
+        write_uint(it->second + 1);
+        return;
+    }
+
+    write_uint(0);
+    write_uint(s.size());
+    buffer_.append(s);
+
+    strings_.emplace(string_storage_.emplace_back(s), strings_.size());
+}
+
+void binary_writer::write_optional_string(const std::optional<std::string> &s)
+{
+    write_bool(s.has_value());
+    if (s)
+        write_string(*s);
+}
+
+void binary_writer::write_strings(const std::vector<std::string> &s)
+{
+    write_uint(s.size());
+    for (const auto &str : s)
+        write_string(str);
+}
+
+const std::string &binary_writer::buffer() const { return buffer_; }
+
+std::string binary_writer::release()
+{
+    std::string result;
+    std::swap(result, buffer_);
+    strings_.clear();
+    string_storage_.clear();
+    ids_.clear();
+    return result;
+}
+
+void binary_writer::write_bytes(std::string_view bytes)
+{
+    buffer_.append(bytes);
+}
+
+binary_reader::binary_reader(std::string_view buffer)
+    : buffer_{buffer}
+{
+}
+
+std::string_view binary_reader::take(std::size_t size)
+{
+    if (size > buffer_.size() - offset_)
+        throw error::model_serialization_error(
+            fmt::format("Unexpected end of serialized model at offset {}: "
+                        "expected {} more bytes",
+                offset_, size));
+
+    const auto result = buffer_.substr(offset_, size);
+    offset_ += size;
+    return result;
+}
+
+bool binary_reader::read_bool() { return take(1)[0] != 0; }
+
+std::uint64_t binary_reader::read_uint()
+{
+    std::uint64_t result{0};
+
+    for (auto shift = 0U;; shift += kVarintPayloadBits) {
+        if (shift > kMaxVarintShift)
+            throw error::model_serialization_error(fmt::format(
+                "Invalid variable length integer at offset {}", offset_));
+
+        const auto byte = static_cast<std::uint8_t>(take(1)[0]);
+        result |= static_cast<std::uint64_t>(byte & kVarintPayloadMask)
+            << shift;
+
+        if ((byte & kVarintContinuationBit) == 0)
+            break;
+    }
+
+    return result;
+}
+
+eid_t binary_reader::read_id()
+{
+    if (const auto index = read_uint(); index > 0) {
+        if (index > ids_.size())
+            throw error::model_serialization_error(fmt::format(
+                "Invalid id reference {} at offset {}", index, offset_));
+
+        return ids_[index - 1];
+    }
+
+    const auto is_global = read_bool();
+    const auto bytes = take(kIdBytes);
+
+    std::uint64_t v{0};
+    for (auto i = 0U; i < kIdBytes; i++) {
+        v |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(bytes[i]))
+            << (i * kBitsInByte);
+    }
+
+    if (is_global)
+        return ids_.emplace_back(v);
+
+    return eid_t{static_cast<int64_t>(v)};
+}
+
+std::string_view binary_reader::read_string_view()
+{
+    if (const auto index = read_uint(); index > 0) {
+        if (index > strings_.size())
+            throw error::model_serialization_error(fmt::format(
+                "Invalid string reference {} at offset {}", index, offset_));
+
+        return strings_[index - 1];
+    }
+
+    const auto size = read_uint();
+    return strings_.emplace_back(take(size));
+}
+
+std::string binary_reader::read_string()
+{
+    return std::string{read_string_view()};
+}
+
+std::string_view binary_reader::read_bytes(std::size_t size)
+{
+    return take(size);
+}
+
+std::optional<std::string> binary_reader::read_optional_string()
+{
+    if (!read_bool())
+        return {};
+
+    return read_string();
+}
+
+std::vector<std::string> binary_reader::read_strings()
+{
+    std::vector<std::string> result;
+    const auto size = read_uint();
+    for (auto i = 0U; i < size; i++)
+        result.emplace_back(read_string());
+    return result;
+}
+
+bool binary_reader::at_end() const { return offset_ == buffer_.size(); }
+
+void write_header(binary_writer &w, diagram_t type)
+{
+    w.write_bytes(kModelFormatMagic);
+    w.write_uint(kModelFormatVersion);
+    w.write_enum(type);
+}
+
+diagram_t read_header(binary_reader &r)
+{
+    if (r.read_bytes(kModelFormatMagic.size()) != kModelFormatMagic)
+        throw error::model_serialization_error(
+            "Invalid serialized model header");
+
+    if (const auto version = r.read_uint(); version != kModelFormatVersion)
+        throw error::model_serialization_error(
+            fmt::format("Unsupported serialized model format version {} - "
+                        "expected {}",
+                version, kModelFormatVersion));
+
+    return r.read_enum<diagram_t>();
+}
+
+void write_path(binary_writer &w, const path &p)
+{
+    w.write_enum(p.type());
+    w.write_bool(p.is_root());
+    w.write_strings(p.tokens());
+}
+
+path read_path(binary_reader &r)
+{
+    const auto pt = r.read_enum<path_type>();
+    const auto is_root = r.read_bool();
+
+    path result{pt};
+    for (auto &token : r.read_strings())
+        result |= token;
+
+    result.is_root(is_root);
+
+    return result;
+}
+
+void write_source_location(binary_writer &w, const source_location &sl)
+{
+    // File paths are interned in a process wide table, so they have to be
+    // stored as strings
+    w.write_string(sl.file());
+    w.write_string(sl.file_relative());
+    w.write_string(sl.translation_unit());
+    w.write_uint(sl.line());
+    w.write_uint(sl.column());
+    w.write_uint(sl.location_id());
+}
+
+void read_source_location(binary_reader &r, source_location &sl)
+{
+    sl.set_file(r.read_string());
+    sl.set_file_relative(r.read_string());
+    sl.set_translation_unit(r.read_string());
+    sl.set_line(static_cast<unsigned>(r.read_uint()));
+    sl.set_column(static_cast<unsigned>(r.read_uint()));
+    sl.set_location_id(static_cast<unsigned>(r.read_uint()));
+}
+
+void write_decorators(binary_writer &w,
+    const std::vector<std::shared_ptr<decorators::decorator>> &decorators)
+{
+    w.write_uint(decorators.size());
+
+    for (const auto &d : decorators) {
+        if (const auto note = std::dynamic_pointer_cast<decorators::note>(d);
+            note) {
+            w.write_string(decorators::note::label);
+            w.write_strings(note->diagrams);
+            w.write_string(note->position);
+            w.write_string(note->text);
+        }
+        else if (std::dynamic_pointer_cast<decorators::skip>(d)) {
+            w.write_string(decorators::skip::label);
+            w.write_strings(d->diagrams);
+        }
+        else if (std::dynamic_pointer_cast<decorators::skip_relationship>(d)) {
+            w.write_string(decorators::skip_relationship::label);
+            w.write_strings(d->diagrams);
+        }
+        else if (const auto style =
+                     std::dynamic_pointer_cast<decorators::style>(d);
+                 style) {
+            w.write_string(decorators::style::label);
+            w.write_strings(style->diagrams);
+            w.write_string(style->spec);
+        }
+        else if (const auto call =
+                     std::dynamic_pointer_cast<decorators::call>(d);
+                 call) {
+            w.write_string(decorators::call::label);
+            w.write_strings(call->diagrams);
+            w.write_string(call->callee);
+        }
+        else if (const auto rel =
+                     std::dynamic_pointer_cast<decorators::relationship>(d);
+                 rel) {
+            if (std::dynamic_pointer_cast<decorators::aggregation>(d))
+                w.write_string(decorators::aggregation::label);
+            else if (std::dynamic_pointer_cast<decorators::composition>(d))
+                w.write_string(decorators::composition::label);
+            else
+                w.write_string(decorators::association::label);
+            w.write_strings(rel->diagrams);
+            w.write_string(rel->multiplicity);
+        }
+        else {
+            w.write_string({});
+        }
+    }
+
+}
+
+std::vector<std::shared_ptr<decorators::decorator>> read_decorators(
+    binary_reader &r)
+{
+    std::vector<std::shared_ptr<decorators::decorator>> result;
+
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++) {
+        const auto label = r.read_string();
+
+        if (label == decorators::note::label) {
+            auto d = std::make_shared<decorators::note>();
+            d->diagrams = r.read_strings();
+            d->position = r.read_string();
+            d->text = r.read_string();
+            result.emplace_back(std::move(d));
+        }
+        else if (label == decorators::skip::label) {
+            result.emplace_back(make_decorator<decorators::skip>(r));
+        }
+        else if (label == decorators::skip_relationship::label) {
+            result.emplace_back(
+                make_decorator<decorators::skip_relationship>(r));
+        }
+        else if (label == decorators::style::label) {
+            auto d = std::make_shared<decorators::style>();
+            d->diagrams = r.read_strings();
+            d->spec = r.read_string();
+            result.emplace_back(std::move(d));
+        }
+        else if (label == decorators::call::label) {
+            auto d = std::make_shared<decorators::call>();
+            d->diagrams = r.read_strings();
+            d->callee = r.read_string();
+            result.emplace_back(std::move(d));
+        }
+        else if (label == decorators::aggregation::label ||
+            label == decorators::composition::label ||
+            label == decorators::association::label) {
+            std::shared_ptr<decorators::relationship> d;
+            if (label == decorators::aggregation::label)
+                d = std::make_shared<decorators::aggregation>();
+            else if (label == decorators::composition::label)
+                d = std::make_shared<decorators::composition>();
+            else
+                d = std::make_shared<decorators::association>();
+            d->diagrams = r.read_strings();
+            d->multiplicity = r.read_string();
+            result.emplace_back(std::move(d));
+        }
+        else if (!label.empty()) {
+            throw error::model_serialization_error(
+                fmt::format("Invalid decorator type: {}", label));
+        }
+    }
+
+    return result;
+}
+
+void write_comment(binary_writer &w, const std::optional<comment_t> &c)
+{
+    w.write_bool(c.has_value());
+    if (c) {
+        const auto cbor = comment_t::to_cbor(*c);
+        w.write_string({reinterpret_cast<const char *>(cbor.data()),
+            cbor.size()}); // NOLINT
+    }
+}
+
+std::optional<comment_t> read_comment(binary_reader &r)
+{
+    if (!r.read_bool())
+        return {};
+
+    const auto cbor = r.read_string();
+    return comment_t::from_cbor(cbor.begin(), cbor.end());
+}
+
+void write_decorated_element(binary_writer &w, const decorated_element &e)
+{
+    write_decorators(w, e.decorators());
+    write_comment(w, e.comment());
+}
+
+void read_decorated_element(binary_reader &r, decorated_element &e)
+{
+    e.add_decorators(read_decorators(r));
+    if (auto comment = read_comment(r); comment)
+        e.set_comment(*comment);
+}
+
+void write_stylable_element(binary_writer &w, const stylable_element &e)
+{
+    w.write_optional_string(e.style());
+}
+
+void read_stylable_element(binary_reader &r, stylable_element &e)
+{
+    if (auto style = r.read_optional_string(); style)
+        e.set_style(*style);
+}
+
+void write_relationship(binary_writer &w, const relationship &rel)
+{
+    w.write_enum(rel.type());
+    w.write_id(rel.destination());
+    w.write_enum(rel.access());
+    w.write_string(rel.label());
+    w.write_string(rel.multiplicity_source());
+    w.write_string(rel.multiplicity_destination());
+    w.write_bool(rel.is_virtual());
+    write_decorated_element(w, rel);
+    write_stylable_element(w, rel);
+    write_source_location(w, rel);
+}
+
+relationship read_relationship(binary_reader &r)
+{
+    const auto type = r.read_enum<relationship_t>();
+    const auto destination = r.read_id();
+    const auto access = r.read_enum<access_t>();
+    auto label = r.read_string();
+    auto multiplicity_source = r.read_string();
+    auto multiplicity_destination = r.read_string();
+
+    relationship rel{type, destination, access, std::move(label),
+        std::move(multiplicity_source), std::move(multiplicity_destination)};
+    if (r.read_bool())
+        rel.set_virtual(true);
+    read_decorated_element(r, rel);
+    read_stylable_element(r, rel);
+    read_source_location(r, rel);
+
+    return rel;
+}
+
+void write_diagram_element(binary_writer &w, const diagram_element &e)
+{
+    w.write_id(e.id());
+    w.write_bool(e.parent_element_id().has_value());
+    if (e.parent_element_id())
+        w.write_id(*e.parent_element_id());
+    w.write_string(e.name());
+    w.write_bool(e.is_nested());
+    w.write_bool(e.complete());
+
+    w.write_uint(e.relationships().size());
+    for (const auto &rel : e.relationships())
+        write_relationship(w, rel);
+
+    write_decorated_element(w, e);
+    write_source_location(w, e);
+}
+
+void read_diagram_element(binary_reader &r, diagram_element &e)
+{
+    e.set_id(r.read_id());
+    if (r.read_bool())
+        e.set_parent_element_id(r.read_id());
+    e.set_name(r.read_string());
+    e.nested(r.read_bool());
+    e.complete(r.read_bool());
+
+    // Relationships are stored as is, as they have been already
+    // deduplicated when the partial model was built
+    const auto count = r.read_uint();
+    e.relationships().reserve(count);
+    for (auto i = 0U; i < count; i++)
+        e.relationships().emplace_back(read_relationship(r));
+
+    read_decorated_element(r, e);
+    read_source_location(r, e);
+}
+
+void write_element(binary_writer &w, const element &e)
+{
+    write_diagram_element(w, e);
+    write_path(w, e.get_namespace());
+    w.write_optional_string(e.module());
+    w.write_bool(e.module_private());
+}
+
+void read_element(binary_reader &r, element &e)
+{
+    read_diagram_element(r, e);
+    e.set_namespace(read_path(r));
+    if (auto module = r.read_optional_string(); module)
+        e.set_module(*module);
+    e.set_module_private(r.read_bool());
+}
+
+void write_template_parameter(binary_writer &w, const template_parameter &tp)
+{
+    w.write_enum(tp.kind());
+    w.write_optional_string(tp.type());
+    w.write_optional_string(tp.name());
+    w.write_optional_string(tp.default_value());
+    w.write_bool(tp.is_template_parameter());
+    w.write_bool(tp.is_template_template_parameter());
+    w.write_bool(tp.is_ellipsis());
+    w.write_bool(tp.is_variadic());
+    w.write_bool(tp.is_function_template());
+    w.write_bool(tp.is_data_pointer());
+    w.write_bool(tp.is_member_pointer());
+    w.write_bool(tp.is_array());
+    w.write_bool(tp.is_unexposed());
+
+    w.write_uint(tp.deduced_context().size());
+    for (const auto &c : tp.deduced_context()) {
+        w.write_bool(c.is_const);
+        w.write_bool(c.is_volatile);
+        w.write_bool(c.is_ref_const);
+        w.write_bool(c.is_ref_volatile);
+        w.write_enum(c.pr);
+    }
+
+    w.write_optional_string(tp.concept_constraint());
+
+    w.write_bool(tp.id().has_value());
+    if (tp.id())
+        w.write_id(*tp.id());
+
+    w.write_uint(tp.template_params().size());
+    for (const auto &nested : tp.template_params())
+        write_template_parameter(w, nested);
+}
+
+template_parameter read_template_parameter(binary_reader &r)
+{
+    auto tp = template_parameter::make_empty();
+
+    // The kind is set after the remaining properties, as setters validate
+    // them against the kind of the parameter
+    const auto kind = r.read_enum<template_parameter_kind_t>();
+    if (auto type = r.read_optional_string(); type)
+        tp.set_type(*type);
+    if (auto name = r.read_optional_string(); name)
+        tp.set_name(*name);
+    if (auto default_value = r.read_optional_string(); default_value)
+        tp.set_default_value(*default_value);
+    tp.set_kind(kind);
+    tp.is_template_parameter(r.read_bool());
+    tp.is_template_template_parameter(r.read_bool());
+    tp.is_ellipsis(r.read_bool());
+    tp.is_variadic(r.read_bool());
+    tp.is_function_template(r.read_bool());
+    tp.is_data_pointer(r.read_bool());
+    tp.is_member_pointer(r.read_bool());
+    tp.is_array(r.read_bool());
+    tp.set_unexposed(r.read_bool());
+
+    std::deque<context> deduced_context;
+    const auto context_count = r.read_uint();
+    for (auto i = 0U; i < context_count; i++) {
+        context c;
+        c.is_const = r.read_bool();
+        c.is_volatile = r.read_bool();
+        c.is_ref_const = r.read_bool();
+        c.is_ref_volatile = r.read_bool();
+        c.pr = r.read_enum<rpqualifier>();
+        deduced_context.emplace_back(c);
+    }
+    tp.deduced_context(std::move(deduced_context));
+
+    if (auto constraint = r.read_optional_string(); constraint)
+        tp.set_concept_constraint(std::move(*constraint));
+
+    if (r.read_bool())
+        tp.set_id(r.read_id());
+
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        tp.add_template_param(read_template_parameter(r));
+
+    return tp;
+}
+
+void write_template_trait(binary_writer &w, const template_trait &t)
+{
+    w.write_uint(t.template_params().size());
+    for (const auto &tp : t.template_params())
+        write_template_parameter(w, tp);
+}
+
+void read_template_trait(binary_reader &r, template_trait &t)
+{
+    const auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        t.add_template(read_template_parameter(r));
+}
+
+void write_template_element(binary_writer &w, const template_element &e)
+{
+    write_element(w, e);
+    write_template_trait(w, e);
+    w.write_bool(e.is_template());
+    w.write_bool(e.template_specialization_found());
+}
+
+void read_template_element(binary_reader &r, template_element &e)
+{
+    read_element(r, e);
+    read_template_trait(r, e);
+    e.is_template(r.read_bool());
+    e.template_specialization_found(r.read_bool());
+}
+
+void write_package(binary_writer &w, const package &p)
+{
+    write_path(w, p.using_namespace());
+    w.write_enum(p.get_namespace().type());
+    write_element(w, p);
+    write_stylable_element(w, p);
+    w.write_bool(p.is_deprecated());
+    w.write_bool(p.is_root());
+}
+
+std::unique_ptr<package> read_package(binary_reader &r)
+{
+    auto using_namespace = read_path(r);
+    const auto pt = r.read_enum<path_type>();
+
+    auto p = std::make_unique<package>(using_namespace, pt);
+    read_element(r, *p);
+    read_stylable_element(r, *p);
+    p->set_deprecated(r.read_bool());
+    p->is_root(r.read_bool());
+
+    return p;
+}
+
+void merge_relationships(const diagram_element &from, diagram_element &to)
+{
+    for (const auto &rel : from.relationships()) {
+        if (!util::contains(to.relationships(), rel))
+            to.relationships().emplace_back(rel);
+    }
+}
+
+} // namespace clanguml::common::model
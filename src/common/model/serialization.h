@@ -0,0 +1,292 @@
+/**
+ * @file src/common/model/serialization.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/decorated_element.h"
+#include "common/model/diagram_element.h"
+#include "common/model/element.h"
+#include "common/model/enums.h"
+#include "common/model/package.h"
+#include "common/model/path.h"
+#include "common/model/relationship.h"
+#include "common/model/source_location.h"
+#include "common/model/stylable_element.h"
+#include "common/model/template_element.h"
+#include "common/model/template_parameter.h"
+#include "common/model/template_trait.h"
+#include "common/types.h"
+#include "util/error.h"
+#include "util/mapped_file.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clanguml::common::model {
+
+/**
+ * Magic bytes at the beginning of serialized model files.
+ */
+constexpr std::string_view kModelFormatMagic{"CUML"};
+
+/**
+ * Version of the serialized model format. It has to be incremented on each
+ * change of the serialized layout of any of the diagram models.
+ */
+constexpr std::uint64_t kModelFormatVersion{1};
+
+/**
+ * @brief Writes diagram models in a compact binary format.
+ *
+ * Unsigned integers and enums are stored as variable length integers.
+ *
+ * Strings and global element ids are interned - the first occurrence is
+ * written in place and appended to the table of the stream, each next
+ * occurrence is written as a variable length index into that table. Ids
+ * are written in place in fixed 8 bytes, as global ids are hashes which
+ * would not benefit from variable length encoding.
+ *
+ * The tables are built while writing, so the stream can only be read
+ * sequentially from the beginning.
+ */
+class binary_writer {
+public:
+    void write_bool(bool v);
+
+    void write_uint(std::uint64_t v);
+
+    void write_id(const eid_t &id);
+
+    void write_string(std::string_view s);
+
+    void write_optional_string(const std::optional<std::string> &s);
+
+    void write_strings(const std::vector<std::string> &s);
+
+    template <typename T> void write_enum(T v)
+    {
+        write_uint(static_cast<std::uint64_t>(v));
+    }
+
+    /**
+     * @brief Write raw bytes without any length prefix.
+     *
+     * @param bytes Bytes to write
+     */
+    void write_bytes(std::string_view bytes);
+
+    /**
+     * @brief Get the serialized data.
+     *
+     * @return Serialized data
+     */
+    const std::string &buffer() const;
+
+    /**
+     * @brief Move out the serialized data, leaving the writer empty.
+     *
+     * @return Serialized data
+     */
+    std::string release();
+
+private:
+    std::string buffer_;
+    std::deque<std::string> string_storage_;
+    std::unordered_map<std::string_view, std::uint64_t> strings_;
+    std::unordered_map<std::uint64_t, std::uint64_t> ids_;
+};
+
+/**
+ * @brief Reads diagram models written by @ref binary_writer.
+ *
+ * The reader does not own the buffer, which has to outlive the reader
+ * and any string views returned by it. All methods throw
+ * @ref clanguml::error::model_serialization_error if the buffer is
+ * truncated or malformed.
+ */
+class binary_reader {
+public:
+    explicit binary_reader(std::string_view buffer);
+
+    bool read_bool();
+
+    std::uint64_t read_uint();
+
+    eid_t read_id();
+
+    std::string read_string();
+
+    /**
+     * @brief Read string without copying it out of the buffer.
+     *
+     * @return View of the string in the buffer
+     */
+    std::string_view read_string_view();
+
+    std::optional<std::string> read_optional_string();
+
+    std::vector<std::string> read_strings();
+
+    template <typename T> T read_enum() { return static_cast<T>(read_uint()); }
+
+    std::string_view read_bytes(std::size_t size);
+
+    /**
+     * @brief Whether the entire buffer has been read.
+     *
+     * @return True, if there is no more data in the buffer
+     */
+    bool at_end() const;
+
+private:
+    std::string_view take(std::size_t size);
+
+    std::string_view buffer_;
+    std::size_t offset_{0};
+    std::vector<std::string_view> strings_;
+    std::vector<eid_t> ids_;
+};
+
+/**
+ * @brief Write the header of a serialized model file.
+ *
+ * @param w Binary writer
+ * @param type Type of the serialized diagram
+ */
+void write_header(binary_writer &w, diagram_t type);
+
+/**
+ * @brief Read and validate the header of a serialized model file.
+ *
+ * @param r Binary reader
+ * @return Type of the serialized diagram
+ */
+diagram_t read_header(binary_reader &r);
+
+void write_path(binary_writer &w, const path &p);
+path read_path(binary_reader &r);
+
+void write_source_location(binary_writer &w, const source_location &sl);
+void read_source_location(binary_reader &r, source_location &sl);
+
+void write_decorators(binary_writer &w,
+    const std::vector<std::shared_ptr<decorators::decorator>> &decorators);
+std::vector<std::shared_ptr<decorators::decorator>> read_decorators(
+    binary_reader &r);
+
+void write_comment(binary_writer &w, const std::optional<comment_t> &c);
+std::optional<comment_t> read_comment(binary_reader &r);
+
+void write_decorated_element(binary_writer &w, const decorated_element &e);
+void read_decorated_element(binary_reader &r, decorated_element &e);
+
+void write_stylable_element(binary_writer &w, const stylable_element &e);
+void read_stylable_element(binary_reader &r, stylable_element &e);
+
+void write_relationship(binary_writer &w, const relationship &rel);
+relationship read_relationship(binary_reader &r);
+
+/**
+ * @brief Write the diagram element along with its relationships.
+ */
+void write_diagram_element(binary_writer &w, const diagram_element &e);
+void read_diagram_element(binary_reader &r, diagram_element &e);
+
+/**
+ * @brief Write the element, except for its `using_namespace`, which
+ *        has to be written separately as it is a constructor argument.
+ */
+void write_element(binary_writer &w, const element &e);
+void read_element(binary_reader &r, element &e);
+
+void write_template_parameter(binary_writer &w, const template_parameter &tp);
+template_parameter read_template_parameter(binary_reader &r);
+
+void write_template_trait(binary_writer &w, const template_trait &t);
+void read_template_trait(binary_reader &r, template_trait &t);
+
+void write_template_element(binary_writer &w, const template_element &e);
+void read_template_element(binary_reader &r, template_element &e);
+
+/**
+ * @brief Write the package, including its constructor arguments.
+ */
+void write_package(binary_writer &w, const package &p);
+std::unique_ptr<package> read_package(binary_reader &r);
+
+/**
+ * @brief Add relationships of a duplicate element to the element already
+ *        present in the model, skipping the ones it already has.
+ *
+ * @param from Element read from a partial model
+ * @param to Element already in the model
+ */
+void merge_relationships(const diagram_element &from, diagram_element &to);
+
+/**
+ * @brief Save diagram model to a file.
+ *
+ * The diagram type specific `serialize()` overload is found using ADL.
+ *
+ * @tparam DiagramT Type of diagram model
+ * @param d Diagram model
+ * @param path Path to the output file
+ */
+template <typename DiagramT>
+void save_model(const DiagramT &d, const std::filesystem::path &path)
+{
+    binary_writer w;
+    write_header(w, d.type());
+    serialize(d, w);
+
+    util::write_file_atomically(path, w.buffer());
+}
+
+/**
+ * @brief Load diagram model from a file saved with @ref save_model.
+ *
+ * The file is memory mapped and merged into `d` using the diagram type
+ * specific `deserialize()` overload, found using ADL.
+ *
+ * @tparam DiagramT Type of diagram model
+ * @param path Path to the model file
+ * @param d Diagram model to load the model into
+ */
+template <typename DiagramT>
+void load_model(const std::filesystem::path &path, DiagramT &d)
+{
+    const util::mapped_file file{path};
+    binary_reader r{file.data()};
+
+    if (const auto type = read_header(r); type != d.type())
+        throw error::model_serialization_error(
+            fmt::format("Model file {} contains {} diagram - expected {}",
+                path.string(), to_string(type), to_string(d.type())));
+
+    deserialize(r, d);
+}
+
+} // namespace clanguml::common::model
@@ -103,6 +103,13 @@ public:
      */
     bool is_absolute() const { return is_absolute_; }
 
+    /**
+     * Set whether the elements path is absolute.
+     *
+     * @param absolute True if the elements path is absolute.
+     */
+    void set_absolute(bool absolute) { is_absolute_ = absolute; }
+
     /**
      * Set the type of the source file.
      *
@@ -17,3 +17,60 @@
  */
 
 #include "source_location.h"
+
+#include <mutex>
+
+namespace clanguml::common::model {
+
+file_path_table::file_path_table()
+{
+    paths_.emplace_back();
+    ids_.emplace(paths_.front(), kEmpty);
+}
+
+file_path_table &file_path_table::instance()
+{
+    static file_path_table table;
+    return table;
+}
+
+file_path_table::id_t file_path_table::intern(std::string_view path)
+{
+    if (path.empty())
+        return kEmpty;
+
+    {
+        std::shared_lock<std::shared_mutex> l(mutex_);
+        auto it = ids_.find(path);
+        if (it != ids_.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    auto it = ids_.find(path);
+    if (it != ids_.end())
+        return it->second;
+
+    const auto id = static_cast<id_t>(paths_.size());
+    const auto &p = paths_.emplace_back(path);
+    ids_.emplace(p, id);
+
+    return id;
+}
+
+const std::string &file_path_table::path(id_t id) const
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    return paths_.at(id);
+}
+
+std::size_t file_path_table::size() const
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    return paths_.size();
+}
+
+} // namespace clanguml::common::model
@@ -17,11 +17,68 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace clanguml::common::model {
 
+/**
+ * @brief Table of source file paths shared by all diagram models.
+ *
+ * Diagrams usually refer to a small number of distinct files from a very
+ * large number of elements, so source locations store only small ids of
+ * paths in this table. Paths are never removed from the table during a run,
+ * and references to them remain valid. The table can be accessed
+ * concurrently from multiple threads.
+ */
+class file_path_table {
+public:
+    using id_t = std::uint32_t;
+
+    /** Id of an empty path */
+    static constexpr id_t kEmpty{0};
+
+    /**
+     * @brief Get the global file path table instance.
+     *
+     * @return Reference to the file path table
+     */
+    static file_path_table &instance();
+
+    /**
+     * @brief Get the id of a path, adding it to the table if necessary.
+     *
+     * @param path File path
+     * @return Id of the path
+     */
+    id_t intern(std::string_view path);
+
+    /**
+     * @brief Get the path with a specific id.
+     *
+     * @param id Id of the path
+     * @return Reference to the path
+     */
+    const std::string &path(id_t id) const;
+
+    /**
+     * @brief Number of paths in the table, including the empty path
+     */
+    std::size_t size() const;
+
+private:
+    file_path_table();
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> paths_;
+    std::unordered_map<std::string_view, id_t> ids_;
+};
+
 /**
  * @brief Base class of all diagram elements that have source location.
  *
@@ -31,8 +88,8 @@ class source_location {
 public:
     source_location() = default;
 
-    source_location(std::string f, unsigned int l)
-        : file_{std::move(f)}
+    source_location(const std::string &f, unsigned int l)
+        : file_{file_path_table::instance().intern(f)}
         , line_{l}
     {
     }
@@ -42,35 +99,50 @@ public:
      *
      * @return Absolute file path.
      */
-    const std::string &file() const { return file_; }
+    const std::string &file() const
+    {
+        return file_path_table::instance().path(file_);
+    }
 
     /**
      * Set absolute file path.
      *
      * @param file Absolute file path.
      */
-    void set_file(const std::string &file) { file_ = file; }
+    void set_file(const std::string &file)
+    {
+        file_ = file_path_table::instance().intern(file);
+    }
 
     /**
      * Return source file path relative to `relative_to` config option.
      *
      * @return Relative file path.
      */
-    const std::string &file_relative() const { return file_relative_; }
+    const std::string &file_relative() const
+    {
+        return file_path_table::instance().path(file_relative_);
+    }
 
     /**
      * Set relative file path.
      *
      * @param file Relative file path.
      */
-    void set_file_relative(const std::string &file) { file_relative_ = file; }
+    void set_file_relative(const std::string &file)
+    {
+        file_relative_ = file_path_table::instance().intern(file);
+    }
 
     /**
      * Get the translation unit, from which this source location was visited.
      *
      * @return Path to the translation unit.
      */
-    const std::string &translation_unit() const { return translation_unit_; }
+    const std::string &translation_unit() const
+    {
+        return file_path_table::instance().path(translation_unit_);
+    }
 
     /**
      * Set the path to translation unit, from which this source location was
@@ -80,7 +152,56 @@ public:
      */
     void set_translation_unit(const std::string &translation_unit)
     {
-        translation_unit_ = translation_unit;
+        translation_unit_ =
+            file_path_table::instance().intern(translation_unit);
+    }
+
+    /**
+     * Get the id of the absolute file path in the file path table.
+     *
+     * @return Absolute file path id.
+     */
+    file_path_table::id_t file_id() const { return file_; }
+
+    /**
+     * Set the id of the absolute file path in the file path table.
+     *
+     * @param id Absolute file path id.
+     */
+    void set_file_id(file_path_table::id_t id) { file_ = id; }
+
+    /**
+     * Get the id of the relative file path in the file path table.
+     *
+     * @return Relative file path id.
+     */
+    file_path_table::id_t file_relative_id() const { return file_relative_; }
+
+    /**
+     * Set the id of the relative file path in the file path table.
+     *
+     * @param id Relative file path id.
+     */
+    void set_file_relative_id(file_path_table::id_t id) { file_relative_ = id; }
+
+    /**
+     * Get the id of the translation unit path in the file path table.
+     *
+     * @return Translation unit path id.
+     */
+    file_path_table::id_t translation_unit_id() const
+    {
+        return translation_unit_;
+    }
+
+    /**
+     * Set the id of the translation unit path in the file path table.
+     *
+     * @param id Translation unit path id.
+     */
+    void set_translation_unit_id(file_path_table::id_t id)
+    {
+        translation_unit_ = id;
     }
 
     /**
@@ -130,9 +251,9 @@ public:
     void set_location_id(unsigned int h) { hash_ = h; }
 
 private:
-    std::string file_;
-    std::string file_relative_;
-    std::string translation_unit_;
+    file_path_table::id_t file_{file_path_table::kEmpty};
+    file_path_table::id_t file_relative_{file_path_table::kEmpty};
+    file_path_table::id_t translation_unit_{file_path_table::kEmpty};
     unsigned int line_{0};
     unsigned int column_{0};
     unsigned int hash_{0};
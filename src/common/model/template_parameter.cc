@@ -19,11 +19,19 @@
 #include "template_parameter.h"
 #include "common/model/enums.h"
 #include <common/model/namespace.h>
+#include <util/memoized.h>
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
 #include <utility>
 
 namespace clanguml::common::model {
 
+namespace {
+constexpr auto kInternPoolSweepThreshold{1024U};
+} // namespace
+
 std::string context::to_string() const
 {
     std::vector<std::string> cv_qualifiers;
@@ -79,6 +87,35 @@ std::string to_string(template_parameter_kind_t k)
     }
 }
 
+template_parameter::template_parameter()
+    : data_{std::make_shared<node>()}
+{
+}
+
+const template_parameter::node &template_parameter::data() const
+{
+    // Moved-from template parameters have no node
+    static const node empty_node;
+
+    return data_ ? *data_ : empty_node;
+}
+
+template_parameter::node &template_parameter::mutable_data()
+{
+    if (!data_)
+        data_ = std::make_shared<node>();
+    else if (data_->is_interned_ || data_.use_count() > 1) {
+        data_ = std::make_shared<node>(*data_);
+        data_->is_interned_ = false;
+        data_->pool_id_ = 0;
+        data_->hash_ = 0;
+    }
+
+    data_->to_string_cache_.reset();
+
+    return *data_;
+}
+
 template_parameter template_parameter::make_empty()
 {
     template_parameter p;
@@ -164,76 +201,88 @@ bool template_parameter::is_same_specialization(
 
 void template_parameter::set_type(const std::string &type)
 {
-    assert(kind_ != template_parameter_kind_t::template_type);
+    auto &d = mutable_data();
+
+    assert(d.kind_ != template_parameter_kind_t::template_type);
 
     if (util::ends_with(type, std::string{"..."})) {
-        type_ = type.substr(0, type.size() - 3);
-        is_variadic_ = true;
+        d.type_ = type.substr(0, type.size() - 3);
+        d.is_variadic_ = true;
     }
     else
-        type_ = type;
+        d.type_ = type;
 }
 
 std::optional<std::string> template_parameter::type() const
 {
-    if (!type_)
+    const auto &d = data();
+
+    if (!d.type_)
         return {};
 
-    if (is_variadic_)
-        return type_.value() + "...";
+    if (d.is_variadic_)
+        return d.type_.value() + "...";
 
-    return type_;
+    return d.type_;
 }
 
 void template_parameter::set_name(const std::string &name)
 {
-    assert(kind_ != template_parameter_kind_t::argument);
+    assert(data().kind_ != template_parameter_kind_t::argument);
 
     if (name.empty()) {
         return;
     }
 
+    auto &d = mutable_data();
+
     if (util::ends_with(name, std::string{"..."})) {
-        name_ = name.substr(0, name.size() - 3);
-        is_variadic_ = true;
+        d.name_ = name.substr(0, name.size() - 3);
+        d.is_variadic_ = true;
     }
     else
-        name_ = name;
+        d.name_ = name;
 }
 
 std::optional<std::string> template_parameter::name() const
 {
-    if (!name_)
+    const auto &d = data();
+
+    if (!d.name_)
         return {};
 
-    if (kind_ == template_parameter_kind_t::template_type &&
-        name_.has_value() && name_.value().empty())
+    if (d.kind_ == template_parameter_kind_t::template_type &&
+        d.name_.has_value() && d.name_.value().empty())
         return "typename";
 
-    if (is_variadic_ && (kind_ != template_parameter_kind_t::non_type_template))
-        return name_.value() + "...";
+    if (d.is_variadic_ &&
+        (d.kind_ != template_parameter_kind_t::non_type_template))
+        return d.name_.value() + "...";
 
-    return name_;
+    return d.name_;
 }
 
 void template_parameter::set_default_value(const std::string &value)
 {
-    assert(kind_ != template_parameter_kind_t::argument);
+    assert(data().kind_ != template_parameter_kind_t::argument);
 
-    default_value_ = value;
+    mutable_data().default_value_ = value;
 }
 
 const std::optional<std::string> &template_parameter::default_value() const
 {
-    return default_value_;
+    return data().default_value_;
 }
 
 void template_parameter::is_variadic(bool is_variadic) noexcept
 {
-    is_variadic_ = is_variadic;
+    mutable_data().is_variadic_ = is_variadic;
 }
 
-bool template_parameter::is_variadic() const noexcept { return is_variadic_; }
+bool template_parameter::is_variadic() const noexcept
+{
+    return data().is_variadic_;
+}
 
 int template_parameter::calculate_specialization_match(
     const template_parameter &base_template_parameter) const
@@ -327,18 +376,19 @@ int template_parameter::calculate_specialization_match(
 
 void template_parameter::add_template_param(template_parameter &&ct)
 {
-    template_params_.emplace_back(std::move(ct));
+    ct.intern();
+    mutable_data().template_params_.emplace_back(std::move(ct));
 }
 
 void template_parameter::add_template_param(const template_parameter &ct)
 {
-    template_params_.push_back(ct);
+    add_template_param(template_parameter{ct});
 }
 
 const std::vector<template_parameter> &
 template_parameter::template_params() const
 {
-    return template_params_;
+    return data().template_params_;
 }
 
 std::string template_parameter::deduced_context_str() const
@@ -355,6 +405,37 @@ std::string template_parameter::deduced_context_str() const
 std::string template_parameter::to_string(
     const clanguml::common::model::namespace_ &using_namespace, bool relative,
     bool skip_qualifiers) const
+{
+    const auto &d = data();
+
+    if (!d.is_interned_)
+        return render(using_namespace, relative, skip_qualifiers);
+
+    // Interned nodes can be shared by models read from multiple threads,
+    // so the cache entries are only accessed under a lock
+    auto &entry = d.to_string_cache_->at(
+        (relative ? 2U : 0U) + (skip_qualifiers ? 1U : 0U));
+    auto &mutex = util::detail::memoization_mutex(&entry);
+
+    {
+        std::lock_guard<std::mutex> l{mutex};
+
+        // Non-relative rendering does not depend on the using namespace
+        if (entry && (!relative || entry->first == using_namespace))
+            return entry->second;
+    }
+
+    auto result = render(using_namespace, relative, skip_qualifiers);
+
+    std::lock_guard<std::mutex> l{mutex};
+    entry.emplace(relative ? using_namespace : namespace_{}, result);
+
+    return result;
+}
+
+std::string template_parameter::render(
+    const clanguml::common::model::namespace_ &using_namespace, bool relative,
+    bool skip_qualifiers) const
 {
     if (kind() == template_parameter_kind_t::empty) {
         return "";
@@ -368,12 +449,12 @@ std::string template_parameter::to_string(
     assert(!(type().has_value() && concept_constraint().has_value()));
 
     if (is_array()) {
-        auto it = template_params_.begin();
+        auto it = template_params().begin();
         auto element_type = it->to_string(using_namespace, relative);
         std::advance(it, 1);
 
         std::vector<std::string> dimension_args;
-        for (; it != template_params_.end(); it++)
+        for (; it != template_params().end(); it++)
             dimension_args.push_back(it->to_string(using_namespace, relative));
 
         return fmt::format(
@@ -381,12 +462,12 @@ std::string template_parameter::to_string(
     }
 
     if (is_function_template()) {
-        auto it = template_params_.begin();
+        auto it = template_params().begin();
         auto return_type = it->to_string(using_namespace, relative);
         std::advance(it, 1);
 
         std::vector<std::string> function_args;
-        for (; it != template_params_.end(); it++)
+        for (; it != template_params().end(); it++)
             function_args.push_back(it->to_string(using_namespace, relative));
 
         return fmt::format(
@@ -466,10 +547,10 @@ std::string template_parameter::to_string(
     }
 
     // Render nested template params
-    if (!template_params_.empty()) {
+    if (!template_params().empty()) {
         std::vector<std::string> params;
-        params.reserve(template_params_.size());
-        for (const auto &template_param : template_params_) {
+        params.reserve(template_params().size());
+        for (const auto &template_param : template_params()) {
             params.push_back(
                 template_param.to_string(using_namespace, relative));
         }
@@ -550,35 +631,193 @@ bool template_parameter::find_nested_relationships(const clang::Decl *decl,
     return added_aggregation_relationship;
 }
 
+void template_parameter::set_id(const eid_t &id) { mutable_data().id_ = id; }
+
+const std::optional<eid_t> &template_parameter::id() const
+{
+    return data().id_;
+}
+
+void template_parameter::clear_params()
+{
+    if (!data().template_params_.empty())
+        mutable_data().template_params_.clear();
+}
+
+void template_parameter::intern()
+{
+    if (!data_ || data_->is_interned_)
+        return;
+
+    data_ = intern_node(std::move(data_));
+}
+
+bool template_parameter::is_interned() const
+{
+    return data_ && data_->is_interned_;
+}
+
+bool template_parameter::operator==(const template_parameter &rhs) const
+{
+    if (data_ == rhs.data_)
+        return true;
+
+    // Interned nodes are unique only within their pool, nodes interned by
+    // different threads have to be compared structurally
+    if (is_interned() && rhs.is_interned() &&
+        data_->pool_id_ == rhs.data_->pool_id_)
+        return false;
+
+    return data() == rhs.data();
+}
+
+bool template_parameter::operator!=(const template_parameter &rhs) const
+{
+    return !(*this == rhs);
+}
+
+std::shared_ptr<template_parameter::node> template_parameter::intern_node(
+    std::shared_ptr<node> n)
+{
+    // Nodes are kept in the pool only as long as they are referenced by
+    // any template parameter
+    thread_local std::unordered_multimap<std::size_t, std::weak_ptr<node>>
+        pool;
+    thread_local std::size_t sweep_threshold{kInternPoolSweepThreshold};
+
+    // Pools are identified by a counter, as the address of a pool can be
+    // reused by a thread started after its thread has finished
+    static std::atomic<std::uint64_t> next_pool_id{1};
+    thread_local const std::uint64_t pool_id{
+        next_pool_id.fetch_add(1, std::memory_order_relaxed)};
+
+    n->hash_ = n->calculate_hash();
+
+    auto [begin, end] = pool.equal_range(n->hash_);
+    for (auto it = begin; it != end; ++it) {
+        auto candidate = it->second.lock();
+        if (candidate && *candidate == *n)
+            return candidate;
+    }
+
+    n->is_interned_ = true;
+    n->pool_id_ = pool_id;
+    n->to_string_cache_ = std::make_shared<node::to_string_cache_t>();
+
+    if (pool.size() >= sweep_threshold) {
+        for (auto it = pool.begin(); it != pool.end();) {
+            if (it->second.expired())
+                it = pool.erase(it);
+            else
+                ++it;
+        }
+        sweep_threshold =
+            std::max(2 * pool.size(), std::size_t{kInternPoolSweepThreshold});
+    }
+
+    pool.emplace(n->hash_, n);
+
+    return n;
+}
+
+bool template_parameter::node::operator==(const node &rhs) const
+{
+    if (is_interned_ && rhs.is_interned_ && hash_ != rhs.hash_)
+        return false;
+
+    // Nested template parameters of interned nodes are also interned, so
+    // they are compared by identity if they come from the same pool
+    return kind_ == rhs.kind_ && type_ == rhs.type_ && name_ == rhs.name_ &&
+        default_value_ == rhs.default_value_ &&
+        is_template_parameter_ == rhs.is_template_parameter_ &&
+        is_template_template_parameter_ ==
+        rhs.is_template_template_parameter_ &&
+        is_ellipsis_ == rhs.is_ellipsis_ && is_variadic_ == rhs.is_variadic_ &&
+        is_function_template_ == rhs.is_function_template_ &&
+        is_data_pointer_ == rhs.is_data_pointer_ &&
+        is_member_pointer_ == rhs.is_member_pointer_ &&
+        is_array_ == rhs.is_array_ && context_ == rhs.context_ &&
+        concept_constraint_ == rhs.concept_constraint_ &&
+        template_params_ == rhs.template_params_ && id_ == rhs.id_ &&
+        is_unexposed_ == rhs.is_unexposed_;
+}
+
+std::size_t template_parameter::node::calculate_hash() const
+{
+    std::size_t seed{static_cast<std::size_t>(kind_)};
+
+    const auto combine = [&seed](std::size_t h) {
+        seed ^= h + 0x9e3779b9 + (seed << 6U) + (seed >> 2U); // NOLINT
+    };
+
+    const auto combine_optional = [&](const std::optional<std::string> &o) {
+        combine(o ? std::hash<std::string>{}(*o) : 0U);
+    };
+
+    combine_optional(type_);
+    combine_optional(name_);
+    combine_optional(default_value_);
+    combine_optional(concept_constraint_);
+
+    // NOLINTBEGIN(readability-implicit-bool-conversion)
+    combine(static_cast<std::size_t>(is_template_parameter_) |
+        static_cast<std::size_t>(is_template_template_parameter_) << 1U |
+        static_cast<std::size_t>(is_ellipsis_) << 2U |
+        static_cast<std::size_t>(is_variadic_) << 3U |
+        static_cast<std::size_t>(is_function_template_) << 4U |
+        static_cast<std::size_t>(is_data_pointer_) << 5U |
+        static_cast<std::size_t>(is_member_pointer_) << 6U |
+        static_cast<std::size_t>(is_array_) << 7U |
+        static_cast<std::size_t>(is_unexposed_) << 8U);
+    // NOLINTEND(readability-implicit-bool-conversion)
+
+    for (const auto &c : context_) {
+        combine(static_cast<std::size_t>(c.pr));
+        combine(static_cast<std::size_t>(c.is_const) |
+            static_cast<std::size_t>(c.is_volatile) << 1U |
+            static_cast<std::size_t>(c.is_ref_const) << 2U |
+            static_cast<std::size_t>(c.is_ref_volatile) << 3U);
+    }
+
+    for (const auto &tp : template_params_)
+        combine(tp.data().hash_);
+
+    if (id_)
+        combine(std::hash<eid_t::type>{}(id_->value()));
+
+    return seed;
+}
+
 bool template_parameter::is_template_parameter() const
 {
-    return is_template_parameter_;
+    return data().is_template_parameter_;
 }
 
 void template_parameter::is_template_parameter(bool is_template_parameter)
 {
-    is_template_parameter_ = is_template_parameter;
+    mutable_data().is_template_parameter_ = is_template_parameter;
 }
 
 bool template_parameter::is_template_template_parameter() const
 {
-    return is_template_template_parameter_;
+    return data().is_template_template_parameter_;
 }
 
 void template_parameter::is_template_template_parameter(
     bool is_template_template_parameter)
 {
-    is_template_template_parameter_ = is_template_template_parameter;
+    mutable_data().is_template_template_parameter_ =
+        is_template_template_parameter;
 }
 
 void template_parameter::set_concept_constraint(std::string constraint)
 {
-    concept_constraint_ = std::move(constraint);
+    mutable_data().concept_constraint_ = std::move(constraint);
 }
 
 const std::optional<std::string> &template_parameter::concept_constraint() const
 {
-    return concept_constraint_;
+    return data().concept_constraint_;
 }
 
 bool template_parameter::is_association() const
@@ -590,59 +829,74 @@ bool template_parameter::is_association() const
         });
 }
 
-template_parameter_kind_t template_parameter::kind() const { return kind_; }
+template_parameter_kind_t template_parameter::kind() const
+{
+    return data().kind_;
+}
 
 void template_parameter::set_kind(template_parameter_kind_t kind)
 {
-    kind_ = kind;
+    mutable_data().kind_ = kind;
 }
 
-bool template_parameter::is_unexposed() const { return is_unexposed_; }
+bool template_parameter::is_unexposed() const { return data().is_unexposed_; }
 
 void template_parameter::set_unexposed(bool unexposed)
 {
-    is_unexposed_ = unexposed;
+    mutable_data().is_unexposed_ = unexposed;
 }
 
 void template_parameter::is_function_template(bool ft)
 {
-    is_function_template_ = ft;
+    mutable_data().is_function_template_ = ft;
 }
 bool template_parameter::is_function_template() const
 {
-    return is_function_template_;
+    return data().is_function_template_;
 }
 
-void template_parameter::is_member_pointer(bool m) { is_member_pointer_ = m; }
+void template_parameter::is_member_pointer(bool m)
+{
+    mutable_data().is_member_pointer_ = m;
+}
 bool template_parameter::is_member_pointer() const
 {
-    return is_member_pointer_;
+    return data().is_member_pointer_;
 }
 
-void template_parameter::is_data_pointer(bool m) { is_data_pointer_ = m; }
-bool template_parameter::is_data_pointer() const { return is_data_pointer_; }
+void template_parameter::is_data_pointer(bool m)
+{
+    mutable_data().is_data_pointer_ = m;
+}
+bool template_parameter::is_data_pointer() const
+{
+    return data().is_data_pointer_;
+}
 
-void template_parameter::is_array(bool a) { is_array_ = a; }
-bool template_parameter::is_array() const { return is_array_; }
+void template_parameter::is_array(bool a) { mutable_data().is_array_ = a; }
+bool template_parameter::is_array() const { return data().is_array_; }
 
 void template_parameter::push_context(const context &q)
 {
-    context_.push_front(q);
+    mutable_data().context_.push_front(q);
 }
 
 const std::deque<context> &template_parameter::deduced_context() const
 {
-    return context_;
+    return data().context_;
 }
 
 void template_parameter::deduced_context(std::deque<context> c)
 {
-    context_ = std::move(c);
+    mutable_data().context_ = std::move(c);
 }
 
-void template_parameter::is_ellipsis(bool e) { is_ellipsis_ = e; }
+void template_parameter::is_ellipsis(bool e)
+{
+    mutable_data().is_ellipsis_ = e;
+}
 
-bool template_parameter::is_ellipsis() const { return is_ellipsis_; }
+bool template_parameter::is_ellipsis() const { return data().is_ellipsis_; }
 
 int calculate_template_params_specialization_match(
     const std::vector<template_parameter> &specialization_params,
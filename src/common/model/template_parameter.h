@@ -21,7 +21,10 @@
 #include "common/model/namespace.h"
 #include "common/types.h"
 
+#include <array>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -84,7 +87,15 @@ struct context {
  *
  * This class can represent both template parameter and template arguments,
  * including variadic parameters and instantiations with
- * nested templates
+ * nested templates.
+ *
+ * Instances are lightweight handles to shared, copy-on-write nodes. Nodes
+ * of template parameters added to template elements or as nested template
+ * parameters are hash-consed, i.e. structurally identical subtrees (e.g.
+ * `std::allocator<T>`) are stored only once and compared by identity.
+ * Nodes are interned in a pool of the thread which created them, so nodes
+ * interned by different threads are compared structurally. Interned nodes
+ * cache their `to_string()` results, also when read by multiple threads.
  */
 class template_parameter {
 public:
@@ -179,14 +190,14 @@ public:
      *
      * @param id Id of parameter
      */
-    void set_id(const eid_t &id) { id_ = id; }
+    void set_id(const eid_t &id);
 
     /**
      * Get id of the template parameter
      *
      * @return Id of the template parameter
      */
-    const std::optional<eid_t> &id() const { return id_; }
+    const std::optional<eid_t> &id() const;
 
     /**
      * Set the name of the template parameter
@@ -361,7 +372,7 @@ public:
     /**
      * Erase all nested template parameters.
      */
-    void clear_params() { template_params_.clear(); }
+    void clear_params();
 
     /**
      * Does the template parameters deduced context contain any references
@@ -485,14 +496,71 @@ public:
         const clanguml::common::model::namespace_ &using_namespace,
         bool relative, bool skip_qualifiers = false) const;
 
+    /**
+     * @brief Replace the node of this template parameter with its shared,
+     *        interned instance.
+     *
+     * After interning, any modification of the template parameter makes
+     * a private copy of its node, so that other template parameters sharing
+     * the node are not affected.
+     */
+    void intern();
+
+    /**
+     * Whether the node of this template parameter is interned.
+     *
+     * @return True, if the node is interned
+     */
+    bool is_interned() const;
+
+    /**
+     * @brief Compare template parameters including their nested template
+     *        parameters.
+     *
+     * Template parameters interned by the same thread are compared in
+     * constant time.
+     *
+     * @param rhs Other template parameter
+     * @return True, if both template parameters are identical
+     */
+    bool operator==(const template_parameter &rhs) const;
+    bool operator!=(const template_parameter &rhs) const;
+
 private:
+    struct node;
+
     /**
      * This class should be only constructed using builder methods.
      */
-    template_parameter() = default;
+    template_parameter();
 
     std::string deduced_context_str() const;
 
+    std::string render(
+        const clanguml::common::model::namespace_ &using_namespace,
+        bool relative, bool skip_qualifiers) const;
+
+    const node &data() const;
+
+    /**
+     * @brief Get the node for modification, copying it first if it is
+     *        shared with other template parameters.
+     */
+    node &mutable_data();
+
+    static std::shared_ptr<node> intern_node(std::shared_ptr<node> n);
+
+    std::shared_ptr<node> data_;
+};
+
+/**
+ * @brief Contents of a single template parameter node.
+ */
+struct template_parameter::node {
+    bool operator==(const node &rhs) const;
+
+    std::size_t calculate_hash() const;
+
     template_parameter_kind_t kind_{template_parameter_kind_t::template_type};
 
     /*! Represents the type of non-type template parameters e.g. 'int' or type
@@ -550,6 +618,22 @@ private:
     std::optional<eid_t> id_;
 
     bool is_unexposed_{false};
+
+    /*! Structural hash, calculated when the node is interned */
+    std::size_t hash_{0};
+
+    bool is_interned_{false};
+
+    /*! Id of the per-thread pool in which the node is interned */
+    std::uint64_t pool_id_{0};
+
+    /*! Results of to_string() calls on interned nodes, indexed by the
+     * relative and skip_qualifiers arguments. Created when the node is
+     * interned, entries are guarded by memoization mutexes.
+     */
+    using to_string_cache_t =
+        std::array<std::optional<std::pair<namespace_, std::string>>, 4>;
+    mutable std::shared_ptr<to_string_cache_t> to_string_cache_;
 };
 
 /**
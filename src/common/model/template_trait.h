@@ -32,6 +32,13 @@ namespace clanguml::common::model {
  */
 class template_trait {
 public:
+    template_trait() = default;
+    template_trait(const template_trait &) = default;
+    template_trait(template_trait &&) noexcept = default;
+    template_trait &operator=(const template_trait &) = default;
+    template_trait &operator=(template_trait &&) noexcept = default;
+    virtual ~template_trait() = default;
+
     /**
      * Render the template parameters to a stream.
      *
@@ -68,6 +75,12 @@ public:
     int calculate_template_specialization_match(
         const template_trait &other) const;
 
+protected:
+    /**
+     * @brief Called whenever template parameters are modified.
+     */
+    virtual void on_template_params_changed() { }
+
 private:
     std::vector<template_parameter> templates_;
 };
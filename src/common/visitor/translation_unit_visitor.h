@@ -214,12 +214,15 @@ public:
      *
      * @param comment clang::RawComment pointer
      * @param de Reference to clang::DiagnosticsEngine
+     * @tparam DecoratedElement Type of element providing `add_decorators()`,
+     *         e.g. `decorated_element` or sequence diagram `message`
      * @param element Reference to element to be updated
      * @return Comment with uml directives stripped from it
      */
+    template <typename DecoratedElement>
     [[maybe_unused]] std::string process_comment(
         const clang::RawComment *comment, clang::DiagnosticsEngine &de,
-        clanguml::common::model::decorated_element &e)
+        DecoratedElement &e)
     {
         if (comment == nullptr)
             return {};
@@ -300,6 +300,8 @@ void inheritable_diagram_options::inherit(
     generate_method_argument_names.override(
         parent.generate_method_argument_names);
     fold_repeated_activities.override(parent.fold_repeated_activities);
+    analyze_reachable_only.override(parent.analyze_reachable_only);
+    use_definition_index.override(parent.use_definition_index);
     message_comment_width.override(parent.message_comment_width);
     message_name_width.override(parent.message_name_width);
     generate_concept_requirements.override(
@@ -631,6 +631,16 @@ struct inheritable_diagram_options {
      */
     option<std::filesystem::path> &get_relative_to() { return relative_to; }
 
+    /**
+     * @brief Get const reference to `relative_to` diagram config option
+     *
+     * @return Const reference to `relative_to` config option.
+     */
+    const option<std::filesystem::path> &get_relative_to() const
+    {
+        return relative_to;
+    }
+
     option<glob_t> glob{"glob"};
     option<common::model::namespace_> using_namespace{"using_namespace"};
     option<std::string> using_module{"using_module"};
@@ -681,6 +691,8 @@ struct inheritable_diagram_options {
     option<std::vector<std::string>> participants_order{"participants_order"};
     option<bool> generate_message_comments{"generate_message_comments", false};
     option<bool> fold_repeated_activities{"fold_repeated_activities", false};
+    option<bool> analyze_reachable_only{"analyze_reachable_only", false};
+    option<bool> use_definition_index{"use_definition_index", false};
     option<unsigned> message_comment_width{
         "message_comment_width", clanguml::util::kDefaultMessageCommentWidth};
     option<unsigned> message_name_width{
@@ -269,6 +269,8 @@ types:
         generate_condition_statements: !optional bool
         generate_message_comments: !optional bool
         fold_repeated_activities: !optional bool
+        analyze_reachable_only: !optional bool
+        use_definition_index: !optional bool
         message_comment_width: !optional int
         message_name_width: !optional int
         participants_order: !optional [string]
@@ -409,6 +411,8 @@ root:
     generate_condition_statements: !optional bool
     generate_message_comments: !optional bool
     fold_repeated_activities: !optional bool
+    analyze_reachable_only: !optional bool
+    use_definition_index: !optional bool
     message_comment_width: !optional int
     message_name_width: !optional int
     generate_packages: !optional bool
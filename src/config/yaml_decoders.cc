@@ -862,6 +862,8 @@ template <> struct convert<sequence_diagram> {
         get_option(node, rhs.generate_method_argument_names);
         get_option(node, rhs.generate_message_comments);
         get_option(node, rhs.fold_repeated_activities);
+        get_option(node, rhs.analyze_reachable_only);
+        get_option(node, rhs.use_definition_index);
         get_option(node, rhs.message_comment_width);
         get_option(node, rhs.message_name_width);
         get_option(node, rhs.type_aliases);
@@ -1072,6 +1074,8 @@ template <> struct convert<config> {
         get_option(node, rhs.generate_condition_statements);
         get_option(node, rhs.generate_message_comments);
         get_option(node, rhs.fold_repeated_activities);
+        get_option(node, rhs.analyze_reachable_only);
+        get_option(node, rhs.use_definition_index);
         get_option(node, rhs.message_comment_width);
         get_option(node, rhs.message_name_width);
         get_option(node, rhs.type_aliases);
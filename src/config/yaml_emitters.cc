@@ -462,6 +462,8 @@ YAML::Emitter &operator<<(
         out << c.participants_order;
         out << c.generate_message_comments;
         out << c.fold_repeated_activities;
+        out << c.analyze_reachable_only;
+        out << c.use_definition_index;
         out << c.message_comment_width;
         out << c.message_name_width;
     }
@@ -24,6 +24,40 @@
 
 namespace clanguml::include_diagram::model {
 
+std::size_t include_cache::file_uid_hash::operator()(
+    const file_uid_t &uid) const
+{
+    return std::hash<std::uint64_t>{}(uid.device) ^
+        (std::hash<std::uint64_t>{}(uid.file) << 1U);
+}
+
+std::size_t include_cache::edge_hash::operator()(
+    const std::pair<file_uid_t, file_uid_t> &edge) const
+{
+    return file_uid_hash{}(edge.first) ^ (file_uid_hash{}(edge.second) << 1U);
+}
+
+const std::optional<eid_t> *include_cache::find_source_file(
+    const file_uid_t &file) const
+{
+    if (auto it = source_files_.find(file); it != source_files_.end())
+        return &it->second;
+
+    return nullptr;
+}
+
+void include_cache::add_source_file(
+    const file_uid_t &file, std::optional<eid_t> id)
+{
+    source_files_.emplace(file, id);
+}
+
+bool include_cache::add_edge(
+    const file_uid_t &includer, const file_uid_t &includee)
+{
+    return edges_.emplace(includer, includee).second;
+}
+
 common::model::diagram_t diagram::type() const
 {
     return common::model::diagram_t::kInclude;
@@ -85,8 +119,10 @@ void diagram::add_file(std::unique_ptr<common::model::source_file> &&f)
 
     assert(p.type() == common::model::path_type::kFilesystem);
 
-    if (add_element(p, std::move(f)))
+    if (add_element(p, std::move(f))) {
         element_view<source_file>::add(ff);
+        files_by_id_.emplace(ff.id().value(), &ff);
+    }
 }
 
 const common::reference_vector<common::model::source_file> &
@@ -131,9 +167,14 @@ void diagram::apply_filter()
 
     element_view<source_file>::remove(to_remove);
 
+    for (const auto &id : to_remove)
+        files_by_id_.erase(id.value());
+
     nested_trait_fspath::remove(to_remove);
 }
 
+include_cache &diagram::includes() { return includes_; }
+
 bool diagram::is_empty() const { return element_view<source_file>::is_empty(); }
 
 } // namespace clanguml::include_diagram::model
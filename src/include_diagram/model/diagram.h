@@ -23,7 +23,12 @@
 #include "common/model/source_file.h"
 #include "common/types.h"
 
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace clanguml::include_diagram::model {
@@ -36,6 +41,70 @@ using clanguml::common::model::source_file;
 using nested_trait_fspath = clanguml::common::model::nested_trait<source_file,
     clanguml::common::model::filesystem_path>;
 
+/**
+ * @brief Cache of inclusion directives processed during a single run.
+ *
+ * Files are identified by their file system unique ids (i.e. device and
+ * inode), which are the same in all translation units. This allows
+ * translation units to skip include directives of headers which have been
+ * already processed by previous translation units.
+ */
+class include_cache {
+public:
+    /**
+     * File system unique id of a file.
+     */
+    struct file_uid_t {
+        std::uint64_t device{0};
+        std::uint64_t file{0};
+
+        bool operator==(const file_uid_t &right) const
+        {
+            return device == right.device && file == right.file;
+        }
+    };
+
+    /**
+     * @brief Find cached result of processing the includer file.
+     *
+     * @param file File system unique id of the includer
+     * @return Pointer to the diagram id of the file (empty if the file is
+     *         not included in the diagram), or nullptr if not cached yet
+     */
+    const std::optional<eid_t> *find_source_file(const file_uid_t &file) const;
+
+    /**
+     * @brief Cache result of processing the includer file.
+     *
+     * @param file File system unique id of the includer
+     * @param id Diagram id of the file, if it's included in the diagram
+     */
+    void add_source_file(const file_uid_t &file, std::optional<eid_t> id);
+
+    /**
+     * @brief Record include edge as processed.
+     *
+     * @param includer File system unique id of the includer
+     * @param includee File system unique id of the included file
+     * @return True, if the edge has not been processed before
+     */
+    bool add_edge(const file_uid_t &includer, const file_uid_t &includee);
+
+private:
+    struct file_uid_hash {
+        std::size_t operator()(const file_uid_t &uid) const;
+    };
+
+    struct edge_hash {
+        std::size_t operator()(
+            const std::pair<file_uid_t, file_uid_t> &edge) const;
+    };
+
+    std::unordered_map<file_uid_t, std::optional<eid_t>, file_uid_hash>
+        source_files_;
+    std::unordered_set<std::pair<file_uid_t, file_uid_t>, edge_hash> edges_;
+};
+
 /**
  * @brief Class representing an include diagram model.
  */
@@ -130,6 +199,17 @@ public:
     bool is_empty() const override;
 
     void apply_filter() override;
+
+    /**
+     * @brief Get the cache of inclusion directives processed in this run.
+     *
+     * @return Reference to the include cache
+     */
+    include_cache &includes();
+
+private:
+    std::unordered_map<eid_t::type, source_file *> files_by_id_;
+    include_cache includes_;
 };
 
 template <typename ElementT>
@@ -152,9 +232,15 @@ opt_ref<ElementT> diagram::find(const std::string &name) const
 
 template <typename ElementT> opt_ref<ElementT> diagram::find(eid_t id) const
 {
-    for (const auto &element : element_view<ElementT>::view()) {
-        if (element.get().id() == id) {
-            return {element};
+    if constexpr (std::is_same_v<ElementT, source_file>) {
+        if (auto it = files_by_id_.find(id.value()); it != files_by_id_.end())
+            return {*it->second};
+    }
+    else {
+        for (const auto &element : element_view<ElementT>::view()) {
+            if (element.get().id() == id) {
+                return {element};
+            }
         }
     }
 
@@ -0,0 +1,75 @@
+/**
+ * @file src/include_diagram/model/serialization.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization.h"
+
+#include <map>
+
+namespace clanguml::include_diagram::model {
+
+using common::model::binary_reader;
+using common::model::binary_writer;
+
+namespace {
+void write_files(binary_writer &w, const nested_trait_fspath &parent)
+{
+    for (const auto &f : parent) {
+        common::model::write_diagram_element(w, *f);
+        common::model::write_stylable_element(w, *f);
+        common::model::write_path(w, f->path());
+        w.write_enum(f->type());
+        w.write_bool(f->is_absolute());
+        w.write_bool(f->is_system_header());
+
+        write_files(w, *f);
+    }
+}
+} // namespace
+
+void serialize(const diagram &d, binary_writer &w) { write_files(w, d); }
+
+void deserialize(binary_reader &r, diagram &d)
+{
+    std::map<common::eid_t, source_file *> files;
+    for (const auto &f : d.files())
+        files.emplace(f.get().id(), &f.get());
+
+    while (!r.at_end()) {
+        auto f = std::make_unique<source_file>();
+        common::model::read_diagram_element(r, *f);
+        common::model::read_stylable_element(r, *f);
+        f->set_path(common::model::read_path(r));
+        f->set_type(r.read_enum<common::model::source_file_t>());
+        f->set_absolute(r.read_bool());
+        f->set_system_header(r.read_bool());
+
+        if (auto it = files.find(f->id()); it != files.end()) {
+            common::model::merge_relationships(*f, *it->second);
+            continue;
+        }
+
+        const auto *f_ptr = f.get();
+        d.add_file(std::move(f));
+
+        // The file is in the diagram only if it was added to its files view
+        if (!d.files().empty() && &d.files().back().get() == f_ptr)
+            files.emplace(f_ptr->id(), &d.files().back().get());
+    }
+}
+
+} // namespace clanguml::include_diagram::model
@@ -0,0 +1,48 @@
+/**
+ * @file src/include_diagram/model/serialization.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/serialization.h"
+#include "include_diagram/model/diagram.h"
+
+namespace clanguml::include_diagram::model {
+
+/**
+ * @brief Serialize the include diagram model.
+ *
+ * Files are written in the pre-order of the diagram's directory tree,
+ * so that directories are always written before their contents.
+ *
+ * @param d Include diagram model
+ * @param w Binary writer
+ */
+void serialize(const diagram &d, common::model::binary_writer &w);
+
+/**
+ * @brief Merge a serialized include diagram model into a diagram.
+ *
+ * Files which are already in the diagram are not replaced, only
+ * their relationships are extended with the relationships of the
+ * serialized file.
+ *
+ * @param r Binary reader
+ * @param d Include diagram model to merge the files into
+ */
+void deserialize(common::model::binary_reader &r, diagram &d);
+
+} // namespace clanguml::include_diagram::model
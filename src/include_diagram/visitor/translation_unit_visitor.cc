@@ -24,6 +24,14 @@
 
 namespace clanguml::include_diagram::visitor {
 
+namespace {
+model::include_cache::file_uid_t to_file_uid(const clang::FileEntry &file)
+{
+    const auto &uid = file.getUniqueID();
+    return {uid.getDevice(), uid.getFile()};
+}
+} // namespace
+
 translation_unit_visitor::translation_unit_visitor(
     clang::SourceManager & /*sm*/,
     clanguml::include_diagram::model::diagram &diagram,
@@ -79,19 +87,52 @@ void translation_unit_visitor::include_visitor::InclusionDirective(
     using common::model::source_file;
     using common::model::source_file_t;
 
+    const auto *includer_entry = source_manager().getFileEntryForID(
+        source_manager().getFileID(hash_loc));
+#if LLVM_VERSION_MAJOR > 14
+    const clang::FileEntry *includee_entry =
+        file.has_value() ? &file->getFileEntry() : nullptr;
+#else
+    const clang::FileEntry *includee_entry = file;
+#endif
+
+    // Each include edge results in the same diagram elements in all
+    // translation units, so process it only once per run
+    auto &cache = diagram().includes();
+    if (includer_entry != nullptr && includee_entry != nullptr &&
+        !cache.add_edge(
+            to_file_uid(*includer_entry), to_file_uid(*includee_entry))) {
+        return;
+    }
+
     // First process the file which contains the include directive
-    auto current_file =
-        std::filesystem::path{source_manager().getFilename(hash_loc).str()};
+    const auto current_file_name = source_manager().getFilename(hash_loc);
 
-    std::string file_name_str = file_name.str();
-    current_file = std::filesystem::absolute(current_file);
-    current_file = current_file.lexically_normal();
-    const auto current_dir = current_file.parent_path();
+    const std::optional<eid_t> *cached_file_id{nullptr};
+    if (includer_entry != nullptr)
+        cached_file_id = cache.find_source_file(to_file_uid(*includer_entry));
+
+    std::optional<eid_t> current_file_id;
+    if (cached_file_id != nullptr) {
+        current_file_id = *cached_file_id;
+    }
+    else {
+        const auto current_file =
+            std::filesystem::absolute(current_file_name.str())
+                .lexically_normal();
+
+        current_file_id = process_source_file(current_file);
+
+        if (includer_entry != nullptr)
+            cache.add_source_file(
+                to_file_uid(*includer_entry), current_file_id);
+    }
 
-    auto current_file_id = process_source_file(current_file);
     if (!current_file_id)
         return;
 
+    std::string file_name_str = file_name.str();
+
     assert(diagram().get(current_file_id.value()));
 
     // Now try to figure out the full path to the included header
@@ -132,7 +173,7 @@ void translation_unit_visitor::include_visitor::InclusionDirective(
     const auto root_directory = config().root_directory();
 
     LOG_DBG("Processing include directive {} [{}] in file {}", file_name_str,
-        real_include_path.string(), current_file.string());
+        real_include_path.string(), current_file_name.str());
 
     if (diagram().should_include(source_file{real_include_path})) {
         LOG_DBG("Processing internal header: {}", real_include_path.string());
@@ -61,6 +61,11 @@ int main(int argc, const char *argv[])
         });
 #endif
 
+        if (cli.from_model) {
+            return common::generators::generate_diagrams_from_models(
+                cli.diagram_names, cli.config, cli.get_runtime_config());
+        }
+
         const auto db =
             common::compilation_database::auto_detect_from_directory(
                 cli.config);
@@ -84,6 +89,12 @@ int main(int argc, const char *argv[])
             llvm::errs().close();
         }
 
+        if (cli.watch) {
+            return common::generators::watch_diagrams(cli.diagram_names,
+                cli.config, db, cli.get_runtime_config(),
+                translation_units_map);
+        }
+
         return common::generators::generate_diagrams(cli.diagram_names,
             cli.config, db, cli.get_runtime_config(), translation_units_map);
     }
@@ -0,0 +1,78 @@
+/**
+ * @file src/package_diagram/model/serialization.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization.h"
+
+#include <map>
+
+namespace clanguml::package_diagram::model {
+
+using common::model::binary_reader;
+using common::model::binary_writer;
+
+namespace {
+void write_packages(binary_writer &w, const nested_trait_ns &parent,
+    const common::model::path &parent_path)
+{
+    for (const auto &e : parent) {
+        const auto *p = dynamic_cast<const package *>(e.get());
+        if (p == nullptr)
+            continue;
+
+        common::model::write_path(w, parent_path);
+        common::model::write_package(w, *p);
+
+        common::model::path package_path{
+            parent_path.begin(), parent_path.end(), p->get_namespace().type()};
+        package_path |= p->name();
+
+        write_packages(w, *p, package_path);
+    }
+}
+} // namespace
+
+void serialize(const diagram &d, binary_writer &w)
+{
+    // Packages at the root of the diagram are added with an empty module
+    // path, which for all package types adds them directly to the root
+    write_packages(
+        w, d, common::model::path{common::model::path_type::kModule});
+}
+
+void deserialize(binary_reader &r, diagram &d)
+{
+    std::map<common::eid_t, package *> packages;
+    for (const auto &p : d.elements<package>())
+        packages.emplace(p.get().id(), &p.get());
+
+    while (!r.at_end()) {
+        const auto parent_path = common::model::read_path(r);
+        auto p = common::model::read_package(r);
+
+        if (auto it = packages.find(p->id()); it != packages.end()) {
+            common::model::merge_relationships(*p, *it->second);
+            continue;
+        }
+
+        auto *p_ptr = p.get();
+        if (d.add(parent_path, std::move(p)))
+            packages.emplace(p_ptr->id(), p_ptr);
+    }
+}
+
+} // namespace clanguml::package_diagram::model
@@ -0,0 +1,48 @@
+/**
+ * @file src/package_diagram/model/serialization.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/serialization.h"
+#include "package_diagram/model/diagram.h"
+
+namespace clanguml::package_diagram::model {
+
+/**
+ * @brief Serialize the package diagram model.
+ *
+ * Packages are written in the pre-order of the diagram's package tree,
+ * so that parent packages are always written before their children.
+ *
+ * @param d Package diagram model
+ * @param w Binary writer
+ */
+void serialize(const diagram &d, common::model::binary_writer &w);
+
+/**
+ * @brief Merge a serialized package diagram model into a diagram.
+ *
+ * Packages which are already in the diagram are not replaced, only
+ * their relationships are extended with the relationships of the
+ * serialized package.
+ *
+ * @param r Binary reader
+ * @param d Package diagram model to merge the packages into
+ */
+void deserialize(common::model::binary_reader &r, diagram &d);
+
+} // namespace clanguml::package_diagram::model
@@ -125,8 +125,7 @@ void generator::generate_call(const message &m, nlohmann::json &parent) const
 
     generate_to_activity(to, msg);
 
-    msg["source_location"] =
-        dynamic_cast<const clanguml::common::model::source_location &>(m);
+    msg["source_location"] = m.location();
 
     msg["scope"] = to_string(m.message_scope());
     msg["return_type"] = config().simplify_template_type(m.return_type());
@@ -380,8 +379,7 @@ void generator::process_return_message(const message &m) const
 
     generate_to_activity(to, msg);
 
-    msg["source_location"] =
-        dynamic_cast<const clanguml::common::model::source_location &>(m);
+    msg["source_location"] = m.location();
 
     msg["scope"] = to_string(m.message_scope());
     msg["return_type"] = config().simplify_template_type(m.return_type());
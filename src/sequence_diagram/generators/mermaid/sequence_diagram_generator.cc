@@ -151,7 +151,7 @@ void generator::generate_call(const message &m, std::ostream &ostr) const
     const std::string from_alias = generate_alias(from.value());
     const std::string to_alias = generate_alias(to.value());
 
-    print_debug(m, ostr);
+    print_debug(m.location(), ostr);
 
     generate_message_comment(ostr, m);
 
@@ -319,7 +319,7 @@ void generator::generate_activity(
             visited.pop_back();
         }
         else if (m.type() == message_t::kReturn) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -328,7 +328,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kCoReturn) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -337,7 +337,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kCoYield) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -346,7 +346,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kIf) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "alt";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -354,21 +354,21 @@ void generator::generate_activity(
             ostr << '\n';
         }
         else if (m.type() == message_t::kElseIf) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "else";
             if (const auto &text = m.condition_text(); text.has_value())
                 ostr << " " << render_message_text(text.value());
             ostr << '\n';
         }
         else if (m.type() == message_t::kElse) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "else\n";
         }
         else if (m.type() == message_t::kIfEnd) {
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kWhile) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -379,7 +379,7 @@ void generator::generate_activity(
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kFor) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -390,7 +390,7 @@ void generator::generate_activity(
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kDo) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -401,26 +401,26 @@ void generator::generate_activity(
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kTry) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "critical\n";
         }
         else if (m.type() == message_t::kCatch) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "option "
                  << render_message_name(m.message_name()) << '\n';
         }
         else if (m.type() == message_t::kTryEnd) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kSwitch) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "alt\n";
         }
         else if (m.type() == message_t::kCase) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "else "
                  << render_message_name(m.message_name()) << '\n';
         }
@@ -428,7 +428,7 @@ void generator::generate_activity(
             ostr << indent(1) << "end\n";
         }
         else if (m.type() == message_t::kConditional) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << indent(1) << "alt";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -436,7 +436,7 @@ void generator::generate_activity(
             ostr << '\n';
         }
         else if (m.type() == message_t::kConditionalElse) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << indent(1) << "else\n";
         }
         else if (m.type() == message_t::kConditionalEnd) {
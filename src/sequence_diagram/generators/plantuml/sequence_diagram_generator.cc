@@ -106,7 +106,7 @@ void generator::generate_call(const message &m, std::ostream &ostr) const
     const std::string from_alias = generate_alias(from.value());
     const std::string to_alias = generate_alias(to.value());
 
-    print_debug(m, ostr);
+    print_debug(m.location(), ostr);
 
     generate_message_comment(ostr, m);
 
@@ -116,7 +116,8 @@ void generator::generate_call(const message &m, std::ostream &ostr) const
     ostr << to_alias;
 
     if (config().generate_links) {
-        common_generator<diagram_config, diagram_model>::generate_link(ostr, m);
+        common_generator<diagram_config, diagram_model>::generate_link(
+            ostr, m.location());
     }
 
     ostr << " : ";
@@ -271,7 +272,7 @@ void generator::generate_activity(
             visited.pop_back();
         }
         else if (m.type() == message_t::kReturn) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -280,7 +281,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kCoReturn) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -289,7 +290,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kCoYield) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             auto return_message = m;
             if (!visited.empty()) {
@@ -298,7 +299,7 @@ void generator::generate_activity(
             generate_return(return_message, ostr);
         }
         else if (m.type() == message_t::kIf) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "alt";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -306,21 +307,21 @@ void generator::generate_activity(
             ostr << '\n';
         }
         else if (m.type() == message_t::kElseIf) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "else";
             if (const auto &text = m.condition_text(); text.has_value())
                 ostr << " " << text.value();
             ostr << '\n';
         }
         else if (m.type() == message_t::kElse) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "else\n";
         }
         else if (m.type() == message_t::kIfEnd) {
             ostr << "end\n";
         }
         else if (m.type() == message_t::kWhile) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -331,7 +332,7 @@ void generator::generate_activity(
             ostr << "end\n";
         }
         else if (m.type() == message_t::kFor) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -342,7 +343,7 @@ void generator::generate_activity(
             ostr << "end\n";
         }
         else if (m.type() == message_t::kDo) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "loop";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -353,32 +354,32 @@ void generator::generate_activity(
             ostr << "end\n";
         }
         else if (m.type() == message_t::kTry) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "group try\n";
         }
         else if (m.type() == message_t::kCatch) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "else " << render_message_name(m.message_name()) << '\n';
         }
         else if (m.type() == message_t::kTryEnd) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "end\n";
         }
         else if (m.type() == message_t::kSwitch) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "group switch\n";
         }
         else if (m.type() == message_t::kCase) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "else " << render_message_name(m.message_name()) << '\n';
         }
         else if (m.type() == message_t::kSwitchEnd) {
             ostr << "end\n";
         }
         else if (m.type() == message_t::kConditional) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             generate_message_comment(ostr, m);
             ostr << "alt";
             if (const auto &text = m.condition_text(); text.has_value())
@@ -386,7 +387,7 @@ void generator::generate_activity(
             ostr << '\n';
         }
         else if (m.type() == message_t::kConditionalElse) {
-            print_debug(m, ostr);
+            print_debug(m.location(), ostr);
             ostr << "else\n";
         }
         else if (m.type() == message_t::kConditionalEnd) {
@@ -0,0 +1,176 @@
+/**
+ * @file src/sequence_diagram/model/call_graph.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "call_graph.h"
+
+#include "util/util.h"
+
+#include <algorithm>
+
+namespace clanguml::sequence_diagram::model {
+
+namespace {
+bool is_name_in_location(const std::string &name, const std::string &location)
+{
+    auto pos = location.find(name);
+    while (pos != std::string::npos) {
+        const auto end = pos + name.size();
+        const bool starts_name =
+            pos == 0 || (pos >= 2 && location.substr(pos - 2, 2) == "::");
+        const bool ends_name = end < location.size() &&
+            (location[end] == '(' || location[end] == '<');
+
+        if (starts_name && ends_name)
+            return true;
+
+        pos = location.find(name, pos + 1);
+    }
+
+    return false;
+}
+} // namespace
+
+call_graph::node_id call_graph::to_id(const std::string &qualified_name)
+{
+    return util::stable_hash(qualified_name);
+}
+
+call_graph::node_id call_graph::add_function(const std::string &qualified_name)
+{
+    const auto id = to_id(qualified_name);
+
+    auto [it, inserted] = nodes_.try_emplace(id);
+    if (inserted) {
+        auto &n = it->second;
+        n.qualified_name = qualified_name;
+
+        const auto separator = qualified_name.rfind("::");
+        n.name = separator == std::string::npos
+            ? qualified_name
+            : qualified_name.substr(separator + 2);
+
+        nodes_by_name_[n.name].push_back(id);
+    }
+
+    return id;
+}
+
+void call_graph::add_call(node_id caller, node_id callee)
+{
+    nodes_[caller].callees.emplace(callee);
+}
+
+void call_graph::add_unresolved_call(
+    node_id caller, const std::string &callee_name)
+{
+    nodes_[caller].unresolved_callees.emplace(callee_name);
+}
+
+std::vector<call_graph::node_id> call_graph::find_functions(
+    const std::string &location) const
+{
+    std::vector<node_id> result;
+
+    for (const auto &[id, n] : nodes_) {
+        if (n.name.empty() || !is_name_in_location(n.name, location))
+            continue;
+
+        const auto namespaces = util::split(n.qualified_name, "::");
+
+        const bool all_enclosing_names_match = std::all_of(namespaces.begin(),
+            namespaces.end() - 1, [&location](const std::string &ns) {
+                return location.find(ns) != std::string::npos;
+            });
+
+        if (all_enclosing_names_match)
+            result.push_back(id);
+    }
+
+    return result;
+}
+
+std::vector<call_graph::node_id> call_graph::callees(const node &n) const
+{
+    std::vector<node_id> result{n.callees.begin(), n.callees.end()};
+
+    for (const auto &name : n.unresolved_callees) {
+        auto it = nodes_by_name_.find(name);
+        if (it != nodes_by_name_.end())
+            util::append(result, it->second);
+    }
+
+    return result;
+}
+
+std::unordered_set<call_graph::node_id> call_graph::callees_closure(
+    const std::vector<node_id> &from) const
+{
+    std::unordered_set<node_id> result{from.begin(), from.end()};
+    std::vector<node_id> queue{from};
+
+    while (!queue.empty()) {
+        const auto id = queue.back();
+        queue.pop_back();
+
+        auto it = nodes_.find(id);
+        if (it == nodes_.end())
+            continue;
+
+        for (const auto callee : callees(it->second)) {
+            if (result.emplace(callee).second)
+                queue.push_back(callee);
+        }
+    }
+
+    return result;
+}
+
+std::unordered_set<call_graph::node_id> call_graph::callers_closure(
+    const std::vector<node_id> &to) const
+{
+    std::unordered_map<node_id, std::vector<node_id>> callers;
+    for (const auto &[id, n] : nodes_) {
+        for (const auto callee : callees(n))
+            callers[callee].push_back(id);
+    }
+
+    std::unordered_set<node_id> result{to.begin(), to.end()};
+    std::vector<node_id> queue{to};
+
+    while (!queue.empty()) {
+        const auto id = queue.back();
+        queue.pop_back();
+
+        auto it = callers.find(id);
+        if (it == callers.end())
+            continue;
+
+        for (const auto caller : it->second) {
+            if (result.emplace(caller).second)
+                queue.push_back(caller);
+        }
+    }
+
+    return result;
+}
+
+bool call_graph::contains(node_id id) const { return nodes_.count(id) > 0; }
+
+std::size_t call_graph::size() const { return nodes_.size(); }
+
+} // namespace clanguml::sequence_diagram::model
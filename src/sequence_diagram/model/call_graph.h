@@ -0,0 +1,141 @@
+/**
+ * @file src/sequence_diagram/model/call_graph.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace clanguml::sequence_diagram::model {
+
+/**
+ * @brief Lightweight caller to callee graph of functions.
+ *
+ * The call graph is built in a cheap first pass over the translation units
+ * of a sequence diagram, to find which functions are reachable from the
+ * diagram's `from` and `to` conditions, so that detailed messages are only
+ * built for these functions.
+ *
+ * Functions are identified by their qualified names without template
+ * arguments and parameters, so overloads and template specializations
+ * share a single node. Calls which cannot be resolved to a declaration
+ * (e.g. in dependent contexts) are recorded by the callee name only, and
+ * are assumed to reach all functions with that name. This makes the
+ * reachable set an over-approximation of the functions actually present in
+ * the diagram.
+ */
+class call_graph {
+public:
+    using node_id = std::uint64_t;
+
+    /**
+     * @brief Get the stable id of a function with a qualified name.
+     *
+     * @param qualified_name Qualified function name without template
+     *                       arguments and parameters, e.g. `ns::A::foo`
+     * @return Node id
+     */
+    static node_id to_id(const std::string &qualified_name);
+
+    /**
+     * @brief Add a function to the graph.
+     *
+     * @param qualified_name Qualified function name
+     * @return Node id of the function
+     */
+    node_id add_function(const std::string &qualified_name);
+
+    /**
+     * @brief Record a call between two functions.
+     *
+     * @param caller Node id of the caller
+     * @param callee Node id of the callee
+     */
+    void add_call(node_id caller, node_id callee);
+
+    /**
+     * @brief Record a call, which could only be resolved to a function name.
+     *
+     * @param caller Node id of the caller
+     * @param callee_name Unqualified name of the callee
+     */
+    void add_unresolved_call(node_id caller, const std::string &callee_name);
+
+    /**
+     * @brief Find functions which can match a `function` location from
+     *        diagram config.
+     *
+     * A function matches the location, if its name is followed in the
+     * location by a parameter or template argument list, and all its
+     * enclosing namespace and class names occur in the location.
+     *
+     * @param location Function signature, e.g. `ns::A<int>::foo(int)`
+     * @return Matching node ids
+     */
+    std::vector<node_id> find_functions(const std::string &location) const;
+
+    /**
+     * @brief Get all functions reachable from the specified functions.
+     *
+     * @param from Node ids of the start functions
+     * @return Start functions and all their direct and indirect callees
+     */
+    std::unordered_set<node_id> callees_closure(
+        const std::vector<node_id> &from) const;
+
+    /**
+     * @brief Get all functions from which the specified functions are
+     *        reachable.
+     *
+     * @param to Node ids of the end functions
+     * @return End functions and all their direct and indirect callers
+     */
+    std::unordered_set<node_id> callers_closure(
+        const std::vector<node_id> &to) const;
+
+    /**
+     * @brief Check if the graph contains a function.
+     *
+     * @param id Node id
+     * @return True, if the function was added to the graph
+     */
+    bool contains(node_id id) const;
+
+    /**
+     * @brief Number of functions in the graph.
+     */
+    std::size_t size() const;
+
+private:
+    struct node {
+        std::string qualified_name;
+        std::string name;
+        std::set<node_id> callees;
+        std::set<std::string> unresolved_callees;
+    };
+
+    std::vector<node_id> callees(const node &n) const;
+
+    std::unordered_map<node_id, node> nodes_;
+    std::unordered_map<std::string, std::vector<node_id>> nodes_by_name_;
+};
+
+} // namespace clanguml::sequence_diagram::model
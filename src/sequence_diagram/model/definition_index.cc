@@ -0,0 +1,289 @@
+/**
+ * @file src/sequence_diagram/model/definition_index.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "definition_index.h"
+
+#include "util/logging.h"
+#include "util/util.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <iterator>
+
+namespace clanguml::sequence_diagram::model {
+
+std::filesystem::path definition_index::default_path(
+    const std::filesystem::path &compilation_database_dir)
+{
+    return compilation_database_dir / ".clang-uml-definitions.json";
+}
+
+std::uint64_t definition_index::file_hash(const std::filesystem::path &path)
+{
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs)
+        return 0;
+
+    const std::string contents{
+        std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+    return util::stable_hash(contents);
+}
+
+bool definition_index::load(const std::filesystem::path &path)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    translation_units_.clear();
+    definitions_.clear();
+    inline_definitions_.clear();
+    modified_ = false;
+
+    std::ifstream ifs{path};
+    if (!ifs)
+        return false;
+
+    try {
+        const auto j = nlohmann::json::parse(ifs);
+
+        if (j.at("version").get<unsigned>() != kVersion)
+            return false;
+
+        for (const auto &[tu, tu_json] : j.at("translation_units").items()) {
+            translation_unit_entry e;
+            e.dependencies = tu_json.at("dependencies")
+                                 .get<std::map<std::string, std::uint64_t>>();
+            e.definitions =
+                tu_json.at("definitions").get<std::vector<std::string>>();
+            e.inline_definitions = tu_json.at("inline_definitions")
+                                       .get<std::vector<std::string>>();
+
+            add_to_lookup(tu, e);
+            translation_units_.emplace(tu, std::move(e));
+        }
+    }
+    catch (const nlohmann::json::exception & /*e*/) {
+        translation_units_.clear();
+        definitions_.clear();
+        inline_definitions_.clear();
+
+        return false;
+    }
+
+    return true;
+}
+
+void definition_index::save(const std::filesystem::path &path) const
+{
+    nlohmann::json j;
+    j["version"] = kVersion;
+    j["translation_units"] = nlohmann::json::object();
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+
+        for (const auto &[tu, e] : translation_units_) {
+            auto &tu_json = j["translation_units"][tu];
+            tu_json["dependencies"] = e.dependencies;
+            tu_json["definitions"] = e.definitions;
+            tu_json["inline_definitions"] = e.inline_definitions;
+        }
+    }
+
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream ofs{tmp_path};
+        if (!ofs) {
+            LOG_WARN("Failed to write definition index {}", path.string());
+            return;
+        }
+
+        ofs << j.dump();
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        LOG_WARN("Failed to write definition index {}: {}", path.string(),
+            ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+std::uint64_t definition_index::cached_file_hash(const std::string &path) const
+{
+    std::error_code ec;
+    const auto last_write_time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return 0;
+
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return 0;
+
+    {
+        std::lock_guard<std::mutex> l(file_hashes_mutex_);
+
+        if (auto it = file_hashes_.find(path); it != file_hashes_.end() &&
+            it->second.last_write_time == last_write_time &&
+            it->second.size == size)
+            return it->second.hash;
+    }
+
+    const auto hash = file_hash(path);
+
+    std::lock_guard<std::mutex> l(file_hashes_mutex_);
+    file_hashes_[path] = {last_write_time, size, hash};
+
+    return hash;
+}
+
+std::vector<std::string> definition_index::stale_translation_units(
+    const std::vector<std::string> &translation_units) const
+{
+    // Copy the dependencies of indexed translation units, so that files can
+    // be hashed without blocking concurrent updates of the index
+    std::vector<std::optional<std::map<std::string, std::uint64_t>>>
+        dependencies;
+    dependencies.reserve(translation_units.size());
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+
+        for (const auto &tu : translation_units) {
+            auto it = translation_units_.find(tu);
+            if (it == translation_units_.end())
+                dependencies.emplace_back();
+            else
+                dependencies.emplace_back(it->second.dependencies);
+        }
+    }
+
+    std::vector<std::string> result;
+    std::unordered_map<std::string, std::uint64_t> hashes;
+
+    for (auto i = 0U; i < translation_units.size(); i++) {
+        if (!dependencies[i]) {
+            result.push_back(translation_units[i]);
+            continue;
+        }
+
+        for (const auto &[file, hash] : *dependencies[i]) {
+            auto hash_it = hashes.find(file);
+            if (hash_it == hashes.end())
+                hash_it = hashes.emplace(file, cached_file_hash(file)).first;
+
+            if (hash_it->second != hash) {
+                result.push_back(translation_units[i]);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+void definition_index::set_translation_unit(
+    const std::string &translation_unit, translation_unit_entry entry)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (auto it = translation_units_.find(translation_unit);
+        it != translation_units_.end()) {
+        remove_from_lookup(translation_unit, it->second);
+        translation_units_.erase(it);
+    }
+
+    add_to_lookup(translation_unit, entry);
+    translation_units_.emplace(translation_unit, std::move(entry));
+    modified_ = true;
+}
+
+std::set<std::string> definition_index::translation_units(
+    call_graph::node_id id) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto it = definitions_.find(id);
+    if (it == definitions_.end())
+        return {};
+
+    return it->second;
+}
+
+std::set<std::string> definition_index::inline_translation_units(
+    call_graph::node_id id) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto it = inline_definitions_.find(id);
+    if (it == inline_definitions_.end())
+        return {};
+
+    return it->second;
+}
+
+void definition_index::add_functions(call_graph &graph) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    for (const auto &[tu, e] : translation_units_) {
+        for (const auto &name : e.definitions)
+            graph.add_function(name);
+        for (const auto &name : e.inline_definitions)
+            graph.add_function(name);
+    }
+}
+
+std::size_t definition_index::size() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return translation_units_.size();
+}
+
+bool definition_index::modified() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return modified_;
+}
+
+void definition_index::add_to_lookup(
+    const std::string &translation_unit, const translation_unit_entry &e)
+{
+    for (const auto &name : e.definitions)
+        definitions_[call_graph::to_id(name)].emplace(translation_unit);
+
+    for (const auto &name : e.inline_definitions)
+        inline_definitions_[call_graph::to_id(name)].emplace(translation_unit);
+}
+
+void definition_index::remove_from_lookup(
+    const std::string &translation_unit, const translation_unit_entry &e)
+{
+    for (const auto &name : e.definitions)
+        definitions_[call_graph::to_id(name)].erase(translation_unit);
+
+    for (const auto &name : e.inline_definitions)
+        inline_definitions_[call_graph::to_id(name)].erase(translation_unit);
+}
+
+} // namespace clanguml::sequence_diagram::model
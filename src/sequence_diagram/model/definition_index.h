@@ -0,0 +1,199 @@
+/**
+ * @file src/sequence_diagram/model/definition_index.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "call_graph.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clanguml::sequence_diagram::model {
+
+/**
+ * @brief Persistent index of function definitions in translation units.
+ *
+ * The index maps functions (identified by their call graph names) to the
+ * translation units which define them, so that sequence diagrams can parse
+ * only translation units on the call closure of their start points.
+ *
+ * For each translation unit, the index stores content hashes of all files
+ * it depends on, which allows to refresh the index incrementally, only for
+ * translation units affected by changes in the sources.
+ *
+ * Translation units can be updated concurrently from multiple threads.
+ */
+class definition_index {
+public:
+    static constexpr auto kVersion{1U};
+
+    /**
+     * @brief Functions defined by a single translation unit.
+     */
+    struct translation_unit_entry {
+        /** Content hashes of the translation unit and all included files */
+        std::map<std::string, std::uint64_t> dependencies;
+        /** Functions defined in the translation unit source file */
+        std::vector<std::string> definitions;
+        /** Functions defined in files included by the translation unit */
+        std::vector<std::string> inline_definitions;
+    };
+
+    /**
+     * @brief Get the path of the index file for a compilation database.
+     *
+     * @param compilation_database_dir Directory of `compile_commands.json`
+     * @return Path to the index file
+     */
+    static std::filesystem::path default_path(
+        const std::filesystem::path &compilation_database_dir);
+
+    /**
+     * @brief Get the content hash of a file.
+     *
+     * @param path Path to the file
+     * @return Hash of the file contents or 0, if the file cannot be read
+     */
+    static std::uint64_t file_hash(const std::filesystem::path &path);
+
+    /**
+     * @brief Load the index from a file.
+     *
+     * Missing, invalid or incompatible index files result in an empty index.
+     *
+     * @param path Path to the index file
+     * @return True, if the index was loaded
+     */
+    bool load(const std::filesystem::path &path);
+
+    /**
+     * @brief Save the index to a file.
+     *
+     * The index is first written to a temporary file, which is then renamed,
+     * so that concurrent readers never see a partially written index.
+     *
+     * @param path Path to the index file
+     */
+    void save(const std::filesystem::path &path) const;
+
+    /**
+     * @brief Find translation units, which are not indexed or which
+     *        dependencies have changed since they were indexed.
+     *
+     * Files are hashed without holding the index lock, and their hashes are
+     * cached across calls until the file modification time or size changes,
+     * so that diagrams sharing the index do not rehash the same headers.
+     *
+     * @param translation_units Paths of translation units to check
+     * @return Paths of stale translation units
+     */
+    std::vector<std::string> stale_translation_units(
+        const std::vector<std::string> &translation_units) const;
+
+    /**
+     * @brief Add or replace the translation unit in the index.
+     *
+     * @param translation_unit Path of the translation unit
+     * @param entry Functions defined by the translation unit
+     */
+    void set_translation_unit(
+        const std::string &translation_unit, translation_unit_entry entry);
+
+    /**
+     * @brief Get translation units defining a function in their source file.
+     *
+     * @param id Call graph node id of the function
+     * @return Paths of translation units
+     */
+    std::set<std::string> translation_units(call_graph::node_id id) const;
+
+    /**
+     * @brief Get translation units including a definition of a function,
+     *        e.g. of an inline function defined in a header.
+     *
+     * @param id Call graph node id of the function
+     * @return Paths of translation units
+     */
+    std::set<std::string> inline_translation_units(
+        call_graph::node_id id) const;
+
+    /**
+     * @brief Add all indexed functions to a call graph.
+     *
+     * This allows to match diagram start points before any translation unit
+     * is parsed.
+     *
+     * @param graph Call graph
+     */
+    void add_functions(call_graph &graph) const;
+
+    /**
+     * @brief Number of indexed translation units.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Whether any translation unit has been added or replaced since
+     *        the index was loaded.
+     */
+    bool modified() const;
+
+private:
+    /**
+     * @brief Content hash of a file at the time it was last hashed.
+     */
+    struct file_hash_entry {
+        std::filesystem::file_time_type last_write_time;
+        std::uintmax_t size{0};
+        std::uint64_t hash{0};
+    };
+
+    /**
+     * @brief Get the content hash of a file, rehashing it only if it was
+     *        modified since it was last hashed.
+     *
+     * @param path Path to the file
+     * @return Hash of the file contents or 0, if the file cannot be read
+     */
+    std::uint64_t cached_file_hash(const std::string &path) const;
+
+    void add_to_lookup(
+        const std::string &translation_unit, const translation_unit_entry &e);
+
+    void remove_from_lookup(
+        const std::string &translation_unit, const translation_unit_entry &e);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, translation_unit_entry> translation_units_;
+    std::unordered_map<call_graph::node_id, std::set<std::string>>
+        definitions_;
+    std::unordered_map<call_graph::node_id, std::set<std::string>>
+        inline_definitions_;
+    bool modified_{false};
+
+    mutable std::mutex file_hashes_mutex_;
+    mutable std::unordered_map<std::string, file_hash_entry> file_hashes_;
+};
+
+} // namespace clanguml::sequence_diagram::model
@@ -24,6 +24,7 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 
 namespace clanguml::sequence_diagram::model {
 
@@ -433,6 +434,31 @@ bool diagram::is_empty() const
     return activities_.empty() || participants_.empty();
 }
 
+void diagram::set_reachable_functions(
+    std::unordered_set<call_graph::node_id> ids)
+{
+    reachable_functions_ = std::move(ids);
+}
+
+const std::optional<std::unordered_set<call_graph::node_id>> &
+diagram::reachable_functions() const
+{
+    return reachable_functions_;
+}
+
+bool diagram::should_analyze_function(call_graph::node_id id) const
+{
+    return !reachable_functions_ || reachable_functions_->count(id) > 0;
+}
+
+const std::string *diagram::intern(std::string str)
+{
+    if (str.empty())
+        return nullptr;
+
+    return &message_strings_->intern(std::move(str));
+}
+
 void diagram::inline_lambda_operator_calls()
 {
     using namespace std::string_literals;
@@ -732,7 +758,8 @@ void diagram::finalize()
                         get_participant<sequence_diagram::model::function>(
                             m.to());
                     if (to_participant.has_value()) {
-                        m.set_return_type(to_participant.value().return_type());
+                        m.set_return_type(
+                            intern(to_participant.value().return_type()));
                     }
                 }
                 block_message_stack.back().push_back(m);
@@ -766,7 +793,7 @@ void diagram::handle_invalid_from_condition(
         }
 
         auto possible_matches = util::get_approximate_matches(
-            from_participants, sf.location.to_string());
+            from_participants, sf.location.to_string(), 1);
 
         if (!possible_matches.empty()) {
             error_message +=
@@ -786,19 +813,24 @@ void diagram::handle_invalid_to_condition(
             to_location.location.to_string());
 
     if (!to_location.location.is_regex()) {
-        std::vector<std::string> to_participants;
+        // Each participant is usually called many times, so collect
+        // unique callees before rendering their names
+        std::set<eid_t> callees;
         for (const auto &[k, v] : sequences()) {
             for (const auto &m : v.messages()) {
-                if (m.type() != common::model::message_t::kCall)
-                    continue;
-
-                const auto &callee = *participants().at(m.to());
-                to_participants.emplace_back(callee.full_name(false));
+                if (m.type() == common::model::message_t::kCall)
+                    callees.emplace(m.to());
             }
         }
 
+        std::vector<std::string> to_participants;
+        to_participants.reserve(callees.size());
+        for (const auto &callee : callees)
+            to_participants.emplace_back(
+                participants().at(callee)->full_name(false));
+
         auto possible_matches = util::get_approximate_matches(
-            to_participants, to_location.location.to_string());
+            to_participants, to_location.location.to_string(), 1);
 
         if (!possible_matches.empty()) {
             error_message +=
@@ -18,12 +18,15 @@
 #pragma once
 
 #include "activity.h"
+#include "call_graph.h"
 #include "common/model/diagram.h"
 #include "common/types.h"
 #include "config/config.h"
 #include "participant.h"
+#include "util/util.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace clanguml::sequence_diagram::model {
@@ -318,6 +321,45 @@ public:
      */
     bool is_empty() const override;
 
+    /**
+     * @brief Restrict building of messages to a subset of functions.
+     *
+     * By default messages are built from bodies of all functions in the
+     * translation units of the diagram.
+     *
+     * @param ids Call graph node ids of functions reachable from the diagram
+     *            `from` and `to` conditions
+     */
+    void set_reachable_functions(std::unordered_set<call_graph::node_id> ids);
+
+    /**
+     * @brief Get the functions set using @ref set_reachable_functions().
+     *
+     * @return Call graph node ids of reachable functions, or empty optional
+     *         if messages are built from all functions
+     */
+    const std::optional<std::unordered_set<call_graph::node_id>> &
+    reachable_functions() const;
+
+    /**
+     * @brief Check whether messages should be built from function's body.
+     *
+     * @param id Call graph node id of the function
+     * @return True, if the function can be reachable in the diagram
+     */
+    bool should_analyze_function(call_graph::node_id id) const;
+
+    /**
+     * @brief Intern a message label or return type in this diagram.
+     *
+     * Messages only store pointers to their labels, which remain valid for
+     * the lifetime of the diagram.
+     *
+     * @param str Message label or return type
+     * @return Pointer to the interned string, or nullptr if `str` is empty
+     */
+    const std::string *intern(std::string str);
+
     /**
      * If option to inline lambda calls is enabled, we need to modify the
      * sequences to skip the lambda calls. In case lambda call does not lead
@@ -373,11 +415,17 @@ private:
         return block_end_types.count(mt) > 0;
     };
 
+    // Declared before the activities, so that it outlives the messages
+    std::unique_ptr<util::string_interner> message_strings_{
+        std::make_unique<util::string_interner>()};
+
     std::map<eid_t, activity> activities_;
 
     std::map<eid_t, std::unique_ptr<participant>> participants_;
 
     std::set<eid_t> active_participants_;
+
+    std::optional<std::unordered_set<call_graph::node_id>> reachable_functions_;
 };
 
 } // namespace clanguml::sequence_diagram::model
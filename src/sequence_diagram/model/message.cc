@@ -18,6 +18,8 @@
 
 #include "message.h"
 
+#include "util/util.h"
+
 namespace clanguml::sequence_diagram::model {
 
 message::message(common::model::message_t type, eid_t from)
@@ -26,12 +28,57 @@ message::message(common::model::message_t type, eid_t from)
 {
 }
 
+message::message(const message &other)
+    : type_{other.type_}
+    , from_{other.from_}
+    , to_{other.to_}
+    , scope_{other.scope_}
+    , message_name_{other.message_name_}
+    , return_type_{other.return_type_}
+    , details_{other.details_
+              ? std::make_unique<message_details>(*other.details_)
+              : nullptr}
+    , in_static_declaration_context_{other.in_static_declaration_context_}
+{
+}
+
+message &message::operator=(const message &other)
+{
+    if (this != &other)
+        *this = message{other};
+
+    return *this;
+}
+
 bool message::operator==(const message &other) const noexcept
 {
+    // Strings interned by the same diagram can be compared by address, but
+    // messages of different diagrams have to compare their values
+    const auto equal_strings = [](const std::string *l, const std::string *r) {
+        return l == r || interned_or_empty(l) == interned_or_empty(r);
+    };
+
     return from_ == other.from_ && to_ == other.to_ && type_ == other.type_ &&
-        scope_ == other.scope_ && message_name_ == other.message_name_ &&
-        return_type_ == other.return_type_ &&
-        condition_text_ == other.condition_text_ && comment_ == other.comment_;
+        scope_ == other.scope_ &&
+        equal_strings(message_name_, other.message_name_) &&
+        equal_strings(return_type_, other.return_type_) &&
+        condition_text() == other.condition_text() &&
+        comment() == other.comment();
+}
+
+const std::string &message::interned_or_empty(const std::string *str)
+{
+    static const std::string empty;
+
+    return str == nullptr ? empty : *str;
+}
+
+message::message_details &message::details()
+{
+    if (!details_)
+        details_ = std::make_unique<message_details>();
+
+    return *details_;
 }
 
 void message::set_type(common::model::message_t t) { type_ = t; }
@@ -46,20 +93,46 @@ void message::set_to(eid_t t) { to_ = t; }
 
 eid_t message::to() const { return to_; }
 
-void message::set_message_name(std::string name)
+void message::set_message_name(const std::string *name)
+{
+    message_name_ = name;
+}
+
+const std::string &message::message_name() const
+{
+    return interned_or_empty(message_name_);
+}
+
+void message::set_return_type(const std::string *t) { return_type_ = t; }
+
+const std::string &message::return_type() const
 {
-    message_name_ = std::move(name);
+    return interned_or_empty(return_type_);
 }
 
-const std::string &message::message_name() const { return message_name_; }
+const common::model::source_location &message::location() const
+{
+    static const common::model::source_location empty_location;
+
+    if (!details_)
+        return empty_location;
 
-void message::set_return_type(std::string t) { return_type_ = std::move(t); }
+    return details_->location;
+}
 
-const std::string &message::return_type() const { return return_type_; }
+common::model::source_location &message::location()
+{
+    return details().location;
+}
 
 const std::optional<common::model::comment_t> &message::comment() const
 {
-    return comment_;
+    static const std::optional<common::model::comment_t> empty_comment;
+
+    if (!details_)
+        return empty_comment;
+
+    return details_->comment;
 }
 
 void message::set_comment(
@@ -85,7 +158,7 @@ void message::set_comment(unsigned int id, std::string comment)
 void message::set_comment(common::model::comment_t c)
 {
     if (!c.empty())
-        comment_ = std::move(c);
+        details().comment = std::move(c);
 }
 
 void message::set_comment(const std::optional<common::model::comment_t> &c)
@@ -103,15 +176,21 @@ common::model::message_scope_t message::message_scope() const { return scope_; }
 
 void message::condition_text(const std::string &condition_text)
 {
-    if (condition_text.empty())
-        condition_text_ = std::nullopt;
-    else
-        condition_text_ = condition_text;
+    if (condition_text.empty()) {
+        if (details_)
+            details_->condition_text = std::nullopt;
+    }
+    else {
+        details().condition_text = condition_text;
+    }
 }
 
 std::optional<std::string> message::condition_text() const
 {
-    return condition_text_;
+    if (!details_)
+        return std::nullopt;
+
+    return details_->condition_text;
 }
 
 bool message::in_static_declaration_context() const
@@ -124,4 +203,35 @@ void message::in_static_declaration_context(bool v)
     in_static_declaration_context_ = v;
 }
 
+const std::vector<std::shared_ptr<decorators::decorator>> &
+message::decorators() const
+{
+    static const std::vector<std::shared_ptr<decorators::decorator>>
+        empty_decorators;
+
+    if (!details_)
+        return empty_decorators;
+
+    return details_->decorators;
+}
+
+void message::add_decorators(
+    const std::vector<std::shared_ptr<decorators::decorator>> &decorators)
+{
+    if (decorators.empty())
+        return;
+
+    auto &ds = details().decorators;
+    ds.insert(ds.end(), decorators.begin(), decorators.end());
+}
+
+bool message::skip() const
+{
+    const auto &ds = decorators();
+
+    return std::any_of(ds.begin(), ds.end(), [](const auto &d) {
+        return std::dynamic_pointer_cast<decorators::skip>(d) != nullptr;
+    });
+}
+
 } // namespace clanguml::sequence_diagram::model
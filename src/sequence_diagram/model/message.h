@@ -18,8 +18,10 @@
 #pragma once
 
 #include "common/model/enums.h"
+#include "common/model/source_location.h"
 #include "participant.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -27,11 +29,29 @@ namespace clanguml::sequence_diagram::model {
 
 /**
  * @brief Model of a sequence diagram message.
+ *
+ * Sequence diagrams can record very large numbers of messages, so unlike
+ * other diagram elements messages are not derived from
+ * `common::model::diagram_element`. Message labels are interned by the
+ * diagram which owns the message (see @ref diagram::intern()), and the source
+ * location as well as fields which are rarely set (comments, conditions and
+ * decorators) are kept in a separately allocated record, which is only
+ * created when needed.
  */
-class message : public common::model::diagram_element {
+class message {
 public:
     message() = default;
 
+    message(const message &other);
+
+    message(message &&other) noexcept = default;
+
+    message &operator=(const message &other);
+
+    message &operator=(message &&other) noexcept = default;
+
+    ~message() = default;
+
     /**
      * @brief Constructor
      *
@@ -93,9 +113,9 @@ public:
     /**
      * @brief Set the message label
      *
-     * @param name Message label
+     * @param name Message label interned by the diagram, or nullptr if empty
      */
-    void set_message_name(std::string name);
+    void set_message_name(const std::string *name);
 
     /**
      * @brief Get the message label
@@ -107,9 +127,10 @@ public:
     /**
      * @brief Set the return message type label
      *
-     * @param t Message return type label
+     * @param t Message return type label interned by the diagram, or nullptr
+     *          if empty
      */
-    void set_return_type(std::string t);
+    void set_return_type(const std::string *t);
 
     /**
      * @brief Get the return message type label
@@ -118,6 +139,20 @@ public:
      */
     const std::string &return_type() const;
 
+    /**
+     * @brief Get the source location of the message
+     *
+     * @return Source location, empty if it was never set
+     */
+    const common::model::source_location &location() const;
+
+    /**
+     * @brief Get the source location of the message for update
+     *
+     * @return Source location
+     */
+    common::model::source_location &location();
+
     const std::optional<common::model::comment_t> &comment() const;
 
     void set_comment(
@@ -164,7 +199,44 @@ public:
 
     void in_static_declaration_context(bool v);
 
+    /**
+     * @brief Get all decorators for this message.
+     *
+     * @return List of decorator pointers.
+     */
+    const std::vector<std::shared_ptr<decorators::decorator>> &
+    decorators() const;
+
+    /**
+     * @brief Add decorators to the message.
+     *
+     * @param decorators List of decorator pointers.
+     */
+    void add_decorators(
+        const std::vector<std::shared_ptr<decorators::decorator>> &decorators);
+
+    /**
+     * @brief Whether this message should be skipped from the diagram.
+     *
+     * @return True, if the message has a `skip` decorator
+     */
+    bool skip() const;
+
 private:
+    /**
+     * @brief Rarely set message properties.
+     */
+    struct message_details {
+        common::model::source_location location;
+        std::optional<std::string> condition_text;
+        std::optional<common::model::comment_t> comment;
+        std::vector<std::shared_ptr<decorators::decorator>> decorators;
+    };
+
+    message_details &details();
+
+    static const std::string &interned_or_empty(const std::string *str);
+
     common::model::message_t type_{common::model::message_t::kNone};
 
     eid_t from_{};
@@ -176,13 +248,11 @@ private:
 
     // This is only for better verbose messages, we cannot rely on this
     // always
-    std::string message_name_{};
-
-    std::string return_type_{};
+    const std::string *message_name_{nullptr};
 
-    std::optional<std::string> condition_text_;
+    const std::string *return_type_{nullptr};
 
-    std::optional<common::model::comment_t> comment_;
+    std::unique_ptr<message_details> details_;
 
     bool in_static_declaration_context_{false};
 };
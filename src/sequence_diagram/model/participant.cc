@@ -213,7 +213,10 @@ void objc_method::set_class_full_name(const std::string &name)
     class_full_name_ = name;
 }
 
-const auto &objc_method::class_full_name() const { return class_full_name_; }
+const std::string &objc_method::class_full_name() const
+{
+    return class_full_name_;
+}
 
 std::string objc_method::full_name_impl(bool relative) const
 {
@@ -290,7 +293,7 @@ void method::set_class_full_name(const std::string &name)
     class_full_name_ = name;
 }
 
-const auto &method::class_full_name() const { return class_full_name_; }
+const std::string &method::class_full_name() const { return class_full_name_; }
 
 std::string method::full_name_impl(bool relative) const
 {
@@ -473,7 +473,7 @@ struct method : public function {
      *
      * @return Class full name
      */
-    const auto &class_full_name() const;
+    const std::string &class_full_name() const;
 
     std::string message_name(message_render_mode mode) const override;
 
@@ -610,7 +610,7 @@ struct objc_method : public function {
      *
      * @return Class full name
      */
-    const auto &class_full_name() const;
+    const std::string &class_full_name() const;
 
     std::string message_name(message_render_mode mode) const override;
 
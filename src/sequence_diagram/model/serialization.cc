@@ -0,0 +1,330 @@
+/**
+ * @file src/sequence_diagram/model/serialization.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serialization.h"
+
+#include "util/error.h"
+
+namespace clanguml::sequence_diagram::model {
+
+using common::model::binary_reader;
+using common::model::binary_writer;
+
+namespace {
+enum class participant_kind_t {
+    kParticipant,
+    kClass,
+    kFunction,
+    kMethod,
+    kObjCMethod,
+    kFunctionTemplate
+};
+
+void write_participant(binary_writer &w, const participant &p)
+{
+    common::model::write_template_element(w, p);
+    common::model::write_stylable_element(w, p);
+    w.write_enum(p.stereotype_);
+}
+
+void read_participant(binary_reader &r, participant &p)
+{
+    common::model::read_template_element(r, p);
+    common::model::read_stylable_element(r, p);
+    p.stereotype_ = r.read_enum<participant::stereotype_t>();
+}
+
+void write_class(binary_writer &w, const class_ &c)
+{
+    write_participant(w, c);
+    w.write_bool(c.is_struct());
+    w.write_bool(c.is_template());
+    w.write_bool(c.is_template_instantiation());
+    w.write_bool(c.is_alias());
+    w.write_bool(c.is_lambda());
+    w.write_bool(c.is_objc_interface());
+    w.write_bool(c.is_objc_protocol());
+    w.write_id(c.lambda_operator_id());
+}
+
+void read_class(binary_reader &r, class_ &c)
+{
+    read_participant(r, c);
+    c.is_struct(r.read_bool());
+    c.is_template(r.read_bool());
+    c.is_template_instantiation(r.read_bool());
+    c.is_alias(r.read_bool());
+    c.is_lambda(r.read_bool());
+    c.is_objc_interface(r.read_bool());
+    c.is_objc_protocol(r.read_bool());
+    c.set_lambda_operator_id(r.read_id());
+}
+
+void write_function(binary_writer &w, const function &f)
+{
+    write_participant(w, f);
+    w.write_bool(f.is_const());
+    w.write_bool(f.is_void());
+    w.write_bool(f.is_static());
+    w.write_bool(f.is_operator());
+    w.write_bool(f.is_cuda_kernel());
+    w.write_bool(f.is_cuda_device());
+    w.write_bool(f.is_coroutine());
+    w.write_string(f.return_type());
+    w.write_strings(f.parameters());
+}
+
+void read_function(binary_reader &r, function &f)
+{
+    read_participant(r, f);
+    f.is_const(r.read_bool());
+    f.is_void(r.read_bool());
+    f.is_static(r.read_bool());
+    f.is_operator(r.read_bool());
+    f.is_cuda_kernel(r.read_bool());
+    f.is_cuda_device(r.read_bool());
+    f.is_coroutine(r.read_bool());
+    f.return_type(r.read_string());
+    for (const auto &parameter : r.read_strings())
+        f.add_parameter(parameter);
+}
+
+void write_method(binary_writer &w, const method &m)
+{
+    write_function(w, m);
+    w.write_id(m.class_id());
+    w.write_string(m.method_name());
+    w.write_string(m.class_full_name());
+    w.write_bool(m.is_constructor());
+    w.write_bool(m.is_defaulted());
+    w.write_bool(m.is_assignment());
+}
+
+void read_method(binary_reader &r, method &m)
+{
+    read_function(r, m);
+    m.set_class_id(r.read_id());
+    m.set_method_name(r.read_string());
+    m.set_class_full_name(r.read_string());
+    m.is_constructor(r.read_bool());
+    m.is_defaulted(r.read_bool());
+    m.is_assignment(r.read_bool());
+}
+
+void write_objc_method(binary_writer &w, const objc_method &m)
+{
+    write_function(w, m);
+    w.write_id(m.class_id());
+    w.write_string(m.method_name());
+    w.write_string(m.class_full_name());
+}
+
+void read_objc_method(binary_reader &r, objc_method &m)
+{
+    read_function(r, m);
+    m.set_class_id(r.read_id());
+    m.set_method_name(r.read_string());
+    m.set_class_full_name(r.read_string());
+}
+
+void write_message(binary_writer &w, const message &m)
+{
+    w.write_enum(m.type());
+    w.write_id(m.from());
+    w.write_id(m.to());
+    w.write_enum(m.message_scope());
+    w.write_string(m.message_name());
+    w.write_string(m.return_type());
+    w.write_optional_string(m.condition_text());
+    common::model::write_comment(w, m.comment());
+    common::model::write_decorators(w, m.decorators());
+    w.write_bool(m.in_static_declaration_context());
+    common::model::write_source_location(w, m.location());
+}
+
+message read_message(binary_reader &r, diagram &d)
+{
+    const auto type = r.read_enum<common::model::message_t>();
+    const auto from = r.read_id();
+
+    message m{type, from};
+    m.set_to(r.read_id());
+    m.set_message_scope(r.read_enum<common::model::message_scope_t>());
+    m.set_message_name(d.intern(r.read_string()));
+    m.set_return_type(d.intern(r.read_string()));
+    if (auto condition_text = r.read_optional_string(); condition_text)
+        m.condition_text(*condition_text);
+    m.set_comment(common::model::read_comment(r));
+    if (auto decorators = common::model::read_decorators(r);
+        !decorators.empty())
+        m.add_decorators(decorators);
+    m.in_static_declaration_context(r.read_bool());
+    // Messages without source location do not allocate the details record
+    common::model::source_location location;
+    common::model::read_source_location(r, location);
+    if (location.file_id() != common::model::file_path_table::kEmpty ||
+        location.translation_unit_id() !=
+            common::model::file_path_table::kEmpty ||
+        location.line() != 0)
+        m.location() = location;
+
+    return m;
+}
+
+void write_participant_record(binary_writer &w, const participant &p)
+{
+    common::model::write_path(w, p.using_namespace());
+
+    // More specific participant types have to be checked first
+    if (const auto *m = dynamic_cast<const method *>(&p); m != nullptr) {
+        w.write_enum(participant_kind_t::kMethod);
+        write_method(w, *m);
+    }
+    else if (const auto *om = dynamic_cast<const objc_method *>(&p);
+             om != nullptr) {
+        w.write_enum(participant_kind_t::kObjCMethod);
+        write_objc_method(w, *om);
+    }
+    else if (const auto *ft = dynamic_cast<const function_template *>(&p);
+             ft != nullptr) {
+        w.write_enum(participant_kind_t::kFunctionTemplate);
+        write_function(w, *ft);
+    }
+    else if (const auto *f = dynamic_cast<const function *>(&p);
+             f != nullptr) {
+        w.write_enum(participant_kind_t::kFunction);
+        write_function(w, *f);
+    }
+    else if (const auto *c = dynamic_cast<const class_ *>(&p); c != nullptr) {
+        w.write_enum(participant_kind_t::kClass);
+        write_class(w, *c);
+    }
+    else {
+        w.write_enum(participant_kind_t::kParticipant);
+        write_participant(w, p);
+    }
+}
+
+std::unique_ptr<participant> read_participant_record(binary_reader &r)
+{
+    const auto using_namespace = common::model::read_path(r);
+
+    switch (r.read_enum<participant_kind_t>()) {
+    case participant_kind_t::kMethod: {
+        auto m = std::make_unique<method>(using_namespace);
+        read_method(r, *m);
+        return m;
+    }
+    case participant_kind_t::kObjCMethod: {
+        auto m = std::make_unique<objc_method>(using_namespace);
+        read_objc_method(r, *m);
+        return m;
+    }
+    case participant_kind_t::kFunctionTemplate: {
+        auto f = std::make_unique<function_template>(using_namespace);
+        read_function(r, *f);
+        return f;
+    }
+    case participant_kind_t::kFunction: {
+        auto f = std::make_unique<function>(using_namespace);
+        read_function(r, *f);
+        return f;
+    }
+    case participant_kind_t::kClass: {
+        auto c = std::make_unique<class_>(using_namespace);
+        read_class(r, *c);
+        return c;
+    }
+    case participant_kind_t::kParticipant: {
+        auto p = std::make_unique<participant>(using_namespace);
+        read_participant(r, *p);
+        return p;
+    }
+    }
+
+    throw error::model_serialization_error(
+        "Invalid sequence diagram participant kind");
+}
+} // namespace
+
+void serialize(const diagram &d, binary_writer &w)
+{
+    w.write_uint(d.participants().size());
+    for (const auto &[id, p] : d.participants())
+        write_participant_record(w, *p);
+
+    w.write_uint(d.sequences().size());
+    for (const auto &[id, a] : d.sequences()) {
+        w.write_id(a.from());
+
+        w.write_uint(a.messages().size());
+        for (const auto &m : a.messages())
+            write_message(w, m);
+
+        w.write_uint(a.callers().size());
+        for (const auto &caller : a.callers())
+            w.write_id(caller);
+    }
+
+    w.write_uint(d.active_participants().size());
+    for (const auto &id : d.active_participants())
+        w.write_id(id);
+}
+
+void deserialize(binary_reader &r, diagram &d)
+{
+    auto count = r.read_uint();
+    for (auto i = 0U; i < count; i++) {
+        auto p = read_participant_record(r);
+        const auto id = p->id();
+        d.participants().emplace(id, std::move(p));
+    }
+
+    count = r.read_uint();
+    for (auto i = 0U; i < count; i++) {
+        const auto activity_id = r.read_id();
+        activity a{activity_id};
+
+        const auto messages_count = r.read_uint();
+        for (auto j = 0U; j < messages_count; j++)
+            a.add_message(read_message(r, d));
+
+        const auto callers_count = r.read_uint();
+        for (auto j = 0U; j < callers_count; j++)
+            a.add_caller(r.read_id());
+
+        auto it = d.sequences().find(activity_id);
+        if (it == d.sequences().end()) {
+            d.sequences().emplace(activity_id, std::move(a));
+            continue;
+        }
+
+        auto &existing = it->second;
+        if (existing.messages().empty())
+            existing.messages() = std::move(a.messages());
+
+        for (const auto &caller : a.callers())
+            existing.add_caller(caller);
+    }
+
+    count = r.read_uint();
+    for (auto i = 0U; i < count; i++)
+        d.add_active_participant(r.read_id());
+}
+
+} // namespace clanguml::sequence_diagram::model
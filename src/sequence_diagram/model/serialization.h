@@ -0,0 +1,49 @@
+/**
+ * @file src/sequence_diagram/model/serialization.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/serialization.h"
+#include "sequence_diagram/model/diagram.h"
+
+namespace clanguml::sequence_diagram::model {
+
+/**
+ * @brief Serialize the sequence diagram model.
+ *
+ * Participants, activities and active participants are written in the
+ * order of their ids.
+ *
+ * @param d Sequence diagram model
+ * @param w Binary writer
+ */
+void serialize(const diagram &d, common::model::binary_writer &w);
+
+/**
+ * @brief Merge a serialized sequence diagram model into a diagram.
+ *
+ * Participants already in the diagram are not replaced. Messages of an
+ * activity already in the diagram are only taken from the serialized
+ * model if the activity has no messages yet, while the callers of the
+ * activity are merged.
+ *
+ * @param r Binary reader
+ * @param d Sequence diagram model to merge the partial model into
+ */
+void deserialize(common::model::binary_reader &r, diagram &d);
+
+} // namespace clanguml::sequence_diagram::model
@@ -249,11 +249,11 @@ clang::IfStmt *call_expression_context::current_elseifstmt() const
 {
     assert(current_ifstmt() != nullptr);
 
-    if (elseif_stmt_stacks_.count(current_ifstmt()) == 0 ||
-        elseif_stmt_stacks_.at(current_ifstmt()).empty())
+    const auto it = elseif_stmt_stacks_.find(current_ifstmt());
+    if (it == elseif_stmt_stacks_.end() || it->second.empty())
         return nullptr;
 
-    return elseif_stmt_stacks_.at(current_ifstmt()).top();
+    return it->second.top();
 }
 
 clang::Stmt *call_expression_context::current_loopstmt() const
@@ -25,6 +25,8 @@
 #include <clang/Basic/SourceManager.h>
 
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 namespace clanguml::sequence_diagram::visitor {
 
@@ -337,18 +339,26 @@ struct call_expression_context {
     clang::ObjCProtocolDecl *objc_protocol_decl_{nullptr};
 
 private:
+    /**
+     * Stacks are backed by vectors, which keep their capacity when popped,
+     * so once the traversal reaches its maximum nesting depth, pushing does
+     * not allocate anymore.
+     */
+    template <typename T> using stack_t = std::stack<T, std::vector<T>>;
+
     eid_t current_caller_id_{};
-    std::stack<eid_t> current_lambda_caller_id_;
+    stack_t<eid_t> current_lambda_caller_id_;
 
-    std::stack<callexpr_stack_t> call_expr_stack_;
+    stack_t<callexpr_stack_t> call_expr_stack_;
 
-    std::stack<clang::IfStmt *> if_stmt_stack_;
-    std::map<clang::IfStmt *, std::stack<clang::IfStmt *>> elseif_stmt_stacks_;
+    stack_t<clang::IfStmt *> if_stmt_stack_;
+    std::unordered_map<clang::IfStmt *, stack_t<clang::IfStmt *>>
+        elseif_stmt_stacks_;
 
-    std::stack<clang::Stmt *> loop_stmt_stack_;
-    std::stack<clang::Stmt *> try_stmt_stack_;
-    std::stack<clang::SwitchStmt *> switch_stmt_stack_;
-    std::stack<clang::ConditionalOperator *> conditional_operator_stack_;
+    stack_t<clang::Stmt *> loop_stmt_stack_;
+    stack_t<clang::Stmt *> try_stmt_stack_;
+    stack_t<clang::SwitchStmt *> switch_stmt_stack_;
+    stack_t<clang::ConditionalOperator *> conditional_operator_stack_;
 };
 
 } // namespace clanguml::sequence_diagram::visitor
\ No newline at end of file
@@ -0,0 +1,280 @@
+/**
+ * @file src/sequence_diagram/visitor/call_graph_visitor.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "call_graph_visitor.h"
+
+#include "util/util.h"
+
+#include <clang/AST/DeclObjC.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/AST/ExprObjC.h>
+
+#include <algorithm>
+
+namespace clanguml::sequence_diagram::visitor {
+
+std::string call_graph_name(const clang::NamedDecl &decl)
+{
+    std::vector<std::string> names;
+    names.emplace_back(decl.getNameAsString());
+
+    for (const auto *ctx = decl.getDeclContext(); ctx != nullptr;
+         ctx = ctx->getParent()) {
+        const auto *named_ctx = llvm::dyn_cast<clang::NamedDecl>(ctx);
+        if (named_ctx == nullptr)
+            continue;
+
+        auto name = named_ctx->getNameAsString();
+        if (!name.empty())
+            names.emplace_back(std::move(name));
+    }
+
+    std::reverse(names.begin(), names.end());
+
+    return util::join(names, "::");
+}
+
+call_graph_visitor::call_graph_visitor(model::call_graph &graph)
+    : graph_{graph}
+{
+}
+
+template <typename T, typename F>
+bool call_graph_visitor::traverse_function(T *declaration, F &&traverse)
+{
+    if (declaration == nullptr || !declaration->hasBody())
+        return traverse(declaration);
+
+    callers_.push_back(graph_.add_function(call_graph_name(*declaration)));
+
+    const auto result = traverse(declaration);
+
+    callers_.pop_back();
+
+    return result;
+}
+
+bool call_graph_visitor::TraverseFunctionDecl(clang::FunctionDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<call_graph_visitor>::TraverseFunctionDecl(d);
+    });
+}
+
+bool call_graph_visitor::TraverseCXXMethodDecl(
+    clang::CXXMethodDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<call_graph_visitor>::TraverseCXXMethodDecl(
+            d);
+    });
+}
+
+bool call_graph_visitor::TraverseCXXConstructorDecl(
+    clang::CXXConstructorDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<
+            call_graph_visitor>::TraverseCXXConstructorDecl(d);
+    });
+}
+
+bool call_graph_visitor::TraverseCXXDestructorDecl(
+    clang::CXXDestructorDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<
+            call_graph_visitor>::TraverseCXXDestructorDecl(d);
+    });
+}
+
+bool call_graph_visitor::TraverseCXXConversionDecl(
+    clang::CXXConversionDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<
+            call_graph_visitor>::TraverseCXXConversionDecl(d);
+    });
+}
+
+bool call_graph_visitor::TraverseObjCMethodDecl(
+    clang::ObjCMethodDecl *declaration)
+{
+    return traverse_function(declaration, [this](auto *d) {
+        return RecursiveASTVisitor<call_graph_visitor>::TraverseObjCMethodDecl(
+            d);
+    });
+}
+
+bool call_graph_visitor::TraverseLambdaExpr(clang::LambdaExpr *expr)
+{
+    const auto lambda_id =
+        graph_.add_function(call_graph_name(*expr->getCallOperator()));
+
+    if (!callers_.empty())
+        graph_.add_call(callers_.back(), lambda_id);
+
+    callers_.push_back(lambda_id);
+
+    const auto result =
+        RecursiveASTVisitor<call_graph_visitor>::TraverseLambdaExpr(expr);
+
+    callers_.pop_back();
+
+    return result;
+}
+
+bool call_graph_visitor::VisitDeclRefExpr(clang::DeclRefExpr *expr)
+{
+    if (const auto *function_decl =
+            llvm::dyn_cast<clang::FunctionDecl>(expr->getDecl());
+        function_decl != nullptr) {
+        add_call(function_decl);
+    }
+
+    return true;
+}
+
+bool call_graph_visitor::VisitMemberExpr(clang::MemberExpr *expr)
+{
+    if (const auto *method_decl =
+            llvm::dyn_cast<clang::CXXMethodDecl>(expr->getMemberDecl());
+        method_decl != nullptr) {
+        add_call(method_decl);
+    }
+
+    return true;
+}
+
+bool call_graph_visitor::VisitCXXConstructExpr(clang::CXXConstructExpr *expr)
+{
+    add_call(expr->getConstructor());
+
+    return true;
+}
+
+bool call_graph_visitor::VisitObjCMessageExpr(clang::ObjCMessageExpr *expr)
+{
+    // Objective-C methods can be implemented in categories and dispatched
+    // dynamically, so record the call only by the selector
+    add_unresolved_call(expr->getSelector().getAsString());
+
+    return true;
+}
+
+bool call_graph_visitor::VisitUnresolvedLookupExpr(
+    clang::UnresolvedLookupExpr *expr)
+{
+    for (const auto *decl : expr->decls()) {
+        if (const auto *function_template_decl =
+                llvm::dyn_cast<clang::FunctionTemplateDecl>(decl);
+            function_template_decl != nullptr) {
+            add_call(function_template_decl->getTemplatedDecl());
+        }
+        else if (llvm::isa<clang::FunctionDecl>(decl)) {
+            add_call(decl);
+        }
+    }
+
+    // Argument dependent lookup can find functions in other namespaces
+    if (expr->requiresADL())
+        add_unresolved_call(expr->getName().getAsString());
+
+    return true;
+}
+
+bool call_graph_visitor::VisitUnresolvedMemberExpr(
+    clang::UnresolvedMemberExpr *expr)
+{
+    add_unresolved_call(expr->getMemberName().getAsString());
+
+    return true;
+}
+
+bool call_graph_visitor::VisitCXXDependentScopeMemberExpr(
+    clang::CXXDependentScopeMemberExpr *expr)
+{
+    add_unresolved_call(expr->getMember().getAsString());
+
+    return true;
+}
+
+void call_graph_visitor::add_call(const clang::NamedDecl *callee)
+{
+    if (callers_.empty() || callee == nullptr)
+        return;
+
+    graph_.add_call(
+        callers_.back(), graph_.add_function(call_graph_name(*callee)));
+}
+
+void call_graph_visitor::add_unresolved_call(const std::string &callee_name)
+{
+    if (callers_.empty() || callee_name.empty())
+        return;
+
+    graph_.add_unresolved_call(callers_.back(), callee_name);
+}
+
+namespace {
+class call_graph_ast_consumer : public clang::ASTConsumer {
+public:
+    explicit call_graph_ast_consumer(model::call_graph &graph)
+        : visitor_{graph}
+    {
+    }
+
+    void HandleTranslationUnit(clang::ASTContext &ast_context) override
+    {
+        visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+    }
+
+private:
+    call_graph_visitor visitor_;
+};
+
+class call_graph_action : public clang::ASTFrontendAction {
+public:
+    explicit call_graph_action(model::call_graph &graph)
+        : graph_{graph}
+    {
+    }
+
+protected:
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
+        clang::CompilerInstance & /*ci*/, clang::StringRef /*file*/) override
+    {
+        return std::make_unique<call_graph_ast_consumer>(graph_);
+    }
+
+private:
+    model::call_graph &graph_;
+};
+} // namespace
+
+call_graph_action_factory::call_graph_action_factory(model::call_graph &graph)
+    : graph_{graph}
+{
+}
+
+std::unique_ptr<clang::FrontendAction> call_graph_action_factory::create()
+{
+    return std::make_unique<call_graph_action>(graph_);
+}
+
+} // namespace clanguml::sequence_diagram::visitor
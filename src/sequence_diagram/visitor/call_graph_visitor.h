@@ -0,0 +1,117 @@
+/**
+ * @file src/sequence_diagram/visitor/call_graph_visitor.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "sequence_diagram/model/call_graph.h"
+
+#include <clang/AST/ASTConsumer.h>
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <string>
+#include <vector>
+
+namespace clanguml::sequence_diagram::visitor {
+
+/**
+ * @brief Get the call graph node name of a function declaration.
+ *
+ * The name consists of names of all enclosing named declaration contexts
+ * and the name of the function, without any template arguments or
+ * parameters, e.g. `ns::A::foo`.
+ *
+ * @param decl Function or method declaration
+ * @return Qualified name of the call graph node
+ */
+std::string call_graph_name(const clang::NamedDecl &decl);
+
+/**
+ * @brief Visitor building caller to callee graph of a translation unit.
+ *
+ * This visitor only records which functions are referenced from function
+ * bodies, without building any diagram elements. Lambda expressions are
+ * recorded as called by their enclosing function, since they can be invoked
+ * from any function they are passed to.
+ */
+class call_graph_visitor
+    : public clang::RecursiveASTVisitor<call_graph_visitor> {
+public:
+    explicit call_graph_visitor(model::call_graph &graph);
+
+    bool shouldVisitTemplateInstantiations() const { return true; }
+
+    bool TraverseFunctionDecl(clang::FunctionDecl *declaration);
+
+    bool TraverseCXXMethodDecl(clang::CXXMethodDecl *declaration);
+
+    bool TraverseCXXConstructorDecl(clang::CXXConstructorDecl *declaration);
+
+    bool TraverseCXXDestructorDecl(clang::CXXDestructorDecl *declaration);
+
+    bool TraverseCXXConversionDecl(clang::CXXConversionDecl *declaration);
+
+    bool TraverseObjCMethodDecl(clang::ObjCMethodDecl *declaration);
+
+    bool TraverseLambdaExpr(clang::LambdaExpr *expr);
+
+    bool VisitDeclRefExpr(clang::DeclRefExpr *expr);
+
+    bool VisitMemberExpr(clang::MemberExpr *expr);
+
+    bool VisitCXXConstructExpr(clang::CXXConstructExpr *expr);
+
+    bool VisitObjCMessageExpr(clang::ObjCMessageExpr *expr);
+
+    bool VisitUnresolvedLookupExpr(clang::UnresolvedLookupExpr *expr);
+
+    bool VisitUnresolvedMemberExpr(clang::UnresolvedMemberExpr *expr);
+
+    bool VisitCXXDependentScopeMemberExpr(
+        clang::CXXDependentScopeMemberExpr *expr);
+
+private:
+    template <typename T, typename F>
+    bool traverse_function(T *declaration, F &&traverse);
+
+    void add_call(const clang::NamedDecl *callee);
+
+    void add_unresolved_call(const std::string &callee_name);
+
+    model::call_graph &graph_;
+
+    std::vector<model::call_graph::node_id> callers_;
+};
+
+/**
+ * @brief Frontend action factory building a call graph of all translation
+ *        units processed by a clang tool.
+ */
+class call_graph_action_factory
+    : public clang::tooling::FrontendActionFactory {
+public:
+    explicit call_graph_action_factory(model::call_graph &graph);
+
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+private:
+    model::call_graph &graph_;
+};
+
+} // namespace clanguml::sequence_diagram::visitor
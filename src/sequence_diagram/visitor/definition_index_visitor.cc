@@ -0,0 +1,172 @@
+/**
+ * @file src/sequence_diagram/visitor/definition_index_visitor.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "definition_index_visitor.h"
+
+#include "call_graph_visitor.h"
+
+#include <clang/AST/DeclObjC.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/Utils.h>
+#include <llvm/Support/Path.h>
+
+namespace clanguml::sequence_diagram::visitor {
+
+definition_index_visitor::definition_index_visitor(
+    const clang::SourceManager &sm)
+    : source_manager_{sm}
+{
+}
+
+bool definition_index_visitor::VisitFunctionDecl(
+    clang::FunctionDecl *declaration)
+{
+    if (declaration->doesThisDeclarationHaveABody() ||
+        declaration->hasSkippedBody())
+        add_definition(*declaration, declaration->getLocation());
+
+    return true;
+}
+
+bool definition_index_visitor::VisitObjCMethodDecl(
+    clang::ObjCMethodDecl *declaration)
+{
+    if (declaration->hasBody() || declaration->hasSkippedBody())
+        add_definition(*declaration, declaration->getLocation());
+
+    return true;
+}
+
+void definition_index_visitor::finalize(
+    model::definition_index::translation_unit_entry &entry)
+{
+    // Functions defined in the source file are not also inline definitions
+    for (const auto &name : definitions_)
+        inline_definitions_.erase(name);
+
+    entry.definitions.assign(definitions_.begin(), definitions_.end());
+    entry.inline_definitions.assign(
+        inline_definitions_.begin(), inline_definitions_.end());
+}
+
+void definition_index_visitor::add_definition(
+    const clang::NamedDecl &declaration, clang::SourceLocation location)
+{
+    const auto expansion_location = source_manager_.getExpansionLoc(location);
+
+    if (source_manager_.isInSystemHeader(expansion_location))
+        return;
+
+    auto name = call_graph_name(declaration);
+
+    if (source_manager_.isInMainFile(expansion_location))
+        definitions_.emplace(std::move(name));
+    else
+        inline_definitions_.emplace(std::move(name));
+}
+
+namespace {
+class definition_index_ast_consumer : public clang::ASTConsumer {
+public:
+    definition_index_ast_consumer(const clang::SourceManager &sm,
+        model::definition_index::translation_unit_entry &entry)
+        : visitor_{sm}
+        , entry_{entry}
+    {
+    }
+
+    void HandleTranslationUnit(clang::ASTContext &ast_context) override
+    {
+        visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+        visitor_.finalize(entry_);
+    }
+
+private:
+    definition_index_visitor visitor_;
+    model::definition_index::translation_unit_entry &entry_;
+};
+
+class definition_index_action : public clang::ASTFrontendAction {
+public:
+    explicit definition_index_action(
+        model::definition_index::translation_unit_entry &entry)
+        : entry_{entry}
+    {
+    }
+
+protected:
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
+        clang::CompilerInstance &ci, clang::StringRef /*file*/) override
+    {
+        return std::make_unique<definition_index_ast_consumer>(
+            ci.getSourceManager(), entry_);
+    }
+
+    bool BeginSourceFileAction(clang::CompilerInstance &ci) override
+    {
+        ci.getFrontendOpts().SkipFunctionBodies = true;
+
+        dependency_collector_ = std::make_shared<clang::DependencyCollector>();
+        dependency_collector_->attachToPreprocessor(ci.getPreprocessor());
+
+        return true;
+    }
+
+    void EndSourceFileAction() override
+    {
+        auto &file_manager = getCompilerInstance().getFileManager();
+
+        const auto make_absolute = [&file_manager](llvm::StringRef p) {
+            llvm::SmallString<256> path{p};
+            file_manager.makeAbsolutePath(path);
+            llvm::sys::path::remove_dots(path, true);
+            return path.str().str();
+        };
+
+        entry_.dependencies.clear();
+
+        const auto add_dependency = [this](std::string &&path) {
+            const auto hash = model::definition_index::file_hash(path);
+            entry_.dependencies.emplace(std::move(path), hash);
+        };
+
+        add_dependency(make_absolute(getCurrentFile()));
+        for (const auto &file : dependency_collector_->getDependencies())
+            add_dependency(make_absolute(file));
+
+        clang::ASTFrontendAction::EndSourceFileAction();
+    }
+
+private:
+    model::definition_index::translation_unit_entry &entry_;
+    std::shared_ptr<clang::DependencyCollector> dependency_collector_;
+};
+} // namespace
+
+definition_index_action_factory::definition_index_action_factory(
+    model::definition_index::translation_unit_entry &entry)
+    : entry_{entry}
+{
+}
+
+std::unique_ptr<clang::FrontendAction> definition_index_action_factory::create()
+{
+    return std::make_unique<definition_index_action>(entry_);
+}
+
+} // namespace clanguml::sequence_diagram::visitor
@@ -0,0 +1,85 @@
+/**
+ * @file src/sequence_diagram/visitor/definition_index_visitor.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "sequence_diagram/model/definition_index.h"
+
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <set>
+#include <string>
+
+namespace clanguml::sequence_diagram::visitor {
+
+/**
+ * @brief Visitor collecting function definitions of a translation unit.
+ *
+ * The visitor is run with function bodies skipped, so it only records
+ * which functions are defined in the translation unit source file and in
+ * the non-system headers it includes, using their call graph names.
+ */
+class definition_index_visitor
+    : public clang::RecursiveASTVisitor<definition_index_visitor> {
+public:
+    explicit definition_index_visitor(const clang::SourceManager &sm);
+
+    bool VisitFunctionDecl(clang::FunctionDecl *declaration);
+
+    bool VisitObjCMethodDecl(clang::ObjCMethodDecl *declaration);
+
+    /**
+     * @brief Move collected definitions to the index entry.
+     *
+     * @param entry Definition index entry of the translation unit
+     */
+    void finalize(model::definition_index::translation_unit_entry &entry);
+
+private:
+    void add_definition(
+        const clang::NamedDecl &declaration, clang::SourceLocation location);
+
+    const clang::SourceManager &source_manager_;
+
+    std::set<std::string> definitions_;
+    std::set<std::string> inline_definitions_;
+};
+
+/**
+ * @brief Frontend action factory indexing function definitions of a
+ *        single translation unit.
+ *
+ * Function bodies are not parsed, and the content hashes of all files
+ * included by the translation unit are recorded in the entry, so that the
+ * entry can be invalidated when any of them changes.
+ */
+class definition_index_action_factory
+    : public clang::tooling::FrontendActionFactory {
+public:
+    explicit definition_index_action_factory(
+        model::definition_index::translation_unit_entry &entry);
+
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+private:
+    model::definition_index::translation_unit_entry &entry_;
+};
+
+} // namespace clanguml::sequence_diagram::visitor
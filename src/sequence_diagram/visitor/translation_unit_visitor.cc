@@ -18,6 +18,7 @@
 
 #include "translation_unit_visitor.h"
 
+#include "call_graph_visitor.h"
 #include "common/clang_utils.h"
 #include "common/model/namespace.h"
 #include "sequence_diagram/model/participant.h"
@@ -55,6 +56,21 @@ const call_expression_context &translation_unit_visitor::context() const
     return call_expression_context_;
 }
 
+bool translation_unit_visitor::should_analyze_function(
+    const clang::FunctionDecl *declaration) const
+{
+    if (declaration == nullptr || !declaration->doesThisDeclarationHaveABody())
+        return true;
+
+    // Lambdas are traversed from their enclosing functions
+    if (const auto *method = llvm::dyn_cast<clang::CXXMethodDecl>(declaration);
+        method != nullptr && method->getParent()->isLambda())
+        return true;
+
+    return diagram().should_analyze_function(
+        model::call_graph::to_id(call_graph_name(*declaration)));
+}
+
 bool translation_unit_visitor::VisitObjCProtocolDecl(
     clang::ObjCProtocolDecl *declaration)
 {
@@ -360,6 +376,9 @@ bool translation_unit_visitor::VisitObjCMethodDecl(
 bool translation_unit_visitor::TraverseCXXMethodDecl(
     clang::CXXMethodDecl *declaration)
 {
+    if (!should_analyze_function(declaration))
+        return true;
+
     // We need to backup the context, since other methods or functions can
     // be traversed during this traversal (e.g. template function/method
     // specializations)
@@ -438,6 +457,9 @@ bool translation_unit_visitor::VisitCXXMethodDecl(
 bool translation_unit_visitor::TraverseFunctionDecl(
     clang::FunctionDecl *declaration)
 {
+    if (!should_analyze_function(declaration))
+        return true;
+
     // We need to backup the context, since other methods or functions can
     // be traversed during this traversal (e.g. template function/method
     // specializations)
@@ -532,6 +554,9 @@ bool translation_unit_visitor::VisitFunctionDecl(
 bool translation_unit_visitor::TraverseFunctionTemplateDecl(
     clang::FunctionTemplateDecl *declaration)
 {
+    if (!should_analyze_function(declaration->getTemplatedDecl()))
+        return true;
+
     // We need to backup the context, since other methods or functions can
     // be traversed during this traversal (e.g. template function/method
     // specializations)
@@ -643,7 +668,7 @@ bool translation_unit_visitor::VisitLambdaExpr(clang::LambdaExpr *expr)
         using clanguml::sequence_diagram::model::message;
 
         message m{message_t::kCall, context().caller_id()};
-        set_source_location(*expr, m);
+        set_source_location(*expr, m.location());
         m.set_from(context().caller_id());
         m.set_to(lambda_method_model_ptr->id());
 
@@ -949,7 +974,7 @@ bool translation_unit_visitor::TraverseCompoundStmt(clang::CompoundStmt *stmt)
 
             if (current_caller_id.value() != 0) {
                 model::message m{message_t::kElse, current_caller_id};
-                set_source_location(*stmt, m);
+                set_source_location(*stmt, m.location());
                 diagram().add_message(std::move(m));
             }
         }
@@ -960,7 +985,7 @@ bool translation_unit_visitor::TraverseCompoundStmt(clang::CompoundStmt *stmt)
 
             if (current_caller_id.value() != 0) {
                 model::message m{message_t::kElse, current_caller_id};
-                set_source_location(*stmt, m);
+                set_source_location(*stmt, m.location());
                 diagram().add_message(std::move(m));
             }
         }
@@ -1009,7 +1034,7 @@ bool translation_unit_visitor::TraverseIfStmt(clang::IfStmt *stmt)
             context().enter_elseifstmt(stmt);
 
             message m{message_t::kElseIf, current_caller_id};
-            set_source_location(*stmt, m);
+            set_source_location(*stmt, m.location());
             m.condition_text(condition_text);
             m.set_comment(get_expression_comment(source_manager(),
                 *context().get_ast_context(), current_caller_id, stmt));
@@ -1021,7 +1046,7 @@ bool translation_unit_visitor::TraverseIfStmt(clang::IfStmt *stmt)
                 stmt->getBeginLoc().printToString(source_manager()));
 
             message m{message_t::kIf, current_caller_id};
-            set_source_location(*stmt, m);
+            set_source_location(*stmt, m.location());
             m.condition_text(condition_text);
             m.set_comment(get_expression_comment(source_manager(),
                 *context().get_ast_context(), current_caller_id, stmt));
@@ -1060,7 +1085,7 @@ bool translation_unit_visitor::TraverseWhileStmt(clang::WhileStmt *stmt)
 
         context().enter_loopstmt(stmt);
         message m{message_t::kWhile, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.condition_text(condition_text);
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
@@ -1093,7 +1118,7 @@ bool translation_unit_visitor::TraverseDoStmt(clang::DoStmt *stmt)
     if (current_caller_id.value() != 0) {
         context().enter_loopstmt(stmt);
         message m{message_t::kDo, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.condition_text(condition_text);
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
@@ -1126,7 +1151,7 @@ bool translation_unit_visitor::TraverseForStmt(clang::ForStmt *stmt)
     if (current_caller_id.value() != 0) {
         context().enter_loopstmt(stmt);
         message m{message_t::kFor, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.condition_text(condition_text);
 
         m.set_comment(get_expression_comment(source_manager(),
@@ -1157,7 +1182,7 @@ bool translation_unit_visitor::TraverseCXXTryStmt(clang::CXXTryStmt *stmt)
     if (current_caller_id.value() != 0) {
         context().enter_trystmt(stmt);
         message m{message_t::kTry, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
         diagram().add_block_message(std::move(m));
@@ -1192,7 +1217,7 @@ bool translation_unit_visitor::TraverseCXXCatchStmt(clang::CXXCatchStmt *stmt)
                 stmt->getCaughtType(), *context().get_ast_context());
 
         model::message m{message_t::kCatch, current_caller_id};
-        m.set_message_name(std::move(caught_type));
+        m.set_message_name(diagram().intern(std::move(caught_type)));
         diagram().add_message(std::move(m));
     }
 
@@ -1217,7 +1242,7 @@ bool translation_unit_visitor::TraverseCXXForRangeStmt(
     if (current_caller_id.value() != 0) {
         context().enter_loopstmt(stmt);
         message m{message_t::kFor, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.condition_text(condition_text);
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
@@ -1245,7 +1270,7 @@ bool translation_unit_visitor::TraverseSwitchStmt(clang::SwitchStmt *stmt)
     if (current_caller_id.value() != 0) {
         context().enter_switchstmt(stmt);
         model::message m{message_t::kSwitch, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
         diagram().add_block_message(std::move(m));
@@ -1271,7 +1296,7 @@ bool translation_unit_visitor::TraverseCaseStmt(clang::CaseStmt *stmt)
     if ((current_caller_id.value() != 0) &&
         (context().current_switchstmt() != nullptr)) {
         model::message m{message_t::kCase, current_caller_id};
-        m.set_message_name(common::to_string(stmt->getLHS()));
+        m.set_message_name(diagram().intern(common::to_string(stmt->getLHS())));
         diagram().add_case_stmt_message(std::move(m));
     }
 
@@ -1289,7 +1314,7 @@ bool translation_unit_visitor::TraverseDefaultStmt(clang::DefaultStmt *stmt)
     if ((current_caller_id.value() != 0) &&
         (context().current_switchstmt() != nullptr)) {
         model::message m{message_t::kCase, current_caller_id};
-        m.set_message_name("default");
+        m.set_message_name(diagram().intern("default"));
         diagram().add_case_stmt_message(std::move(m));
     }
 
@@ -1312,7 +1337,7 @@ bool translation_unit_visitor::TraverseConditionalOperator(
     if (current_caller_id.value() != 0) {
         context().enter_conditionaloperator(stmt);
         model::message m{message_t::kConditional, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         m.condition_text(condition_text);
         m.set_comment(get_expression_comment(source_manager(),
             *context().get_ast_context(), current_caller_id, stmt));
@@ -1327,7 +1352,7 @@ bool translation_unit_visitor::TraverseConditionalOperator(
 
     if (current_caller_id.value() != 0) {
         model::message m{message_t::kConditionalElse, current_caller_id};
-        set_source_location(*stmt, m);
+        set_source_location(*stmt, m.location());
         diagram().add_message(std::move(m));
     }
 
@@ -1362,7 +1387,7 @@ bool translation_unit_visitor::VisitObjCMessageExpr(
 
     message m{message_t::kCall, context().caller_id()};
 
-    set_source_location(*expr, m);
+    set_source_location(*expr, m.location());
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
         source_manager(), *context().get_ast_context(), expr);
@@ -1452,7 +1477,7 @@ bool translation_unit_visitor::VisitCallExpr(clang::CallExpr *expr)
 
     m.in_static_declaration_context(within_static_variable_declaration_ > 0);
 
-    set_source_location(*expr, m);
+    set_source_location(*expr, m.location());
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
         source_manager(), *context().get_ast_context(), expr);
@@ -1620,11 +1645,12 @@ bool translation_unit_visitor::VisitCoawaitExpr(clang::CoawaitExpr *expr)
         context().caller_id());
 
     message m{message_t::kCoAwait, context().caller_id()};
-    set_source_location(*expr, m);
+    set_source_location(*expr, m.location());
 
     if (expr->getOperand() != nullptr) {
         std::string message_name = common::to_string(expr->getOperand());
-        m.set_message_name(util::condense_whitespace(message_name));
+        m.set_message_name(
+            diagram().intern(util::condense_whitespace(message_name)));
     }
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
@@ -1694,7 +1720,7 @@ bool translation_unit_visitor::VisitReturnStmt(clang::ReturnStmt *stmt)
 
     message m{message_t::kReturn, context().caller_id()};
 
-    set_source_location(*stmt, m);
+    set_source_location(*stmt, m.location());
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
         source_manager(), *context().get_ast_context(), stmt);
@@ -1706,7 +1732,8 @@ bool translation_unit_visitor::VisitReturnStmt(clang::ReturnStmt *stmt)
 
     if (stmt->getRetValue() != nullptr) {
         std::string message_name = common::to_string(stmt->getRetValue());
-        m.set_message_name(util::condense_whitespace(message_name));
+        m.set_message_name(
+            diagram().intern(util::condense_whitespace(message_name)));
     }
 
     if (context().lambda_caller_id().has_value() &&
@@ -1716,26 +1743,29 @@ bool translation_unit_visitor::VisitReturnStmt(clang::ReturnStmt *stmt)
 
         if (lambda_model.has_value()) {
             if (lambda_model.has_value())
-                m.set_return_type(lambda_model.value().return_type());
+                m.set_return_type(
+                    diagram().intern(lambda_model.value().return_type()));
         }
     }
     else if (context().current_function_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_function_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_function_decl_->getReturnType().getAsString()));
     }
     else if (context().current_function_template_decl_ != nullptr) {
-        m.set_return_type(context()
-                .current_function_template_decl_->getAsFunction()
-                ->getReturnType()
-                .getAsString());
+        m.set_return_type(
+            diagram().intern(context()
+                    .current_function_template_decl_->getAsFunction()
+                    ->getReturnType()
+                    .getAsString()));
     }
     else if (context().current_method_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_method_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_method_decl_->getReturnType().getAsString()));
     }
     else if (context().current_objc_method_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_objc_method_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_objc_method_decl_->getReturnType()
+                .getAsString()));
     }
 
     // We can skip the ID of the return activity here, we'll just add it during
@@ -1774,7 +1804,7 @@ bool translation_unit_visitor::VisitCoyieldExpr(clang::CoyieldExpr *expr)
 
     message m{message_t::kCoYield, context().caller_id()};
 
-    set_source_location(*expr, m);
+    set_source_location(*expr, m.location());
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
         source_manager(), *context().get_ast_context(), expr);
@@ -1786,22 +1816,24 @@ bool translation_unit_visitor::VisitCoyieldExpr(clang::CoyieldExpr *expr)
 
     if (expr->getOperand() != nullptr) {
         std::string message_name = common::to_string(expr->getOperand());
-        m.set_message_name(util::condense_whitespace(message_name));
+        m.set_message_name(
+            diagram().intern(util::condense_whitespace(message_name)));
     }
 
     if (context().current_function_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_function_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_function_decl_->getReturnType().getAsString()));
     }
     else if (context().current_function_template_decl_ != nullptr) {
-        m.set_return_type(context()
-                .current_function_template_decl_->getAsFunction()
-                ->getReturnType()
-                .getAsString());
+        m.set_return_type(
+            diagram().intern(context()
+                    .current_function_template_decl_->getAsFunction()
+                    ->getReturnType()
+                    .getAsString()));
     }
     else if (context().current_method_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_method_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_method_decl_->getReturnType().getAsString()));
     }
 
     // We can skip the ID of the return activity here, we'll just add it during
@@ -1840,7 +1872,7 @@ bool translation_unit_visitor::VisitCoreturnStmt(clang::CoreturnStmt *stmt)
 
     message m{message_t::kCoReturn, context().caller_id()};
 
-    set_source_location(*stmt, m);
+    set_source_location(*stmt, m.location());
 
     const auto *raw_expr_comment = clanguml::common::get_expression_raw_comment(
         source_manager(), *context().get_ast_context(), stmt);
@@ -1852,26 +1884,29 @@ bool translation_unit_visitor::VisitCoreturnStmt(clang::CoreturnStmt *stmt)
 
     if (stmt->getOperand() != nullptr) {
         std::string message_name = common::to_string(stmt->getOperand());
-        m.set_message_name(util::condense_whitespace(message_name));
+        m.set_message_name(
+            diagram().intern(util::condense_whitespace(message_name)));
     }
 
     if (context().current_function_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_function_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_function_decl_->getReturnType().getAsString()));
     }
     else if (context().current_function_template_decl_ != nullptr) {
-        m.set_return_type(context()
-                .current_function_template_decl_->getAsFunction()
-                ->getReturnType()
-                .getAsString());
+        m.set_return_type(
+            diagram().intern(context()
+                    .current_function_template_decl_->getAsFunction()
+                    ->getReturnType()
+                    .getAsString()));
     }
     else if (context().current_method_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_method_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_method_decl_->getReturnType().getAsString()));
     }
     else if (context().current_objc_method_decl_ != nullptr) {
-        m.set_return_type(
-            context().current_objc_method_decl_->getReturnType().getAsString());
+        m.set_return_type(diagram().intern(
+            context().current_objc_method_decl_->getReturnType()
+                .getAsString()));
     }
 
     // We can skip the ID of the return activity here, we'll just add it during
@@ -1959,7 +1994,7 @@ bool translation_unit_visitor::VisitCXXConstructExpr(
 
     m.in_static_declaration_context(within_static_variable_declaration_ > 0);
 
-    set_source_location(*expr, m);
+    set_source_location(*expr, m.location());
 
     if (context().is_expr_in_current_control_statement_condition(expr)) {
         m.set_message_scope(common::model::message_scope_t::kCondition);
@@ -2001,13 +2036,15 @@ bool translation_unit_visitor::process_cuda_kernel_call_expression(
 
     // Skip free functions declared in files outside of included paths
     if (config().combine_free_functions_into_file_participants() &&
-        !diagram().should_include(common::model::source_file{m.file()}))
+        !diagram().should_include(
+            common::model::source_file{m.location().file()}))
         return false;
 
     auto callee_name = callee_function->getQualifiedNameAsString() + "()";
 
     m.set_to(id_mapper().resolve_or(eid_t{callee_function->getID()}));
-    m.set_message_name(callee_name.substr(0, callee_name.size() - 2));
+    m.set_message_name(
+        diagram().intern(callee_name.substr(0, callee_name.size() - 2)));
 
     return true;
 }
@@ -2044,8 +2081,8 @@ bool translation_unit_visitor::process_operator_call_expression(
         m.set_to(id_mapper().resolve_or(eid_t{operator_ast_id}));
     }
 
-    m.set_message_name(fmt::format(
-        "operator{}", getOperatorSpelling(operator_call_expr->getOperator())));
+    m.set_message_name(diagram().intern(fmt::format(
+        "operator{}", getOperatorSpelling(operator_call_expr->getOperator()))));
 
     return true;
 }
@@ -2067,9 +2104,9 @@ bool translation_unit_visitor::process_construct_expression(
         construct_expr->getBeginLoc().printToString(source_manager()));
 
     m.set_to(id_mapper().resolve_or(eid_t{constructor->getID()}));
-    m.set_message_name(
+    m.set_message_name(diagram().intern(
         fmt::format("{}::{}", constructor_parent->getQualifiedNameAsString(),
-            constructor_parent->getNameAsString()));
+            constructor_parent->getNameAsString())));
 
     diagram().add_active_participant(eid_t{constructor->getID()});
 
@@ -2110,10 +2147,10 @@ bool translation_unit_visitor::process_objc_message_expression(
         m.set_to(eid_t{method_decl->getID()});
     }
 
-    m.set_message_name(method_decl->getNameAsString());
-    m.set_return_type(
+    m.set_message_name(diagram().intern(method_decl->getNameAsString()));
+    m.set_return_type(diagram().intern(
         message_expr->getCallReturnType(*context().get_ast_context())
-            .getAsString());
+            .getAsString()));
 
     LOG_TRACE("Set callee ObjC method id {} for method name {}", m.to(),
         method_decl->getQualifiedNameAsString());
@@ -2144,10 +2181,10 @@ bool translation_unit_visitor::process_class_method_call_expression(
         return false;
 
     m.set_to(eid_t{method_decl->getID()});
-    m.set_message_name(method_decl->getNameAsString());
-    m.set_return_type(
+    m.set_message_name(diagram().intern(method_decl->getNameAsString()));
+    m.set_return_type(diagram().intern(
         method_call_expr->getCallReturnType(*context().get_ast_context())
-            .getAsString());
+            .getAsString()));
 
     LOG_TRACE("Set callee method id {} for method name {}", m.to(),
         method_decl->getQualifiedNameAsString());
@@ -2224,8 +2261,8 @@ bool translation_unit_visitor::process_class_template_method_call_expression(
                     return false;
             }
 
-            m.set_message_name(
-                dependent_member_callee->getMember().getAsString());
+            m.set_message_name(diagram().intern(
+                dependent_member_callee->getMember().getAsString()));
 
             if (const auto maybe_id =
                     get_unique_id(eid_t{template_declaration->getID()});
@@ -2260,13 +2297,15 @@ bool translation_unit_visitor::process_function_call_expression(
 
     // Skip free functions declared in files outside of included paths
     if (config().combine_free_functions_into_file_participants() &&
-        !diagram().should_include(common::model::source_file{m.file()}))
+        !diagram().should_include(
+            common::model::source_file{m.location().file()}))
         return false;
 
     auto callee_name = callee_function->getQualifiedNameAsString() + "()";
 
     m.set_to(id_mapper().resolve_or(eid_t{callee_function->getID()}));
-    m.set_message_name(callee_name.substr(0, callee_name.size() - 2));
+    m.set_message_name(
+        diagram().intern(callee_name.substr(0, callee_name.size() - 2)));
 
     return true;
 }
@@ -2785,35 +2824,53 @@ void translation_unit_visitor::push_message(
     co_await_stmt_message_map_.emplace(expr, std::move(m));
 }
 
+namespace {
+/**
+ * @brief Remove the message generated from an AST node from the map.
+ *
+ * @return Message generated from the node, if any
+ */
+template <typename MapT>
+std::optional<model::message> take_message(
+    MapT &messages, const typename MapT::key_type &key)
+{
+    const auto it = messages.find(key);
+    if (it == messages.end())
+        return {};
+
+    auto msg = std::move(it->second);
+    messages.erase(it);
+
+    return msg;
+}
+} // namespace
+
 void translation_unit_visitor::pop_message_to_diagram(clang::CallExpr *expr)
 {
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (call_expr_message_map_.find(expr) == call_expr_message_map_.end()) {
-        return;
-    }
-
-    if (call_expr_message_map_.at(expr).empty())
+    const auto it = call_expr_message_map_.find(expr);
+    if (it == call_expr_message_map_.end())
         return;
 
-    while (!call_expr_message_map_.at(expr).empty()) {
-        auto msg = call_expr_message_map_.at(expr).front();
-
-        auto caller_id = msg.from();
+    auto &messages = it->second;
+    while (!messages.empty()) {
+        auto caller_id = messages.front().from();
 
         if (caller_id == 0)
             return;
 
         if (diagram().has_activity(caller_id))
-            diagram().get_activity(caller_id).add_message(std::move(msg));
+            diagram().get_activity(caller_id).add_message(
+                std::move(messages.front()));
         else
             LOG_DBG("Skipping message due to missing activity: {}", caller_id);
 
-        call_expr_message_map_.at(expr).pop_front();
+        messages.pop_front();
     }
 
-    call_expr_message_map_.erase(expr);
+    call_expr_message_map_.erase(it);
 }
 
 void translation_unit_visitor::pop_message_to_diagram(
@@ -2822,52 +2879,26 @@ void translation_unit_visitor::pop_message_to_diagram(
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (construct_expr_message_map_.find(expr) ==
-        construct_expr_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(construct_expr_message_map_.at(expr));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    construct_expr_message_map_.erase(expr);
+    if (auto msg = take_message(construct_expr_message_map_, expr); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::pop_message_to_diagram(clang::ReturnStmt *stmt)
 {
     assert(stmt != nullptr);
 
-    // Skip if no message was generated from this expr
-    if (return_stmt_message_map_.find(stmt) == return_stmt_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(return_stmt_message_map_.at(stmt));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    return_stmt_message_map_.erase(stmt);
+    // Skip if no message was generated from this stmt
+    if (auto msg = take_message(return_stmt_message_map_, stmt); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::pop_message_to_diagram(clang::CoreturnStmt *stmt)
 {
     assert(stmt != nullptr);
 
-    // Skip if no message was generated from this expr
-    if (co_return_stmt_message_map_.find(stmt) ==
-        co_return_stmt_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(co_return_stmt_message_map_.at(stmt));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    co_return_stmt_message_map_.erase(stmt);
+    // Skip if no message was generated from this stmt
+    if (auto msg = take_message(co_return_stmt_message_map_, stmt); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::pop_message_to_diagram(clang::CoyieldExpr *expr)
@@ -2875,17 +2906,8 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CoyieldExpr *expr)
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (co_yield_stmt_message_map_.find(expr) ==
-        co_yield_stmt_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(co_yield_stmt_message_map_.at(expr));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    co_yield_stmt_message_map_.erase(expr);
+    if (auto msg = take_message(co_yield_stmt_message_map_, expr); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::pop_message_to_diagram(clang::CoawaitExpr *expr)
@@ -2893,17 +2915,8 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CoawaitExpr *expr)
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (co_await_stmt_message_map_.find(expr) ==
-        co_await_stmt_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(co_await_stmt_message_map_.at(expr));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    co_await_stmt_message_map_.erase(expr);
+    if (auto msg = take_message(co_await_stmt_message_map_, expr); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::pop_message_to_diagram(
@@ -2912,16 +2925,8 @@ void translation_unit_visitor::pop_message_to_diagram(
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (objc_message_map_.find(expr) == objc_message_map_.end()) {
-        return;
-    }
-
-    auto msg = std::move(objc_message_map_.at(expr));
-
-    auto caller_id = msg.from();
-    diagram().get_activity(caller_id).add_message(std::move(msg));
-
-    objc_message_map_.erase(expr);
+    if (auto msg = take_message(objc_message_map_, expr); msg)
+        diagram().get_activity(msg->from()).add_message(std::move(*msg));
 }
 
 void translation_unit_visitor::finalize()
@@ -2952,7 +2957,7 @@ void translation_unit_visitor::ensure_lambda_messages_have_operator_as_target()
                     m.to(), participant.value().lambda_operator_id());
 
                 m.set_to(participant.value().lambda_operator_id());
-                m.set_message_name("operator()");
+                m.set_message_name(diagram().intern("operator()"));
 
                 ensure_activity_exists(m);
             }
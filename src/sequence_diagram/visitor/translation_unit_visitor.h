@@ -28,6 +28,7 @@
 #include <clang/Basic/SourceManager.h>
 
 #include <deque>
+#include <unordered_map>
 
 namespace clanguml::sequence_diagram::visitor {
 
@@ -289,6 +290,17 @@ public:
         const clang::NamedDecl *decl) const;
 
 private:
+    /**
+     * @brief Check whether messages should be built from function's body
+     *
+     * If the diagram has a set of reachable functions computed from its
+     * call graph, bodies of other functions are skipped entirely.
+     *
+     * @param declaration Function declaration
+     * @return True, if the function should be traversed
+     */
+    bool should_analyze_function(const clang::FunctionDecl *declaration) const;
+
     /**
      * @brief Get existing participant or fallback to provided model
      *
@@ -597,17 +609,25 @@ private:
      * This is used to generate messages in proper order in case of nested call
      * expressions (e.g. a(b(c(), d())), as they need to be added to the diagram
      * sequence after the visitor leaves the call expression AST node
+     *
+     * The maps are only ever looked up by the AST node pointer, so hash maps
+     * are used instead of ordered maps.
      */
-    std::map<clang::CallExpr *, std::deque<model::message>>
+    std::unordered_map<clang::CallExpr *, std::deque<model::message>>
         call_expr_message_map_;
-    std::map<clang::ReturnStmt *, model::message> return_stmt_message_map_;
-    std::map<clang::CoreturnStmt *, model::message> co_return_stmt_message_map_;
-    std::map<clang::CoyieldExpr *, model::message> co_yield_stmt_message_map_;
-    std::map<clang::CoawaitExpr *, model::message> co_await_stmt_message_map_;
-
-    std::map<clang::CXXConstructExpr *, model::message>
+    std::unordered_map<clang::ReturnStmt *, model::message>
+        return_stmt_message_map_;
+    std::unordered_map<clang::CoreturnStmt *, model::message>
+        co_return_stmt_message_map_;
+    std::unordered_map<clang::CoyieldExpr *, model::message>
+        co_yield_stmt_message_map_;
+    std::unordered_map<clang::CoawaitExpr *, model::message>
+        co_await_stmt_message_map_;
+
+    std::unordered_map<clang::CXXConstructExpr *, model::message>
         construct_expr_message_map_;
-    std::map<clang::ObjCMessageExpr *, model::message> objc_message_map_;
+    std::unordered_map<clang::ObjCMessageExpr *, model::message>
+        objc_message_map_;
 
     std::map<eid_t, std::unique_ptr<clanguml::sequence_diagram::model::class_>>
         forward_declarations_;
@@ -40,6 +40,11 @@ public:
     using std::runtime_error::runtime_error;
 };
 
+class model_serialization_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
 class diagram_generation_error : public std::runtime_error {
 public:
     diagram_generation_error(common::model::diagram_t type, std::string name,
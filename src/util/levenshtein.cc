@@ -18,52 +18,164 @@
 
 #include "levenshtein.h"
 
+#include <algorithm>
+
 namespace clanguml::util {
 
-size_t levenshtein_distance(const std::string &left, const std::string &right)
+namespace {
+constexpr size_t kWordSize{64};
+constexpr size_t kAlphabetSize{256};
+constexpr uint64_t kHighBit{uint64_t{1} << (kWordSize - 1)};
+} // namespace
+
+levenshtein_matcher::levenshtein_matcher(std::string_view pattern)
+    : size_{pattern.size()}
+    , blocks_{(pattern.size() + kWordSize - 1) / kWordSize}
+    , peq_(blocks_ * kAlphabetSize, 0)
 {
-    const size_t m = left.size();
-    const size_t n = right.size();
+    for (size_t i = 0; i < pattern.size(); i++) {
+        const auto c = static_cast<unsigned char>(pattern[i]);
+        peq_[(i / kWordSize) * kAlphabetSize + c] |= uint64_t{1}
+            << (i % kWordSize);
+    }
+}
+
+size_t levenshtein_matcher::distance(
+    std::string_view text, size_t max_distance) const
+{
+    if (size_ == 0)
+        return text.size();
+
+    // Vertical positive and negative deltas of the current column of the
+    // dynamic programming matrix, for each block of the pattern
+    std::vector<uint64_t> pv(blocks_, ~uint64_t{0});
+    std::vector<uint64_t> mv(blocks_, 0);
+
+    const auto last_bit = uint64_t{1} << ((size_ - 1) % kWordSize);
 
-    std::vector<std::vector<size_t>> dp(m + 1, std::vector<size_t>(n + 1, 0));
+    // Distance between the whole pattern and the text prefix
+    size_t score = size_;
 
-    for (size_t i = 0; i <= m; ++i)
-        dp[i][0] = i;
-    for (size_t j = 0; j <= n; ++j)
-        dp[0][j] = j;
+    for (size_t j = 0; j < text.size(); j++) {
+        const auto c = static_cast<unsigned char>(text[j]);
 
-    for (size_t i = 1; i <= m; ++i) {
-        for (size_t j = 1; j <= n; ++j) {
-            int substitution_cost = (left[i - 1] == right[j - 1]) ? 0 : 1;
-            dp[i][j] = std::min({dp[i - 1][j] + 1, dp[i][j - 1] + 1,
-                dp[i - 1][j - 1] + substitution_cost});
+        // Horizontal delta entering the top of the block, in the first
+        // row of the matrix it is always +1
+        int carry{1};
+
+        for (size_t b = 0; b < blocks_; b++) {
+            auto eq = peq_[b * kAlphabetSize + c];
+            const auto xv = eq | mv[b];
+            if (carry < 0)
+                eq |= 1U;
+            const auto xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            auto ph = mv[b] | ~(xh | pv[b]);
+            auto mh = pv[b] & xh;
+
+            if (b + 1 == blocks_) {
+                if ((ph & last_bit) != 0U)
+                    score++;
+                else if ((mh & last_bit) != 0U)
+                    score--;
+            }
+
+            const int carry_out =
+                (ph & kHighBit) != 0U ? 1 : ((mh & kHighBit) != 0U ? -1 : 0);
+
+            ph <<= 1U;
+            mh <<= 1U;
+            if (carry < 0)
+                mh |= 1U;
+            else if (carry > 0)
+                ph |= 1U;
+
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+
+            carry = carry_out;
         }
+
+        // The distance can decrease by at most 1 for each remaining
+        // character of the text
+        const auto remaining = text.size() - j - 1;
+        if (score > max_distance && score - max_distance > remaining)
+            return score - remaining;
     }
 
-    return dp[m][n];
+    return score;
+}
+
+size_t levenshtein_distance(const std::string &left, const std::string &right)
+{
+    // Preprocess the shorter string to minimize the number of blocks
+    if (left.size() < right.size())
+        return levenshtein_matcher{left}.distance(right);
+
+    return levenshtein_matcher{right}.distance(left);
 }
 
 std::vector<std::string> get_approximate_matches(
     const std::vector<std::string> &collection, const std::string &pattern,
     const int max_results)
 {
-    std::vector<std::pair<size_t, std::string>> distance_pairs;
+    std::vector<std::string> result;
+
+    if (max_results <= 0)
+        return result;
+
+    const auto result_count = static_cast<size_t>(max_results);
+
+    const levenshtein_matcher matcher{pattern};
+
+    // Best distinct matches found so far, ordered by distance and then by
+    // the order in the collection
+    std::vector<std::pair<size_t, const std::string *>> matches;
+    matches.reserve(result_count + 1);
 
     for (const auto &item : collection) {
-        auto distance = levenshtein_distance(item, pattern);
-        distance_pairs.emplace_back(distance, item);
-    }
+        const bool full = matches.size() == result_count;
 
-    std::sort(distance_pairs.begin(), distance_pairs.end(),
-        [](const auto &a, const auto &b) { return a.first < b.first; });
+        // All kept matches are exact, so no further item can replace them
+        if (full && matches.back().first == 0)
+            break;
 
-    std::vector<std::string> result;
-    for (size_t i = 0; i < std::min<size_t>(distance_pairs.size(), max_results);
-        ++i) {
-        result.push_back(distance_pairs[i].second);
+        // Only matches closer than the current worst one are of interest,
+        // which lets the matcher give up early on most of the items
+        const auto max_distance = full
+            ? matches.back().first - 1
+            : std::numeric_limits<size_t>::max();
+
+        const auto length_difference = item.size() > pattern.size()
+            ? item.size() - pattern.size()
+            : pattern.size() - item.size();
+
+        if (full && length_difference > max_distance)
+            continue;
+
+        const auto distance = matcher.distance(item, max_distance);
+        if (distance > max_distance)
+            continue;
+
+        const auto it = std::upper_bound(matches.begin(), matches.end(),
+            distance, [](size_t d, const auto &m) { return d < m.first; });
+
+        // Duplicate items have the same distance, and the first one is
+        // already among the matches
+        if (std::any_of(matches.begin(), it,
+                [&item](const auto &m) { return *m.second == item; }))
+            continue;
+
+        matches.emplace(it, distance, &item);
+
+        if (matches.size() > result_count)
+            matches.pop_back();
     }
 
+    result.reserve(matches.size());
+    for (const auto &[distance, item] : matches)
+        result.push_back(*item);
+
     return result;
 }
 
-} // namespace clanguml::util
\ No newline at end of file
+} // namespace clanguml::util
@@ -20,11 +20,47 @@
 #include <stdexcept>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace clanguml::util {
 
+/**
+ * @brief Levenshtein distance calculator for a fixed pattern.
+ *
+ * Uses the bit-parallel algorithm by Myers, in the block based variant by
+ * Hyyrö, which computes the distance in O(ceil(m/64) * n) time, where `m`
+ * is the length of the pattern and `n` is the length of the text. The
+ * pattern is preprocessed once, so the matcher should be reused when
+ * comparing the same pattern against many strings.
+ */
+class levenshtein_matcher {
+public:
+    explicit levenshtein_matcher(std::string_view pattern);
+
+    /**
+     * @brief Compute the Levenshtein distance between the pattern and text.
+     *
+     * @param text Text to compare the pattern with
+     * @param max_distance Maximum distance of interest - if the distance is
+     *                     larger, the computation can stop early and return
+     *                     any value larger than `max_distance`
+     * @return Levenshtein distance
+     */
+    size_t distance(std::string_view text,
+        size_t max_distance = std::numeric_limits<size_t>::max()) const;
+
+private:
+    size_t size_;
+    size_t blocks_;
+    /** Match masks of each character for each 64 character pattern block */
+    std::vector<uint64_t> peq_;
+};
+
 /**
  * @brief Compute the Levenshtein distance between two strings.
  *
@@ -37,16 +73,20 @@ size_t levenshtein_distance(const std::string &left, const std::string &right);
 /**
  * @brief Find most similar strings in collection
  *
- * Returns at most three strings from `items` that are closest to `pattern`
- * based on Levenshtein distance.
+ * Returns at most `max_results` distinct strings from `items` that are
+ * closest to `pattern` based on Levenshtein distance, ordered by the
+ * distance.
+ *
+ * Once enough matches are found, the distance to each next item is only
+ * computed up to the distance of the worst match found so far, which lets
+ * the computation stop early for most of the items.
  *
  * @param collection Input collection
  * @param pattern Pattern to match against items in collection
  * @return List of most similar items from collection
  */
-
 std::vector<std::string> get_approximate_matches(
     const std::vector<std::string> &collection, const std::string &pattern,
     int max_results = 3);
 
-} // namespace clanguml::util
\ No newline at end of file
+} // namespace clanguml::util
@@ -0,0 +1,110 @@
+/**
+ * @file src/util/mapped_file.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace clanguml::util {
+
+mapped_file::mapped_file(const std::filesystem::path &path)
+{
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error(
+            fmt::format("Cannot open file {}", path.string()));
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error(
+            fmt::format("Cannot read size of file {}", path.string()));
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // Empty files cannot be mapped
+    if (size_ > 0) {
+        address_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address_ == MAP_FAILED) {
+            address_ = nullptr;
+            ::close(fd);
+            throw std::runtime_error(
+                fmt::format("Cannot map file {}", path.string()));
+        }
+    }
+
+    ::close(fd);
+#else
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs)
+        throw std::runtime_error(
+            fmt::format("Cannot open file {}", path.string()));
+
+    contents_.assign(std::istreambuf_iterator<char>{ifs},
+        std::istreambuf_iterator<char>{});
+#endif
+}
+
+mapped_file::~mapped_file()
+{
+#if !defined(_WIN32)
+    if (address_ != nullptr)
+        ::munmap(address_, size_);
+#endif
+}
+
+std::string_view mapped_file::data() const
+{
+    if (address_ != nullptr)
+        return {static_cast<const char *>(address_), size_};
+
+    return contents_;
+}
+
+void write_file_atomically(
+    const std::filesystem::path &path, std::string_view contents)
+{
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream ofs{tmp_path, std::ios::binary | std::ios::trunc};
+        ofs.write(
+            contents.data(), static_cast<std::streamsize>(contents.size()));
+        if (!ofs)
+            throw std::runtime_error(
+                fmt::format("Cannot write file {}", tmp_path.string()));
+    }
+
+    std::filesystem::rename(tmp_path, path);
+}
+
+} // namespace clanguml::util
@@ -0,0 +1,77 @@
+/**
+ * @file src/util/mapped_file.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace clanguml::util {
+
+/**
+ * @brief Read-only view of an entire file contents.
+ *
+ * On POSIX systems the file is memory mapped, so that its contents are
+ * only paged in when accessed, otherwise the file is read into memory.
+ */
+class mapped_file {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param path Path to the file
+     * @throws std::runtime_error If the file cannot be opened or mapped
+     */
+    explicit mapped_file(const std::filesystem::path &path);
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file(mapped_file &&) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+    mapped_file &operator=(mapped_file &&) = delete;
+
+    ~mapped_file();
+
+    /**
+     * @brief Get the contents of the file.
+     *
+     * The view is valid as long as this object is alive.
+     *
+     * @return Contents of the file
+     */
+    std::string_view data() const;
+
+private:
+    void *address_{nullptr};
+    std::size_t size_{0};
+    std::string contents_;
+};
+
+/**
+ * @brief Write `contents` to a file, replacing it if it exists.
+ *
+ * The contents are written to a temporary file first, which is then
+ * renamed, so that readers never see a partially written file.
+ *
+ * @param path Path to the file
+ * @param contents Contents to write
+ * @throws std::runtime_error If the file cannot be written
+ */
+void write_file_atomically(
+    const std::filesystem::path &path, std::string_view contents);
+
+} // namespace clanguml::util
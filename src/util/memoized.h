@@ -17,14 +17,139 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace clanguml::util {
+namespace detail {
+/**
+ * @brief Get mutex guarding computation of a memoized value.
+ *
+ * Memoized values are embedded in model elements, so instead of a mutex per
+ * value, they share a fixed pool of mutexes selected by their address.
+ *
+ * @param value Address of the memoized value
+ * @return Reference to the mutex
+ */
+inline std::mutex &memoization_mutex(const void *value)
+{
+    constexpr std::size_t kMutexCount{64};
+    static std::array<std::mutex, kMutexCount> mutexes;
+
+    return mutexes[std::hash<const void *>{}(value) % kMutexCount];
+}
+
+template <typename V> std::size_t hash_value_of(const V &v)
+{
+    if constexpr (std::is_same_v<V, std::filesystem::path>)
+        return std::filesystem::hash_value(v);
+    else
+        return std::hash<V>{}(v);
+}
+} // namespace detail
+
+/**
+ * @brief Value computed once, which can be read concurrently.
+ *
+ * Once the value is computed, reading it only requires checking an atomic
+ * flag, which makes it suitable for model elements which are read by
+ * multiple threads after they are complete. The value is computed outside
+ * of any lock, as computing it can read other memoized values, and only
+ * published under a lock - concurrent first reads may compute the value
+ * more than once, however only the first result is stored.
+ *
+ * Invalidating the value must not happen concurrently with reading it.
+ *
+ * @tparam Ret Type of the memoized value
+ */
+template <typename Ret> class memoized_value {
+public:
+    memoized_value() = default;
+
+    memoized_value(const memoized_value &other) { *this = other; }
+
+    memoized_value &operator=(const memoized_value &other)
+    {
+        if (this == &other)
+            return *this;
+
+        if (other.valid_.load(std::memory_order_acquire)) {
+            value_ = other.value_;
+            valid_.store(true, std::memory_order_release);
+        }
+        else {
+            invalidate();
+        }
+
+        return *this;
+    }
+
+    ~memoized_value() = default;
+
+    /**
+     * @brief Get the value, computing it if necessary.
+     *
+     * If `is_complete` is false, the value is recomputed on each call and
+     * not marked as valid - this can only be used before the value is shared
+     * between threads.
+     *
+     * @param is_complete Whether the computed value can be cached
+     * @param f Function computing the value
+     * @return Reference to the value, valid until the next invalidation
+     */
+    template <typename F> const Ret &get(bool is_complete, F &&f) const
+    {
+        if (!is_complete) {
+            valid_.store(false, std::memory_order_relaxed);
+            value_ = f();
+            return *value_; // NOLINT
+        }
+
+        if (!valid_.load(std::memory_order_acquire)) {
+            auto value = f();
+
+            std::lock_guard<std::mutex> l{detail::memoization_mutex(this)};
+            if (!valid_.load(std::memory_order_relaxed)) {
+                value_ = std::move(value);
+                valid_.store(true, std::memory_order_release);
+            }
+        }
+
+        return *value_; // NOLINT
+    }
+
+    /**
+     * @brief Check whether the value has been computed.
+     */
+    bool valid() const { return valid_.load(std::memory_order_acquire); }
+
+    void invalidate() const { valid_.store(false, std::memory_order_release); }
+
+private:
+    mutable std::atomic<bool> valid_{false};
+    mutable std::optional<Ret> value_;
+};
+
 /**
  * @brief Simple memoization implementation for expensive methods.
  *
+ * The cache is split into shards, selected by the hash of the arguments,
+ * each guarded by a shared mutex. Cached results are looked up under
+ * a shared lock, so once most results are computed the cache can be
+ * read concurrently by many threads with little contention. Results are
+ * computed outside of any lock, so concurrent callers may compute the same
+ * result, however only the first one is stored.
+ *
  * @tparam T Tag type to allow multiple memoizations per class
  * @tparam Ret Return type of the memoized method F
  * @tparam Args Arguments the memoized method F
@@ -34,23 +159,81 @@ public:
     using key_t = std::tuple<Args...>;
     using value_t = Ret;
 
+    memoized() = default;
+
+    memoized(const memoized &other) { *this = other; }
+
+    memoized &operator=(const memoized &other)
+    {
+        if (this == &other)
+            return *this;
+
+        for (auto i = 0U; i < kShardCount; i++) {
+            std::shared_lock<std::shared_mutex> ol{other.shards_[i].mutex};
+            std::unique_lock<std::shared_mutex> l{shards_[i].mutex};
+            shards_[i].cache = other.shards_[i].cache;
+        }
+
+        return *this;
+    }
+
+    ~memoized() = default;
+
     template <typename F>
     auto memoize(bool is_complete, F &&f, Args... args) const
     {
         if (!is_complete)
             return f(std::forward<Args>(args)...);
 
-        const auto key = key_t{std::forward<Args>(args)...};
-        if (cache_.find(key) == cache_.end())
-            cache_[key] = std::apply(f, key);
+        auto key = key_t{std::forward<Args>(args)...};
+        auto &shard = shard_for(key);
 
-        return cache_.at(key);
+        {
+            std::shared_lock<std::shared_mutex> l{shard.mutex};
+            if (auto it = shard.cache.find(key); it != shard.cache.end())
+                return it->second;
+        }
+
+        auto value = std::apply(f, key);
+
+        std::unique_lock<std::shared_mutex> l{shard.mutex};
+        return shard.cache.try_emplace(std::move(key), std::move(value))
+            .first->second;
     }
 
-    void invalidate(Args... args) const { cache_.erase(args...); }
+    void invalidate(Args... args) const
+    {
+        auto key = key_t{std::forward<Args>(args)...};
+        auto &shard = shard_for(key);
+
+        std::unique_lock<std::shared_mutex> l{shard.mutex};
+        shard.cache.erase(key);
+    }
 
 private:
-    mutable std::map<key_t, value_t> cache_;
+    static constexpr std::size_t kShardCount{16};
+
+    struct shard {
+        std::shared_mutex mutex;
+        std::map<key_t, value_t> cache;
+    };
+
+    shard &shard_for(const key_t &key) const
+    {
+        const auto hash = std::apply(
+            [](const auto &...a) {
+                std::size_t seed{0};
+                ((seed ^= detail::hash_value_of(a) + 0x9e3779b9 + (seed << 6U) +
+                      (seed >> 2U)),
+                    ...);
+                return seed;
+            },
+            key);
+
+        return shards_[hash % kShardCount];
+    }
+
+    mutable std::array<shard, kShardCount> shards_;
 };
 
 template <typename T, typename Ret> class memoized<T, Ret> {
@@ -63,17 +246,13 @@ public:
         if (!is_complete)
             return f();
 
-        if (!value_) {
-            value_ = f();
-        }
-
-        return *value_; // NOLINT
+        return value_.get(true, f);
     }
 
-    void invalidate() const { value_.reset(); }
+    void invalidate() const { value_.invalidate(); }
 
 private:
-    mutable std::optional<Ret> value_;
+    memoized_value<Ret> value_;
 };
 
 template <typename T, typename Ret> class memoized<T, Ret, bool> {
@@ -86,28 +265,21 @@ public:
         if (!is_complete)
             return f(arg);
 
-        const auto key = arg;
-        if (key && !true_value_) {
-            true_value_ = f(arg);
-        }
-
-        if (!key && !false_value_) {
-            false_value_ = f(arg);
-        }
-
-        return key ? *true_value_ : *false_value_; // NOLINT
+        return (arg ? true_value_ : false_value_).get(true, [&f, arg]() {
+            return f(arg);
+        });
     }
 
     void invalidate(bool key) const
     {
         if (key)
-            true_value_.reset();
+            true_value_.invalidate();
         else
-            false_value_.reset();
+            false_value_.invalidate();
     }
 
 private:
-    mutable std::optional<Ret> true_value_;
-    mutable std::optional<Ret> false_value_;
+    memoized_value<Ret> true_value_;
+    memoized_value<Ret> false_value_;
 };
-} // namespace clanguml::util
\ No newline at end of file
+} // namespace clanguml::util
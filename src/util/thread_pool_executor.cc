@@ -18,72 +18,231 @@
 
 #include "thread_pool_executor.h"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
 namespace clanguml::util {
 
+namespace {
+constexpr auto kNoWorker = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Pool and index of the worker running on the current thread.
+ */
+struct current_worker_t {
+    thread_pool_executor *pool{nullptr};
+    std::size_t index{kNoWorker};
+};
+
+thread_local current_worker_t current_worker;
+} // namespace
+
 thread_pool_executor::thread_pool_executor(unsigned int pool_size)
-    : done_{false}
 {
     if (pool_size == 0U)
-        pool_size = std::thread::hardware_concurrency();
+        pool_size = std::max(std::thread::hardware_concurrency(), 1U);
+
+    for (auto i = 0U; i < pool_size; i++)
+        queues_.emplace_back(std::make_unique<worker_queue>());
 
     for (auto i = 0U; i < pool_size; i++) {
-        threads_.emplace_back(&thread_pool_executor::worker, this);
+        threads_.emplace_back(&thread_pool_executor::worker, this, i);
     }
 }
 
 thread_pool_executor::~thread_pool_executor() { stop(); }
 
-std::future<void> thread_pool_executor::add(std::function<void()> &&task)
+std::future<void> thread_pool_executor::add(
+    std::function<void()> &&task, int64_t priority)
 {
-    std::unique_lock<std::mutex> l(tasks_mutex_);
-
-    std::packaged_task<void()> ptask{std::move(task)};
+    task_t ptask{std::move(task)};
     auto res = ptask.get_future();
 
-    tasks_.emplace_back(std::move(ptask));
+    if (current_worker.pool == this) {
+        auto &queue = *queues_[current_worker.index];
+
+        // The counters are only incremented once the task is in the queue,
+        // so that take() never decrements them below zero
+        std::lock_guard<std::mutex> l(queue.mutex);
+        auto it = std::upper_bound(queue.tasks.begin(), queue.tasks.end(),
+            priority,
+            [](int64_t p, const auto &t) { return p < t.first; });
+        queue.tasks.emplace(it, priority, std::move(ptask));
+        nested_pending_++;
+    }
+    else {
+        std::lock_guard<std::mutex> l(shared_mutex_);
+        shared_tasks_.emplace(
+            std::make_pair(-priority, shared_sequence_++), std::move(ptask));
+        shared_pending_++;
+    }
 
-    l.unlock();
-    tasks_cond_.notify_one();
+    notify(waiters_ > 0);
 
     return res;
 }
 
+void thread_pool_executor::wait(const std::future<void> &fut)
+{
+    if (current_worker.pool != this) {
+        fut.wait();
+        return;
+    }
+
+    const auto is_ready = [&fut] {
+        return fut.wait_for(std::chrono::seconds::zero()) ==
+            std::future_status::ready;
+    };
+
+    task_t task;
+    while (!is_ready()) {
+        if (take(current_worker.index, false, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> l(wake_mutex_);
+        waiters_++;
+        const auto completed = completed_.load();
+        if (!is_ready()) {
+            wake_cond_.wait(l, [this, completed] {
+                return completed_ != completed || nested_pending_ > 0;
+            });
+        }
+        waiters_--;
+    }
+}
+
 void thread_pool_executor::stop()
 {
     done_ = true;
+    notify(true);
+
     for (auto &thread : threads_) {
         if (thread.joinable())
             thread.join();
     }
 }
 
-void thread_pool_executor::worker()
+std::size_t thread_pool_executor::size() const { return threads_.size(); }
+
+thread_pool_executor *thread_pool_executor::current()
 {
-    try {
-        while (!done_) {
-            auto task = get();
+    return current_worker.pool;
+}
 
-            task();
+void thread_pool_executor::worker(std::size_t index)
+{
+    current_worker = {this, index};
+
+    task_t task;
+    while (true) {
+        if (take(index, true, task)) {
+            run(task);
+            continue;
         }
+
+        std::unique_lock<std::mutex> l(wake_mutex_);
+        wake_cond_.wait(l, [this] {
+            return done_ || shared_pending_ > 0 || nested_pending_ > 0;
+        });
+
+        // Tasks added before the pool was stopped are still executed
+        if (done_ && shared_pending_ == 0 && nested_pending_ == 0)
+            break;
     }
-    catch (std::runtime_error &e) {
+
+    current_worker = {};
+}
+
+bool thread_pool_executor::take(
+    std::size_t index, bool include_shared, task_t &task)
+{
+    // First run the most recent nested task of this worker
+    if (index != kNoWorker) {
+        auto &queue = *queues_[index];
+        std::lock_guard<std::mutex> l(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back().second);
+            queue.tasks.pop_back();
+            nested_pending_--;
+            return true;
+        }
     }
+
+    // Then steal from the front of the deques of other workers, which holds
+    // the lowest priority task (the oldest one among tasks with equal
+    // priority), leaving the most urgent tasks to their owners
+    for (auto i = 1U; i <= queues_.size(); i++) {
+        auto &queue = *queues_[(index + i) % queues_.size()];
+        std::lock_guard<std::mutex> l(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front().second);
+            queue.tasks.pop_front();
+            nested_pending_--;
+            return true;
+        }
+    }
+
+    if (include_shared) {
+        std::lock_guard<std::mutex> l(shared_mutex_);
+        if (!shared_tasks_.empty()) {
+            task = std::move(shared_tasks_.begin()->second);
+            shared_tasks_.erase(shared_tasks_.begin());
+            shared_pending_--;
+            return true;
+        }
+    }
+
+    return false;
 }
 
-std::packaged_task<void()> thread_pool_executor::get()
+void thread_pool_executor::run(task_t &task)
 {
-    std::unique_lock<std::mutex> l(tasks_mutex_);
+    task();
+    task = {};
 
-    while (tasks_.empty()) {
-        if (done_)
-            throw std::runtime_error("Thread pool closing...");
+    completed_++;
 
-        tasks_cond_.wait_for(l, std::chrono::seconds(1));
+    if (waiters_ > 0)
+        notify(true);
+}
+
+void run_nested(const std::vector<std::function<void()>> &tasks)
+{
+    auto *pool = thread_pool_executor::current();
+
+    if (pool == nullptr || pool->size() < 2 || tasks.size() < 2) {
+        for (const auto &task : tasks)
+            task();
+        return;
     }
 
-    auto res = std::move(tasks_.front());
-    tasks_.pop_front();
-    return res;
+    std::vector<std::future<void>> futs;
+    futs.reserve(tasks.size());
+    for (const auto &task : tasks)
+        futs.emplace_back(pool->add(std::function<void()>{task}));
+
+    // Wait for all tasks before rethrowing, as they can reference the
+    // caller's stack
+    for (const auto &fut : futs)
+        pool->wait(fut);
+
+    for (auto &fut : futs)
+        fut.get();
+}
+
+void thread_pool_executor::notify(bool all)
+{
+    {
+        std::lock_guard<std::mutex> l(wake_mutex_);
+    }
+
+    if (all)
+        wake_cond_.notify_all();
+    else
+        wake_cond_.notify_one();
 }
 
 } // namespace clanguml::util
@@ -17,22 +17,41 @@
  */
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace clanguml::util {
 
 /**
- * @brief Simple thread pool executor for parallelizing diagram generation.
+ * @brief Work-stealing thread pool executor for parallelizing diagram
+ *        generation.
+ *
+ * Tasks added from outside of the pool are kept in a shared queue ordered
+ * by priority. Tasks added from within a task running on the pool (nested
+ * tasks) are pushed to the deque of the current worker, which executes them
+ * in LIFO order, while idle workers steal the oldest tasks from the deques
+ * of other workers.
+ *
+ * Tasks running on the pool can wait for nested tasks using @ref wait(),
+ * which executes other nested tasks instead of blocking the worker thread.
  */
 class thread_pool_executor {
 public:
     /**
      * @brief Constructor
      *
-     * @param pool_size Number of threads in the pool
+     * @param pool_size Number of threads in the pool, if 0 the number of
+     *                  hardware threads is used
      */
     explicit thread_pool_executor(unsigned int pool_size);
 
@@ -46,28 +65,116 @@ public:
     /**
      * @brief Add a task to run on the pool.
      *
+     * Tasks with higher priority are started first, tasks with equal
+     * priority added from outside of the pool are started in the order in
+     * which they were added.
+     *
      * @param task Function to execute
+     * @param priority Priority of the task
      * @return Future, allowing awaiting the result
      */
-    std::future<void> add(std::function<void()> &&task);
+    std::future<void> add(std::function<void()> &&task, int64_t priority = 0);
+
+    /**
+     * @brief Wait until the future is ready.
+     *
+     * When called from a worker thread of this pool, nested tasks are
+     * executed while waiting, so that tasks can wait for their subtasks
+     * without exhausting the pool. Tasks from the shared queue are never
+     * executed this way, as they could require resources held by the
+     * waiting task.
+     *
+     * @param fut Future returned by @ref add()
+     */
+    void wait(const std::future<void> &fut);
 
     /**
      * @brief Join all active threads in the pool
+     *
+     * Tasks already added to the pool are executed before the threads exit.
      */
     void stop();
 
+    /**
+     * @brief Number of threads in the pool
+     *
+     * @return Number of threads
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the pool executing the current task
+     *
+     * @return Pointer to the pool, or nullptr if the calling thread is not
+     *         a worker thread of any pool
+     */
+    static thread_pool_executor *current();
+
 private:
+    using task_t = std::packaged_task<void()>;
+
+    /**
+     * @brief Deque of nested tasks owned by a single worker.
+     *
+     * The tasks are ordered by priority, with the highest priority task
+     * at the back.
+     */
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<std::pair<int64_t, task_t>> tasks;
+    };
+
     /**
      * @brief Main worker pool thread method - take task from queue and execute
      */
-    void worker();
+    void worker(std::size_t index);
+
+    /**
+     * @brief Take next task to execute by the current thread
+     *
+     * @param index Index of the current worker
+     * @param include_shared Whether tasks from the shared queue can be taken
+     * @param task Output task
+     * @return True, if a task was taken
+     */
+    bool take(std::size_t index, bool include_shared, task_t &task);
+
+    void run(task_t &task);
+
+    void notify(bool all);
 
-    std::packaged_task<void()> get();
+    std::atomic_bool done_{false};
+
+    /** Shared queue ordered by priority and sequence number */
+    std::map<std::pair<int64_t, uint64_t>, task_t> shared_tasks_;
+    uint64_t shared_sequence_{0};
+    std::mutex shared_mutex_;
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+
+    /** Number of tasks in the shared queue and in the worker queues */
+    std::atomic<std::size_t> shared_pending_{0};
+    std::atomic<std::size_t> nested_pending_{0};
+    /** Number of executed tasks, allows waiters to detect ready futures */
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<std::size_t> waiters_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cond_;
 
-    std::atomic_bool done_;
-    std::deque<std::packaged_task<void()>> tasks_;
-    std::mutex tasks_mutex_;
-    std::condition_variable tasks_cond_;
     std::vector<std::thread> threads_;
 };
-} // namespace clanguml::util
\ No newline at end of file
+
+/**
+ * @brief Run tasks as nested tasks of the pool executing the current task
+ *        and wait for all of them.
+ *
+ * If the calling thread is not a worker thread of a pool with more than
+ * one thread, the tasks are executed sequentially in the calling thread.
+ *
+ * If any of the tasks throws, the first exception (in the order of
+ * the tasks) is rethrown after all tasks have finished.
+ *
+ * @param tasks Tasks to execute
+ */
+void run_nested(const std::vector<std::function<void()>> &tasks);
+} // namespace clanguml::util
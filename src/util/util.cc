@@ -19,10 +19,20 @@
 
 #include <spdlog/spdlog.h>
 
+#include <ctime>
 #include <regex>
 #if __has_include(<sys/utsname.h>)
 #include <sys/utsname.h>
 #endif
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
 
 namespace clanguml::util {
 
@@ -226,6 +236,86 @@ std::string get_os_name()
 #endif
 }
 
+std::size_t get_peak_rss()
+{
+#if __has_include(<sys/resource.h>)
+    struct rusage usage; // NOLINT
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    // On macOS ru_maxrss is reported in bytes
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // On Linux and BSD's ru_maxrss is reported in kilobytes
+    const auto kKilobyte = 1024U;
+    return static_cast<std::size_t>(usage.ru_maxrss) * kKilobyte;
+#endif
+#else
+    return 0;
+#endif
+}
+
+std::size_t get_current_rss()
+{
+#if defined(__linux__)
+    // The second field of statm is the number of resident pages
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t size{0};
+    std::size_t resident{0};
+    if (!(statm >> size >> resident))
+        return 0;
+
+    const auto page_size = sysconf(_SC_PAGESIZE);
+    return page_size > 0 ? resident * static_cast<std::size_t>(page_size) : 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+            reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+
+    return static_cast<std::size_t>(info.resident_size);
+#else
+    return 0;
+#endif
+}
+
+std::chrono::nanoseconds get_thread_cpu_time()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts; // NOLINT
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return std::chrono::seconds{ts.tv_sec} +
+            std::chrono::nanoseconds{ts.tv_nsec};
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>{
+            static_cast<double>(std::clock()) / CLOCKS_PER_SEC});
+}
+
+std::chrono::nanoseconds get_process_cpu_time()
+{
+#if __has_include(<sys/resource.h>)
+    const auto to_ns = [](const struct timeval &tv) {
+        return std::chrono::seconds{tv.tv_sec} +
+            std::chrono::microseconds{tv.tv_usec};
+    };
+
+    std::chrono::nanoseconds result{};
+    for (const auto who : {RUSAGE_SELF, RUSAGE_CHILDREN}) {
+        struct rusage usage; // NOLINT
+        if (getrusage(who, &usage) == 0)
+            result += to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+    }
+    return result;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>{
+            static_cast<double>(std::clock()) / CLOCKS_PER_SEC});
+#endif
+}
+
 std::string ltrim(const std::string &s)
 {
     const size_t start = s.find_first_not_of(WHITESPACE);
@@ -417,6 +507,34 @@ template <> bool ends_with(const std::string &value, const std::string &suffix)
     return std::equal(suffix.rbegin(), suffix.rend(), value.rbegin());
 }
 
+std::uint64_t stable_hash(std::string_view str)
+{
+    constexpr std::uint64_t kFNVOffsetBasis{0xcbf29ce484222325ULL};
+    constexpr std::uint64_t kFNVPrime{0x100000001b3ULL};
+
+    std::uint64_t hash{kFNVOffsetBasis};
+    for (const auto c : str) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= kFNVPrime;
+    }
+
+    return hash;
+}
+
+const std::string &string_interner::intern(std::string str)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return *strings_.emplace(std::move(str)).first;
+}
+
+std::size_t string_interner::size() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return strings_.size();
+}
+
 std::size_t hash_seed(std::size_t seed)
 {
     constexpr auto kSeedStart{0x6a3712b5};
@@ -519,40 +637,106 @@ std::string format_message_comment(const std::string &comment, unsigned width)
     return result;
 }
 
-std::optional<std::pair<std::string, std::string>> find_entry_by_path_prefix(
-    const std::map<std::string, std::string> &m, const std::string &path)
+namespace {
+/**
+ * Components of a normalized path, without the trailing empty component
+ * of directory paths, and with `.` as an empty path.
+ */
+std::vector<std::string> normalized_path_components(
+    const std::filesystem::path &p)
 {
-    if (m.empty())
-        return {};
+    std::vector<std::string> result;
+    for (const auto &component : p.lexically_normal()) {
+        auto c = component.string();
+        if (c.empty() || c == ".")
+            continue;
+        result.emplace_back(std::move(c));
+    }
+
+    return result;
+}
+} // namespace
+
+path_prefix_map::path_prefix_map(const std::map<std::string, std::string> &m)
+    : nodes_(2)
+{
+    for (const auto &[key, value] : m) {
+        const std::filesystem::path key_path{key};
+
+        auto n = key_path.has_root_directory() ? kAbsoluteRoot : kRelativeRoot;
+        for (const auto &component : normalized_path_components(key_path)) {
+            // Keep the child index by value, as adding a node can
+            // reallocate `nodes_` along with the children maps
+            std::size_t child{};
+            if (auto it = nodes_[n].children.find(component);
+                it != nodes_[n].children.end()) {
+                child = it->second;
+            }
+            else {
+                child = nodes_.size();
+                nodes_[n].children.emplace(component, child);
+                nodes_.emplace_back();
+            }
+            n = child;
+        }
+
+        const auto index = entries_.size();
+        entries_.emplace_back(key, value);
 
-    // Extract keys and sort them by length in descending order
-    std::vector<std::string> keys;
-    keys.reserve(m.size());
-    for (const auto &[key, pattern] : m) {
-        keys.push_back(key);
+        // If multiple prefixes are equivalent, prefer the longest one
+        auto &entry = nodes_[n].entry;
+        if (!entry || entries_[*entry].first.size() < key.size())
+            entry = index;
+
+        if (key == ".")
+            default_entry_ = index;
     }
+}
 
-    std::sort(keys.begin(), keys.end(),
-        [](const std::string &a, const std::string &b) {
-            return a.size() > b.size();
-        });
+std::optional<std::pair<std::string, std::string>> path_prefix_map::find(
+    const std::string &path) const
+{
+    if (entries_.empty())
+        return {};
 
-    std::filesystem::path file_path{path};
+    const std::filesystem::path file_path{path};
+    const auto components = normalized_path_components(file_path);
 
-    for (const auto &key : keys) {
-        const auto &pattern = m.at(key);
-        std::filesystem::path key_path{key};
+    auto n = file_path.has_root_directory() ? kAbsoluteRoot : kRelativeRoot;
+    std::optional<std::size_t> match;
+    for (auto i = 0U; i <= components.size(); i++) {
+        // The remaining path cannot start with '.', as in is_relative_to()
+        if (nodes_[n].entry &&
+            (i == components.size() || components[i].front() != '.'))
+            match = nodes_[n].entry;
 
-        if (is_relative_to(file_path, key_path)) {
-            return {{key, pattern}};
-        }
+        if (i == components.size())
+            break;
+
+        const auto it = nodes_[n].children.find(components[i]);
+        if (it == nodes_[n].children.end())
+            break;
+
+        n = it->second;
     }
 
+    if (match)
+        return entries_[*match];
+
     if ((path.empty() || file_path.is_relative() || path == ".") &&
-        m.count(".") > 0) {
-        return {{".", m.at(".")}};
+        default_entry_) {
+        return entries_[*default_entry_];
     }
 
     return {};
 }
+
+std::optional<std::pair<std::string, std::string>> find_entry_by_path_prefix(
+    const std::map<std::string, std::string> &m, const std::string &path)
+{
+    if (m.empty())
+        return {};
+
+    return path_prefix_map{m}.find(path);
+}
 } // namespace clanguml::util
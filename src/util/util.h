@@ -20,12 +20,18 @@
 #include "logging.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace clanguml::util {
@@ -134,6 +140,40 @@ std::string get_git_toplevel_dir();
  */
 std::string get_os_name();
 
+/**
+ * @brief Get peak resident set size of the current process.
+ *
+ * @return Peak resident set size in bytes, or 0 if not supported on this
+ *         platform
+ */
+std::size_t get_peak_rss();
+
+/**
+ * @brief Get current resident set size of the current process.
+ *
+ * @return Resident set size in bytes, or 0 if not supported on this
+ *         platform
+ */
+std::size_t get_current_rss();
+
+/**
+ * @brief Get CPU time consumed so far by the calling thread.
+ *
+ * On platforms without per-thread CPU clocks, this falls back to the
+ * process CPU time.
+ *
+ * @return CPU time of the calling thread
+ */
+std::chrono::nanoseconds get_thread_cpu_time();
+
+/**
+ * @brief Get CPU time consumed so far by the current process, including
+ *        its terminated child processes.
+ *
+ * @return CPU time of the process and its children
+ */
+std::chrono::nanoseconds get_process_cpu_time();
+
 template <typename T, typename S>
 std::unique_ptr<T> unique_pointer_cast(std::unique_ptr<S> &&p) noexcept
 {
@@ -404,6 +444,48 @@ template <typename T> void remove_duplicates(T &coll)
  */
 std::size_t hash_seed(std::size_t seed);
 
+/**
+ * @brief Calculate 64-bit FNV-1a hash of a string.
+ *
+ * Unlike `std::hash`, the result is the same on all platforms and standard
+ * library implementations, so it can be used to generate persistent
+ * identifiers.
+ *
+ * @param str Input string
+ * @return Hash value
+ */
+std::uint64_t stable_hash(std::string_view str);
+
+/**
+ * @brief Thread-safe pool of unique strings.
+ *
+ * References returned by the interner remain valid for the lifetime of
+ * the interner, so that each distinct string is stored only once and can be
+ * shared between translation units and diagrams.
+ *
+ * Strings are never removed from the interner, so its memory is bounded only
+ * by the number of distinct strings passed to it during its lifetime.
+ */
+class string_interner {
+public:
+    /**
+     * @brief Get the interned copy of a string.
+     *
+     * @param str Input string
+     * @return Reference to the interned string
+     */
+    const std::string &intern(std::string str);
+
+    /**
+     * @brief Number of interned strings
+     */
+    std::size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_set<std::string> strings_;
+};
+
 /**
  * @brief Convert filesystem path to url path
  *
@@ -442,6 +524,48 @@ bool is_relative_to(
 std::string format_message_comment(
     const std::string &c, unsigned width = kDefaultMessageCommentWidth);
 
+/**
+ * @brief Map of path prefixes, which finds the longest prefix of a path.
+ *
+ * The prefixes are normalized and stored in a trie of path components, so
+ * that the lookup cost depends only on the length of the looked up path,
+ * and not on the number of prefixes in the map.
+ *
+ * A prefix matches a path in the same way as @ref is_relative_to, and the
+ * `.` prefix additionally matches any relative path.
+ */
+class path_prefix_map {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param m Map of path prefixes to values
+     */
+    explicit path_prefix_map(const std::map<std::string, std::string> &m);
+
+    /**
+     * @brief Find entry with the longest prefix of a path.
+     *
+     * @param path Path to find the prefix of
+     * @return Matching prefix and its value, if any
+     */
+    std::optional<std::pair<std::string, std::string>> find(
+        const std::string &path) const;
+
+private:
+    struct node {
+        std::unordered_map<std::string, std::size_t> children;
+        std::optional<std::size_t> entry;
+    };
+
+    static constexpr std::size_t kRelativeRoot{0};
+    static constexpr std::size_t kAbsoluteRoot{1};
+
+    std::vector<node> nodes_;
+    std::vector<std::pair<std::string, std::string>> entries_;
+    std::optional<std::size_t> default_entry_;
+};
+
 std::optional<std::pair<std::string, std::string>> find_entry_by_path_prefix(
     const std::map<std::string, std::string> &m, const std::string &prefix);
 } // namespace clanguml::util
\ No newline at end of file
@@ -16,6 +16,9 @@
  * limitations under the License.
  */
 
+#include "common/compilation_database.h"
+#include "common/generators/generators.h"
+#include "common/generators/profiler.h"
 #include "util/util.h"
 
 #define ANKERL_NANOBENCH_IMPLEMENT
@@ -24,6 +27,321 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+//
+// Benchmark results are written in JSON format to the directory specified
+// in the `CLANGUML_BENCHMARK_OUTPUT_DIR` environment variable, or to the
+// current directory by default:
+//   - benchmark_<name>.json - nanobench results for each benchmarked step
+//   - profile_<name>.json - breakdown of the pipeline phases of a single
+//                           instrumented run (see `--profile`)
+//
+// The synthetic test inputs can be scaled using `CLANGUML_BENCHMARK_CLASSES`,
+// `CLANGUML_BENCHMARK_TEMPLATES` and `CLANGUML_BENCHMARK_CALL_DEPTH`
+// environment variables.
+//
+namespace {
+using clanguml::common::compilation_database;
+using clanguml::common::compilation_database_ptr;
+using clanguml::common::generators::profiler;
+using clanguml::config::config_ptr;
+
+constexpr auto kDefaultSyntheticClasses{500U};
+constexpr auto kDefaultSyntheticTemplates{200U};
+constexpr auto kDefaultSyntheticCallDepth{200U};
+constexpr auto kPipelineEpochs{3U};
+
+unsigned env_or_default(const std::string &name, unsigned default_value)
+{
+    const auto value = clanguml::util::get_env(name);
+    if (value.empty())
+        return default_value;
+
+    return static_cast<unsigned>(std::stoul(value));
+}
+
+std::filesystem::path output_directory()
+{
+    const auto dir = clanguml::util::get_env("CLANGUML_BENCHMARK_OUTPUT_DIR");
+    if (dir.empty())
+        return std::filesystem::current_path();
+
+    std::filesystem::create_directories(dir);
+
+    return dir;
+}
+
+void write_results(ankerl::nanobench::Bench &bench, const profiler &prof,
+    const std::string &name)
+{
+    const auto dir = output_directory();
+
+    std::ofstream ofs{dir / fmt::format("benchmark_{}.json", name)};
+    bench.render(ankerl::nanobench::templates::json(), ofs);
+
+    prof.save(dir / fmt::format("profile_{}.json", name));
+}
+
+std::pair<config_ptr, compilation_database_ptr> load_config(
+    const std::filesystem::path &config_path,
+    const std::filesystem::path &compilation_database_dir)
+{
+    using clanguml::common::string_or_regex;
+
+    std::pair<config_ptr, compilation_database_ptr> res;
+
+    res.first = std::make_unique<clanguml::config::config>(
+        clanguml::config::load(config_path.string(), true, false, true));
+
+    res.first->compilation_database_dir.set(compilation_database_dir.string());
+
+    std::vector<string_or_regex> remove_compile_flags{
+        string_or_regex{"-Wno-class-memaccess"},
+        string_or_regex{"-forward-unknown-to-host-compiler"},
+        string_or_regex{
+            std::regex{"--generate-code=.*"}, "--generate-code=.*"}};
+
+    res.first->remove_compile_flags.set(remove_compile_flags);
+
+    res.second = compilation_database::auto_detect_from_directory(*res.first);
+
+    return res;
+}
+
+template <typename DiagramConfig, typename GeneratorTag, typename DiagramModel>
+void benchmark_generator(ankerl::nanobench::Bench &bench,
+    const std::string &title, DiagramConfig &config, DiagramModel &model)
+{
+    using diagram_generator =
+        typename clanguml::common::generators::diagram_generator_t<
+            DiagramConfig, GeneratorTag>::type;
+
+    if constexpr (!std::is_same_v<diagram_generator,
+                      clanguml::common::generators::not_supported>) {
+        bench.run(fmt::format("{} generate {}", title, GeneratorTag::extension),
+            [&] {
+                std::stringstream ss;
+                ss << diagram_generator(config, model);
+                ankerl::nanobench::doNotOptimizeAway(ss.str().size());
+            });
+    }
+}
+
+template <typename DiagramConfig>
+void benchmark_diagram_pipeline(ankerl::nanobench::Bench &bench,
+    profiler &prof, const compilation_database &db,
+    clanguml::config::diagram &diagram)
+{
+    using namespace clanguml::common::generators;
+
+    using diagram_model = typename diagram_model_t<DiagramConfig>::type;
+    using diagram_visitor = typename diagram_visitor_t<DiagramConfig>::type;
+
+    auto &config = dynamic_cast<DiagramConfig &>(diagram);
+    const auto &title = diagram.name;
+    const auto tus = diagram.glob_translation_units(db.getAllFiles());
+
+    REQUIRE_FALSE(tus.empty());
+
+    // Parse, visit, finalize and filter
+    std::unique_ptr<diagram_model> model;
+    bench.epochs(kPipelineEpochs)
+        .epochIterations(1)
+        .run(fmt::format("{} parse, visit, finalize and filter", title), [&] {
+            model = generate<diagram_model, DiagramConfig, diagram_visitor>(
+                db, diagram.name, config, tus);
+        });
+
+    // Restore default nanobench settings for faster steps
+    bench.epochs(11).epochIterations(0);
+
+    REQUIRE(model);
+    REQUIRE_FALSE(model->is_empty());
+
+    // Run once more with profiling enabled, to get a breakdown of the
+    // pipeline phases
+    model = generate<diagram_model, DiagramConfig, diagram_visitor>(db,
+        diagram.name, config, tus, false, {},
+        &prof.add_diagram(title, diagram.type()));
+
+    benchmark_generator<DiagramConfig, plantuml_generator_tag>(
+        bench, title, config, *model);
+    benchmark_generator<DiagramConfig, json_generator_tag>(
+        bench, title, config, *model);
+    benchmark_generator<DiagramConfig, mermaid_generator_tag>(
+        bench, title, config, *model);
+    benchmark_generator<DiagramConfig, graphml_generator_tag>(
+        bench, title, config, *model);
+}
+
+void benchmark_diagram(ankerl::nanobench::Bench &bench, profiler &prof,
+    const compilation_database &db, clanguml::config::diagram &diagram)
+{
+    using clanguml::common::model::diagram_t;
+
+    switch (diagram.type()) {
+    case diagram_t::kClass:
+        benchmark_diagram_pipeline<clanguml::config::class_diagram>(
+            bench, prof, db, diagram);
+        break;
+    case diagram_t::kSequence:
+        benchmark_diagram_pipeline<clanguml::config::sequence_diagram>(
+            bench, prof, db, diagram);
+        break;
+    case diagram_t::kPackage:
+        benchmark_diagram_pipeline<clanguml::config::package_diagram>(
+            bench, prof, db, diagram);
+        break;
+    case diagram_t::kInclude:
+        benchmark_diagram_pipeline<clanguml::config::include_diagram>(
+            bench, prof, db, diagram);
+        break;
+    }
+}
+
+/**
+ * Generate synthetic sources along with compilation database and
+ * configuration file.
+ */
+std::filesystem::path generate_synthetic_inputs(
+    unsigned classes, unsigned templates, unsigned call_depth)
+{
+    namespace fs = std::filesystem;
+
+    const auto dir = fs::temp_directory_path() / "clanguml_benchmarks";
+    fs::create_directories(dir);
+
+    {
+        // N classes, each with members and methods referencing the previous
+        // classes
+        std::ofstream ofs{dir / "classes.cc"};
+        ofs << "namespace bench {\n";
+        ofs << "struct C0 { int value; };\n";
+        for (auto i = 1U; i < classes; i++) {
+            ofs << fmt::format(
+                "struct C{0} : public C{1} {{\n"
+                "    C{1} *parent;\n"
+                "    C{2} sibling;\n"
+                "    int value{{0}};\n"
+                "    C{1} &get_parent();\n"
+                "    void set_sibling(const C{2} &s);\n"
+                "}};\n",
+                i, i - 1, i / 2);
+        }
+        ofs << "}\n";
+    }
+
+    {
+        // M nested template instantiations
+        std::ofstream ofs{dir / "templates.cc"};
+        ofs << "namespace bench {\n";
+        ofs << "template <typename T, int N> struct array { T data[N]; };\n";
+        ofs << "template <typename K, typename V> struct map_entry { K key; "
+               "V value; };\n";
+        ofs << "template <typename... Ts> struct tuple { };\n";
+        for (auto i = 0U; i < templates; i++) {
+            ofs << fmt::format(
+                "struct T{0} {{\n"
+                "    array<map_entry<int, tuple<char, long, T{1} *>>, {0}> "
+                "entries;\n"
+                "    tuple<array<int, {0}>, map_entry<T{1} *, double>> t;\n"
+                "}};\n",
+                i, i == 0 ? 0 : i - 1);
+        }
+        ofs << "}\n";
+    }
+
+    {
+        // Deep call chain
+        std::ofstream ofs{dir / "calls.cc"};
+        ofs << "namespace bench {\n";
+        for (auto i = 0U; i <= call_depth; i++)
+            ofs << fmt::format("struct F{} {{ int call(int x); }};\n", i);
+        for (auto i = 0U; i < call_depth; i++) {
+            ofs << fmt::format("int F{0}::call(int x) {{\n"
+                               "    F{1} next;\n"
+                               "    if (x > {0})\n"
+                               "        return next.call(x - 1);\n"
+                               "    return next.call(x) + 1;\n"
+                               "}}\n",
+                i, i + 1);
+        }
+        ofs << fmt::format(
+            "int F{}::call(int x) {{ return x; }}\n", call_depth);
+        ofs << "int entry() { F0 f; return f.call(0); }\n";
+        ofs << "}\n";
+    }
+
+    {
+        nlohmann::json compile_commands = nlohmann::json::array();
+        for (const auto *file : {"classes.cc", "templates.cc", "calls.cc"}) {
+            nlohmann::json cc;
+            cc["directory"] = dir.string();
+            cc["file"] = (dir / file).string();
+            cc["arguments"] = std::vector<std::string>{
+                "clang++", "-std=c++17", "-c", (dir / file).string()};
+            compile_commands.emplace_back(std::move(cc));
+        }
+
+        std::ofstream ofs{dir / "compile_commands.json"};
+        ofs << compile_commands.dump(2);
+    }
+
+    {
+        std::ofstream ofs{dir / ".clang-uml"};
+        ofs << R"(output_directory: diagrams
+diagrams:
+  synthetic_classes:
+    type: class
+    glob:
+      - classes.cc
+    include:
+      namespaces:
+        - bench
+  synthetic_templates:
+    type: class
+    glob:
+      - templates.cc
+    include:
+      namespaces:
+        - bench
+  synthetic_calls:
+    type: sequence
+    glob:
+      - calls.cc
+    include:
+      namespaces:
+        - bench
+    from:
+      - function: "bench::entry()"
+  synthetic_packages:
+    type: package
+    glob:
+      - classes.cc
+      - templates.cc
+    include:
+      namespaces:
+        - bench
+  synthetic_includes:
+    type: include
+    glob:
+      - classes.cc
+      - templates.cc
+      - calls.cc
+    include:
+      paths:
+        - .
+)";
+    }
+
+    return dir;
+}
+} // namespace
+
 TEST_CASE("nanobench clanguml::util::is_relative_to")
 {
     using std::filesystem::path;
@@ -37,4 +355,56 @@ TEST_CASE("nanobench clanguml::util::is_relative_to")
 
     ankerl::nanobench::Bench().run(
         "is_relative_to negative", [&] { is_relative_to(child, base2); });
-}
\ No newline at end of file
+}
+
+TEST_CASE("nanobench test case pipelines")
+{
+    // Representative test cases for each diagram type, the benchmark uses
+    // the same compilation database as test_cases
+    const std::vector<std::string> test_cases{
+        "t00002", "t00008", "t00014", "t20001", "t20029", "t30001", "t40001"};
+
+    const auto compilation_database_dir =
+        canonical(std::filesystem::current_path() / "..");
+
+    ankerl::nanobench::Bench bench;
+    bench.title("Test case pipelines").performanceCounters(true);
+
+    profiler prof;
+
+    for (const auto &test_case : test_cases) {
+        const auto config_path =
+            std::filesystem::path{"../../tests"} / test_case / ".clang-uml";
+
+        auto [config, db] = load_config(config_path, compilation_database_dir);
+
+        for (auto &[name, diagram] : config->diagrams) {
+            benchmark_diagram(bench, prof, *db, *diagram);
+        }
+    }
+
+    write_results(bench, prof, "test_cases");
+}
+
+TEST_CASE("nanobench synthetic pipelines")
+{
+    const auto dir = generate_synthetic_inputs(
+        env_or_default("CLANGUML_BENCHMARK_CLASSES", kDefaultSyntheticClasses),
+        env_or_default(
+            "CLANGUML_BENCHMARK_TEMPLATES", kDefaultSyntheticTemplates),
+        env_or_default(
+            "CLANGUML_BENCHMARK_CALL_DEPTH", kDefaultSyntheticCallDepth));
+
+    auto [config, db] = load_config(dir / ".clang-uml", dir);
+
+    ankerl::nanobench::Bench bench;
+    bench.title("Synthetic pipelines").performanceCounters(true);
+
+    profiler prof;
+
+    for (auto &[name, diagram] : config->diagrams) {
+        benchmark_diagram(bench, prof, *db, *diagram);
+    }
+
+    write_results(bench, prof, "synthetic");
+}
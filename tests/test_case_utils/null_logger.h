@@ -0,0 +1,43 @@
+/**
+ * @file tests/test_case_utils/null_logger.h
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+namespace clanguml::test {
+
+/**
+ * @brief Register `clanguml-logger` discarding all messages, unless the
+ *        logger is already registered.
+ *
+ * This allows testing code using `LOG_*` macros without the logger
+ * created by the command line handler.
+ */
+inline void register_null_logger()
+{
+    if (spdlog::get("clanguml-logger"))
+        return;
+
+    spdlog::register_logger(std::make_shared<spdlog::logger>(
+        "clanguml-logger", std::make_shared<spdlog::sinks::null_sink_mt>()));
+}
+
+} // namespace clanguml::test
@@ -76,7 +76,8 @@ load_config(const std::string &test_name)
 namespace detail {
 template <typename DiagramConfig>
 auto generate_diagram_impl(clanguml::common::compilation_database &db,
-    std::shared_ptr<clanguml::config::diagram> diagram)
+    std::shared_ptr<clanguml::config::diagram> diagram,
+    const std::filesystem::path &model_path = {})
 {
     LOG_INFO("All paths will be evaluated relative to {}",
         diagram->root_directory().string());
@@ -93,7 +94,8 @@ auto generate_diagram_impl(clanguml::common::compilation_database &db,
 
     auto model = clanguml::common::generators::generate<diagram_model,
         diagram_config, diagram_visitor>(
-        db, diagram->name, dynamic_cast<diagram_config &>(*diagram), tus);
+        db, diagram->name, dynamic_cast<diagram_config &>(*diagram), tus, false,
+        {}, nullptr, nullptr, 1, model_path);
 
     return model;
 }
@@ -474,6 +476,92 @@ void CHECK_INCLUDE_DIAGRAM(const clanguml::config::config &config,
     save_graphml(config.output_directory(), diagram->name + ".graphml",
         diagram_sources.template get<graphml_t>().src);
 }
+/**
+ * Check that diagram rendered from a model saved during generation and
+ * loaded back (merging it `merge_count` times into the same model, as if
+ * several workers produced the same elements) is identical to the diagram
+ * rendered from the generated model.
+ */
+template <typename DiagramConfig>
+void CHECK_MODEL_MERGE_ROUND_TRIP(const std::string &test_name,
+    const std::string &diagram_name, unsigned merge_count = 2)
+{
+    using diagram_model =
+        typename clanguml::common::generators::diagram_model_t<
+            DiagramConfig>::type;
+
+    auto [config, db] = load_config(test_name);
+
+    auto diagram = config->diagrams[diagram_name];
+
+    REQUIRE(diagram->name == diagram_name);
+
+    std::filesystem::create_directories(config->output_directory());
+
+    const auto model_path = clanguml::common::generators::model_path(
+        config->output_directory(), diagram_name);
+
+    auto model =
+        detail::generate_diagram_impl<DiagramConfig>(*db, diagram, model_path);
+
+    REQUIRE(std::filesystem::exists(model_path));
+
+    auto merged = std::make_unique<diagram_model>();
+    merged->set_name(diagram_name);
+    merged->set_filter(common::model::diagram_filter_factory::create(
+        *merged, dynamic_cast<DiagramConfig &>(*diagram)));
+
+    for (auto i = 0U; i < merge_count; i++)
+        common::model::load_model(model_path, *merged);
+
+    merged->set_complete(true);
+    merged->finalize();
+
+    REQUIRE(merged->name() == diagram_name);
+
+    CHECK(detail::render_diagram<plantuml_t, DiagramConfig>(diagram, *model) ==
+        detail::render_diagram<plantuml_t, DiagramConfig>(diagram, *merged));
+    CHECK(detail::render_diagram<json_t, DiagramConfig>(diagram, *model) ==
+        detail::render_diagram<json_t, DiagramConfig>(diagram, *merged));
+}
+/**
+ * Check that diagram regenerated from a saved model using
+ * `generators::load()`, as with `--from-model`, is identical to the diagram
+ * rendered from the model generated with `--save-model`.
+ */
+template <typename DiagramConfig>
+void CHECK_MODEL_SAVE_LOAD_ROUND_TRIP(
+    const std::string &test_name, const std::string &diagram_name)
+{
+    using diagram_model =
+        typename clanguml::common::generators::diagram_model_t<
+            DiagramConfig>::type;
+
+    auto [config, db] = load_config(test_name);
+
+    auto diagram = config->diagrams[diagram_name];
+
+    REQUIRE(diagram->name == diagram_name);
+
+    std::filesystem::create_directories(config->output_directory());
+
+    const auto model_path = clanguml::common::generators::model_path(
+        config->output_directory(), diagram_name);
+
+    auto model =
+        detail::generate_diagram_impl<DiagramConfig>(*db, diagram, model_path);
+
+    auto loaded =
+        clanguml::common::generators::load<diagram_model, DiagramConfig>(
+            diagram_name, dynamic_cast<DiagramConfig &>(*diagram), model_path);
+
+    REQUIRE(loaded->name() == diagram_name);
+
+    CHECK(detail::render_diagram<plantuml_t, DiagramConfig>(diagram, *model) ==
+        detail::render_diagram<plantuml_t, DiagramConfig>(diagram, *loaded));
+    CHECK(detail::render_diagram<json_t, DiagramConfig>(diagram, *model) ==
+        detail::render_diagram<json_t, DiagramConfig>(diagram, *loaded));
+}
 } // namespace clanguml::test
 
 ///
@@ -745,6 +833,39 @@ void CHECK_INCLUDE_DIAGRAM(const clanguml::config::config &config,
 #include "t40004/test_case.h"
 #endif
 
+///
+/// Model serialization tests
+///
+TEST_CASE("Test class diagram model merge round trip")
+{
+    clanguml::test::CHECK_MODEL_MERGE_ROUND_TRIP<
+        clanguml::config::class_diagram>("t00002", "t00002_class");
+}
+
+TEST_CASE("Test sequence diagram model merge round trip")
+{
+    clanguml::test::CHECK_MODEL_MERGE_ROUND_TRIP<
+        clanguml::config::sequence_diagram>("t20001", "t20001_sequence");
+}
+
+TEST_CASE("Test include diagram model merge round trip")
+{
+    clanguml::test::CHECK_MODEL_MERGE_ROUND_TRIP<
+        clanguml::config::include_diagram>("t40001", "t40001_include");
+}
+
+TEST_CASE("Test class diagram model save and load round trip")
+{
+    clanguml::test::CHECK_MODEL_SAVE_LOAD_ROUND_TRIP<
+        clanguml::config::class_diagram>("t00002", "t00002_class");
+}
+
+TEST_CASE("Test sequence diagram model save and load round trip")
+{
+    clanguml::test::CHECK_MODEL_SAVE_LOAD_ROUND_TRIP<
+        clanguml::config::sequence_diagram>("t20001", "t20001_sequence");
+}
+
 ///
 /// Other tests (e.g. configuration file)
 ///
@@ -607,4 +607,128 @@ TEST_CASE("Test cli handler fail when print_to or print_from do not have "
     auto res = cli.handle_options(argv.size(), argv.data());
 
     REQUIRE(res == cli_flow_t::kError);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test cli handler fail when watch is used with print_from")
+{
+    using clanguml::cli::cli_flow_t;
+    using clanguml::cli::cli_handler;
+
+    std::vector<const char *> argv = {
+        "clang-uml", "--watch", "--print-from", "-n", "d1"};
+
+    std::ostringstream ostr;
+    cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+    auto res = cli.handle_options(argv.size(), argv.data());
+
+    REQUIRE(res == cli_flow_t::kError);
+}
+
+TEST_CASE("Test cli handler timings option")
+{
+    using clanguml::cli::cli_flow_t;
+    using clanguml::cli::cli_handler;
+
+    {
+        std::vector<const char *> argv = {
+            "clang-uml", "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kContinue);
+
+        CHECK(!cli.get_runtime_config().timings);
+    }
+
+    {
+        std::vector<const char *> argv = {"clang-uml", "--timings",
+            "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kContinue);
+
+        const auto runtime_config = cli.get_runtime_config();
+        CHECK(runtime_config.timings);
+        CHECK(runtime_config.timings_path.empty());
+    }
+
+    {
+        std::vector<const char *> argv = {"clang-uml",
+            "--timings=/tmp/timings.json", "--config",
+            "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kContinue);
+
+        const auto runtime_config = cli.get_runtime_config();
+        CHECK(runtime_config.timings);
+        CHECK_EQ(runtime_config.timings_path, "/tmp/timings.json");
+    }
+}
+
+TEST_CASE("Test cli handler save and load model options")
+{
+    using clanguml::cli::cli_flow_t;
+    using clanguml::cli::cli_handler;
+
+    {
+        std::vector<const char *> argv = {"clang-uml", "--save-model",
+            "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kContinue);
+
+        const auto runtime_config = cli.get_runtime_config();
+        CHECK(runtime_config.save_model);
+        CHECK(!runtime_config.from_model);
+    }
+
+    {
+        std::vector<const char *> argv = {"clang-uml", "--from-model",
+            "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kContinue);
+
+        const auto runtime_config = cli.get_runtime_config();
+        CHECK(!runtime_config.save_model);
+        CHECK(runtime_config.from_model);
+    }
+
+    {
+        std::vector<const char *> argv = {"clang-uml", "--from-model",
+            "--save-model", "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kError);
+    }
+
+    {
+        std::vector<const char *> argv = {"clang-uml", "--from-model",
+            "--watch", "--config", "./test_config_data/user_data.yml"};
+
+        std::ostringstream ostr;
+        cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+        REQUIRE(cli.handle_options(argv.size(), argv.data()) ==
+            cli_flow_t::kError);
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file tests/test_cost_model.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/cost_model.h"
+#include "common/generators/worker_processes.h"
+#include "test_case_utils/null_logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test cost_model")
+{
+    using namespace clanguml::common::generators;
+    using clanguml::common::model::diagram_t;
+    using std::chrono::milliseconds;
+
+    cost_model costs;
+
+    // Without any timings, the cost is proportional to the number of
+    // translation units
+    CHECK_EQ(costs.estimate(diagram_t::kClass, "a.cc"),
+        cost_model::kDefaultCost);
+    CHECK_EQ(costs.estimate(diagram_t::kClass, {"a.cc", "b.cc", "c.cc"}),
+        3 * cost_model::kDefaultCost);
+
+    costs.record(diagram_t::kClass, "a.cc", milliseconds{10});
+    costs.record(diagram_t::kClass, "b.cc", milliseconds{40});
+    costs.record(diagram_t::kClass, "b.cc", milliseconds{30});
+
+    CHECK_EQ(costs.size(), 2);
+    CHECK_EQ(costs.estimate(diagram_t::kClass, "b.cc"), 30.0);
+    // Unknown translation units cost the average of known ones
+    CHECK_EQ(costs.estimate(diagram_t::kClass, {"a.cc", "b.cc", "c.cc"}), 60.0);
+
+    // Timings of other diagram types do not overwrite each other
+    costs.record(diagram_t::kInclude, "b.cc", milliseconds{2});
+    CHECK_EQ(costs.size(), 3);
+    CHECK_EQ(costs.estimate(diagram_t::kClass, "b.cc"), 30.0);
+    CHECK_EQ(costs.estimate(diagram_t::kInclude, "b.cc"), 2.0);
+    CHECK_EQ(costs.estimate(diagram_t::kInclude, "a.cc"), 2.0);
+
+    // Diagram types without timings cost the average of all known ones
+    CHECK_EQ(costs.estimate(diagram_t::kSequence, "a.cc"), 14.0);
+
+    diagram_profile profile;
+    profile.type = diagram_t::kClass;
+    profile.add_translation_unit("c.cc", timing{milliseconds{50}, {}});
+    costs.record(profile);
+    CHECK_EQ(costs.estimate(diagram_t::kClass, "c.cc"), 50.0);
+    CHECK_EQ(costs.estimate(diagram_t::kInclude, "c.cc"), 2.0);
+
+    const auto path =
+        std::filesystem::temp_directory_path() / "clanguml_test_timings.json";
+
+    costs.save(path);
+
+    cost_model loaded;
+    REQUIRE(loaded.load(path));
+    CHECK_EQ(loaded.size(), 4);
+    CHECK_EQ(
+        loaded.estimate(diagram_t::kClass, {"a.cc", "b.cc", "c.cc"}), 90.0);
+    CHECK_EQ(loaded.estimate(diagram_t::kClass, "d.cc"), 30.0);
+    CHECK_EQ(loaded.estimate(diagram_t::kInclude, "b.cc"), 2.0);
+
+    std::filesystem::remove(path);
+
+    CHECK(!loaded.load(path));
+    CHECK_EQ(loaded.size(), 0);
+}
+
+TEST_CASE("Test make_shards")
+{
+    using namespace clanguml::common::generators;
+
+    const std::vector<std::string> tus{"a", "b", "c", "d", "e"};
+
+    auto shards = make_shards(tus, 2);
+    REQUIRE_EQ(shards.size(), 2);
+    CHECK_EQ(shards[0], std::vector<std::string>{"a", "b", "c"});
+    CHECK_EQ(shards[1], std::vector<std::string>{"d", "e"});
+
+    CHECK_EQ(make_shards(tus, 8).size(), tus.size());
+    CHECK(make_shards({}, 2).empty());
+
+    // Expensive translation units are spread across shards
+    const std::map<std::string, double> costs{
+        {"a", 10}, {"b", 10}, {"c", 1}, {"d", 1}, {"e", 1}};
+    shards = make_shards(
+        tus, 2, [&costs](const std::string &tu) { return costs.at(tu); });
+    REQUIRE_EQ(shards.size(), 2);
+    CHECK_EQ(shards[0], std::vector<std::string>{"a", "c", "e"});
+    CHECK_EQ(shards[1], std::vector<std::string>{"b", "d"});
+
+    // No shard is left empty, even if all costs are 0
+    shards = make_shards(tus, 3, [](const std::string &) { return 0.0; });
+    REQUIRE_EQ(shards.size(), 3);
+    for (const auto &shard : shards)
+        CHECK(!shard.empty());
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Test run_worker_processes")
+{
+    using namespace clanguml::common::generators;
+
+    clanguml::test::register_null_logger();
+
+    const auto now = []() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    };
+
+    // Shard with the crashing translation unit is retried one by one
+    const std::vector<std::string> tus{"slow", "crash", "fast", "a", "b", "c"};
+
+    std::vector<std::string> merged;
+    std::map<std::string, std::pair<long long, long long>> times;
+
+    const auto skipped = run_worker_processes(
+        tus, 2,
+        [&](const std::vector<std::string> &shard) -> std::string {
+            if (std::find(shard.begin(), shard.end(), "crash") != shard.end())
+                std::_Exit(1);
+
+            const auto start = now();
+            if (shard.front() == "slow")
+                std::this_thread::sleep_for(std::chrono::milliseconds{500});
+
+            return std::to_string(start) + " " + std::to_string(now());
+        },
+        [&](const std::vector<std::string> &shard, std::string_view data) {
+            merged.insert(merged.end(), shard.begin(), shard.end());
+
+            std::istringstream is{std::string{data}};
+            is >> times[shard.front()].first >> times[shard.front()].second;
+        });
+
+    CHECK_EQ(skipped, std::vector<std::string>{"crash"});
+    CHECK_EQ(merged, std::vector<std::string>{"slow", "fast", "a", "b", "c"});
+
+    // Retried translation unit is started as soon as the crashed one
+    // finished, without waiting for the slow one
+    CHECK(times.at("fast").first < times.at("slow").second);
+}
+#endif
@@ -84,4 +84,78 @@ TEST_CASE(
 
     CHECK(second_is_valid);
     CHECK(third_is_valid);
-}
\ No newline at end of file
+}
+
+TEST_CASE("get_approximate_matches skips duplicate items")
+{
+    using namespace clanguml::util;
+
+    std::vector<std::string> items = {
+        "apple", "aple", "apple", "aple", "apply", "orange"};
+    auto result = get_approximate_matches(items, "apple");
+
+    CHECK(result == std::vector<std::string>{"apple", "aple", "apply"});
+}
+
+TEST_CASE("get_approximate_matches stops after exact matches")
+{
+    using namespace clanguml::util;
+
+    std::vector<std::string> items = {"apple", "aple", "apple", "", "apply"};
+
+    CHECK(get_approximate_matches(items, "apple", 1) ==
+        std::vector<std::string>{"apple"});
+    CHECK(get_approximate_matches(items, "", 1) ==
+        std::vector<std::string>{""});
+    CHECK(get_approximate_matches({"", "", "a"}, "", 2) ==
+        std::vector<std::string>{"", "a"});
+}
+
+TEST_CASE("get_approximate_matches respects max_results")
+{
+    using namespace clanguml::util;
+
+    std::vector<std::string> items = {"orange", "aple", "apple", "apply"};
+
+    CHECK(get_approximate_matches(items, "apple", 0).empty());
+    CHECK(get_approximate_matches(items, "apple", 1) ==
+        std::vector<std::string>{"apple"});
+    CHECK(get_approximate_matches(items, "apple", 10).size() == 4);
+}
+
+TEST_CASE("levenshtein_distance computes edit distance")
+{
+    using namespace clanguml::util;
+
+    CHECK(levenshtein_distance("", "") == 0);
+    CHECK(levenshtein_distance("", "abc") == 3);
+    CHECK(levenshtein_distance("abc", "") == 3);
+    CHECK(levenshtein_distance("kitten", "sitting") == 3);
+    CHECK(levenshtein_distance("sitting", "kitten") == 3);
+    CHECK(levenshtein_distance("flaw", "lawn") == 2);
+    CHECK(levenshtein_distance("ns::A::foo()", "ns::A::foo()") == 0);
+
+    // Patterns longer than a single 64 bit block
+    const std::string a(100, 'a');
+    std::string b{a};
+    b[10] = 'b';
+    b[70] = 'b';
+    b.erase(90, 5);
+
+    CHECK(levenshtein_distance(a, b) == 7);
+    CHECK(levenshtein_distance(b, a) == 7);
+    CHECK(levenshtein_distance(a + a, b + b) == 14);
+    CHECK(levenshtein_distance(a, std::string(200, 'b')) == 200);
+}
+
+TEST_CASE("levenshtein_matcher stops early above max_distance")
+{
+    using namespace clanguml::util;
+
+    const levenshtein_matcher matcher{"clanguml::util::split"};
+
+    CHECK(matcher.distance("clanguml::util::split") == 0);
+    CHECK(matcher.distance("clanguml::util::spilt", 2) == 2);
+    CHECK(matcher.distance("clanguml::util::join", 2) > 2);
+    CHECK(matcher.distance("x", 5) > 5);
+}
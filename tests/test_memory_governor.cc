@@ -0,0 +1,76 @@
+/**
+ * @file tests/test_memory_governor.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/memory_governor.h"
+#include "test_case_utils/null_logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+TEST_CASE("Test memory_governor")
+{
+    using namespace clanguml::common::generators;
+    using namespace std::chrono_literals;
+
+    clanguml::test::register_null_logger();
+
+    memory_governor governor;
+
+    std::atomic<std::size_t> rss{200};
+    governor.set_rss_source([&rss]() { return rss.load(); });
+
+    // Without a limit, translation units are never throttled
+    {
+        const auto s1 = governor.acquire("a.cc");
+        const auto s2 = governor.acquire("b.cc");
+        CHECK_EQ(governor.active(), 2);
+    }
+    CHECK_EQ(governor.active(), 0);
+    CHECK(!governor.enabled());
+
+    governor.set_limit(100);
+    CHECK(governor.enabled());
+
+    // A single translation unit is allowed even above the limit
+    auto s1 = std::make_unique<memory_governor::slot>(governor.acquire("a.cc"));
+    CHECK_EQ(governor.active(), 1);
+
+    auto s2 = std::async(std::launch::async, [&governor]() {
+        return std::make_unique<memory_governor::slot>(
+            governor.acquire("b.cc"));
+    });
+
+    CHECK(s2.wait_for(2 * memory_governor::kPollInterval) ==
+        std::future_status::timeout);
+    CHECK_EQ(governor.active(), 1);
+
+    // Memory usage dropped below the limit
+    rss = 50;
+    auto s2_slot = s2.get();
+    CHECK_EQ(governor.active(), 2);
+    CHECK_EQ(governor.throttled_count(), 1);
+
+    s1.reset();
+    s2_slot.reset();
+    CHECK_EQ(governor.active(), 0);
+}
@@ -20,11 +20,29 @@
 #include "doctest/doctest.h"
 
 #include "class_diagram/model/class.h"
+#include "class_diagram/model/diagram.h"
+#include "class_diagram/model/serialization.h"
 #include "common/model/enums.h"
+#include "common/model/jinja_context.h"
 #include "common/model/namespace.h"
 #include "common/model/package.h"
 #include "common/model/path.h"
+#include "common/model/serialization.h"
+#include "common/model/source_location.h"
 #include "common/model/template_parameter.h"
+#include "include_diagram/model/diagram.h"
+#include "package_diagram/model/diagram.h"
+#include "package_diagram/model/serialization.h"
+#include "sequence_diagram/model/call_graph.h"
+#include "sequence_diagram/model/definition_index.h"
+#include "sequence_diagram/model/diagram.h"
+#include "sequence_diagram/model/message.h"
+#include "sequence_diagram/model/serialization.h"
+#include "test_case_utils/null_logger.h"
+
+#include <fstream>
+#include <future>
+#include <vector>
 
 TEST_CASE("Test namespace_")
 {
@@ -123,6 +141,59 @@ TEST_CASE("Test class_::calculate_specialization_match")
     }
 }
 
+TEST_CASE("Test class_::full_name cache invalidation")
+{
+    using clanguml::class_diagram::model::class_;
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::template_parameter;
+
+    auto c = class_(namespace_{"ns1"});
+    c.set_name("A");
+    c.set_namespace(namespace_{"ns1::ns2"});
+
+    const auto &full_name = c.full_name(false);
+    CHECK(full_name == "ns1::ns2::A");
+    CHECK(c.full_name(true) == "ns2::A");
+
+    c.add_template(template_parameter::make_argument("int"));
+    CHECK(c.full_name(false) == "ns1::ns2::A<int>");
+    // Reference returned before the element changed is not modified
+    CHECK(full_name == "ns1::ns2::A");
+
+    c.set_name("B");
+    CHECK(c.full_name(false) == "ns1::ns2::B<int>");
+
+    c.set_namespace(namespace_{"ns1::ns3"});
+    CHECK(c.full_name(false) == "ns1::ns3::B<int>");
+    CHECK(c.full_name(true) == "ns3::B<int>");
+
+    c.complete(true);
+    const auto &complete_full_name = c.full_name(false);
+    CHECK(complete_full_name == "ns1::ns3::B<int>");
+    // Complete elements return a reference to the memoized name
+    CHECK(&c.full_name(false) == &complete_full_name);
+}
+
+TEST_CASE("Test full_name of elements not cached during visitation")
+{
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::package;
+
+    auto p = package{namespace_{}};
+    p.set_name("A");
+
+    const auto &full_name = p.full_name(false);
+    CHECK(full_name == "A");
+    CHECK(&p.full_name(false) == &full_name);
+
+    p.set_name("B");
+    CHECK(p.full_name(false) == "B");
+    CHECK(full_name == "A");
+
+    p.complete(true);
+    CHECK(p.full_name(false) == "B");
+}
+
 TEST_CASE("Test template_parameter::calculate_specialization_match")
 {
     using clanguml::common::model::template_parameter;
@@ -415,6 +486,108 @@ TEST_CASE("Test template_parameter::calculate_specialization_match")
     }
 }
 
+TEST_CASE("Test template_parameter interning")
+{
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::template_parameter;
+
+    const auto make_vector = [](const std::string &element_type) {
+        auto allocator = template_parameter::make_argument("std::allocator");
+        allocator.add_template_param(
+            template_parameter::make_argument(element_type));
+
+        auto vector = template_parameter::make_argument("std::vector");
+        vector.add_template_param(
+            template_parameter::make_argument(element_type));
+        vector.add_template_param(std::move(allocator));
+        return vector;
+    };
+
+    auto tp1 = make_vector("ns1::A");
+    auto tp2 = make_vector("ns1::A");
+    auto tp3 = make_vector("ns1::B");
+
+    CHECK(!tp1.is_interned());
+    CHECK(tp1 == tp2);
+    CHECK(tp1 != tp3);
+
+    // Identical nested template arguments share the same node
+    CHECK(tp1.template_params().at(1).is_interned());
+    CHECK(&tp1.template_params().at(1).template_params() ==
+        &tp2.template_params().at(1).template_params());
+
+    tp1.intern();
+    tp2.intern();
+    tp3.intern();
+
+    CHECK(&tp1.template_params() == &tp2.template_params());
+    CHECK(tp1 == tp2);
+    CHECK(tp1 != tp3);
+
+    CHECK(tp1.to_string({}, false) ==
+        "std::vector<ns1::A,std::allocator<ns1::A>>");
+    CHECK(tp1.to_string(namespace_{"ns1"}, true) ==
+        "std::vector<A,std::allocator<A>>");
+    CHECK(tp1.to_string(namespace_{"std"}, true) ==
+        "vector<ns1::A,allocator<ns1::A>>");
+
+    // Modifying an interned template parameter does not affect other
+    // template parameters sharing its node
+    auto tp4 = tp1;
+    tp4.set_type("std::deque");
+
+    CHECK(!tp4.is_interned());
+    CHECK(tp4.to_string({}, false) ==
+        "std::deque<ns1::A,std::allocator<ns1::A>>");
+    CHECK(tp1.to_string({}, false) ==
+        "std::vector<ns1::A,std::allocator<ns1::A>>");
+    CHECK(tp2.to_string({}, false) ==
+        "std::vector<ns1::A,std::allocator<ns1::A>>");
+}
+
+TEST_CASE("Test template_parameter interning in multiple threads")
+{
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::template_parameter;
+
+    const auto make_map = []() {
+        auto map = template_parameter::make_argument("std::map");
+        map.add_template_param(template_parameter::make_argument("ns1::A"));
+        map.add_template_param(template_parameter::make_argument("ns1::B"));
+        map.intern();
+        return map;
+    };
+
+    // Structurally identical template parameters interned by different
+    // threads are not shared, but still compare equal
+    auto tp1 = make_map();
+    auto tp2 = std::async(std::launch::async, make_map).get();
+
+    CHECK(tp1.is_interned());
+    CHECK(tp2.is_interned());
+    CHECK(&tp1.template_params() != &tp2.template_params());
+    CHECK(tp1 == tp2);
+
+    // Cached to_string() results can be read concurrently
+    std::vector<std::future<bool>> results;
+    for (auto i = 0; i < 8; i++) {
+        results.emplace_back(std::async(std::launch::async, [&tp1, i] {
+            auto ok{true};
+            for (auto j = 0; j < 100; j++) {
+                const auto relative = (i + j) % 2 == 0;
+                ok = ok &&
+                    tp1.to_string(namespace_{"ns1"}, relative) ==
+                        (relative ? "std::map<A,B>"
+                                  : "std::map<ns1::A,ns1::B>");
+            }
+            return ok;
+        }));
+    }
+
+    for (auto &r : results)
+        CHECK(r.get());
+}
+
 TEST_CASE("Test common::model::package full_name")
 {
     using clanguml::common::model::package;
@@ -492,6 +665,43 @@ TEST_CASE("Test path_type")
     REQUIRE_THROWS_AS(p1 = p2, std::runtime_error);
 }
 
+TEST_CASE("Test source_location file path interning")
+{
+    using namespace clanguml::common::model;
+
+    auto &paths = file_path_table::instance();
+
+    source_location sl1;
+    CHECK(sl1.file().empty());
+    CHECK(sl1.file_id() == file_path_table::kEmpty);
+
+    sl1.set_file("/src/a.h");
+    sl1.set_file_relative("a.h");
+    sl1.set_translation_unit("/src/a.cc");
+
+    source_location sl2{"/src/a.h", 10};
+    sl2.set_file_relative(std::string{"a.h"});
+
+    CHECK(sl1.file() == "/src/a.h");
+    CHECK(sl1.file_relative() == "a.h");
+    CHECK(sl1.translation_unit() == "/src/a.cc");
+    CHECK(sl2.line() == 10);
+
+    CHECK(sl1.file_id() == sl2.file_id());
+    CHECK(sl1.file_relative_id() == sl2.file_relative_id());
+    CHECK(&sl1.file() == &sl2.file());
+    CHECK(paths.path(sl1.file_id()) == "/src/a.h");
+
+    const auto size = paths.size();
+    CHECK(paths.intern("/src/a.h") == sl1.file_id());
+    CHECK(paths.intern("") == file_path_table::kEmpty);
+    CHECK(paths.size() == size);
+
+    sl2.set_file_relative("");
+    CHECK(sl2.file_relative_id() == file_path_table::kEmpty);
+    CHECK(sl2.file_relative().empty());
+}
+
 TEST_CASE("Test from_string diagram_t")
 {
     using namespace clanguml::common::model;
@@ -550,4 +760,498 @@ TEST_CASE("Test is_return message_t")
     CHECK_FALSE(is_return(message_t::kConditionalElse));
     CHECK_FALSE(is_return(message_t::kConditionalEnd));
     CHECK_FALSE(is_return(message_t::kCoAwait));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test sequence_diagram::model::message")
+{
+    using namespace clanguml::common::model;
+    using clanguml::sequence_diagram::model::diagram;
+    using clanguml::sequence_diagram::model::message;
+
+    diagram d;
+
+    message m1{message_t::kCall, eid_t{int64_t{1}}};
+    m1.set_to(eid_t{int64_t{2}});
+    m1.set_message_name(d.intern("a"));
+    m1.set_return_type(d.intern("int"));
+
+    CHECK(m1.message_name() == "a");
+    CHECK(m1.return_type() == "int");
+    CHECK_FALSE(m1.comment().has_value());
+    CHECK_FALSE(m1.condition_text().has_value());
+    CHECK(m1.decorators().empty());
+    CHECK_FALSE(m1.skip());
+    CHECK(m1.location().file().empty());
+    CHECK(m1.location().line() == 0);
+
+    message m2{message_t::kCall, eid_t{int64_t{1}}};
+    m2.set_to(eid_t{int64_t{2}});
+    m2.set_message_name(d.intern(std::string{"a"}));
+    m2.set_return_type(d.intern(std::string{"int"}));
+
+    // Message labels are interned by the diagram
+    CHECK(&m1.message_name() == &m2.message_name());
+    CHECK(m1 == m2);
+
+    m2.condition_text("x > 0");
+    m2.set_comment(1, "Comment");
+    CHECK(m2.condition_text().value() == "x > 0");
+    CHECK(m2.comment().value().at("comment") == "Comment");
+    CHECK_FALSE(m1 == m2);
+
+    m2.location().set_file("/src/a.cc");
+    m2.location().set_line(10);
+    CHECK(m2.location().file() == "/src/a.cc");
+    CHECK(m2.location().line() == 10);
+
+    // Copies do not share optional message details
+    message m3{m2};
+    CHECK(m3 == m2);
+    m3.condition_text("x < 0");
+    m3.location().set_line(11);
+    CHECK(m2.condition_text().value() == "x > 0");
+    CHECK(m3.condition_text().value() == "x < 0");
+    CHECK(m2.location().line() == 10);
+    CHECK(m3.location().line() == 11);
+
+    m3 = m1;
+    CHECK(m3 == m1);
+    CHECK_FALSE(m3.condition_text().has_value());
+
+    message m4;
+    CHECK(m4.message_name().empty());
+    CHECK(m4.return_type().empty());
+    m4.set_message_name(d.intern(""));
+    CHECK(m4 == message{});
+}
+
+TEST_CASE("Test sequence_diagram::model::call_graph")
+{
+    using clanguml::sequence_diagram::model::call_graph;
+
+    call_graph g;
+
+    const auto tmain = g.add_function("ns::tmain");
+    const auto a_foo = g.add_function("ns::A::foo");
+    const auto a_bar = g.add_function("ns::A::bar");
+    const auto b_foo = g.add_function("ns::B::foo");
+    const auto b_baz = g.add_function("ns::B::baz");
+    const auto unused = g.add_function("ns::unused");
+    const auto t_run = g.add_function("ns::T::run");
+
+    g.add_call(tmain, a_foo);
+    g.add_call(a_foo, a_bar);
+    g.add_call(unused, b_baz);
+    g.add_call(tmain, t_run);
+    // Call in a dependent context, e.g. `t.foo()`
+    g.add_unresolved_call(t_run, "foo");
+
+    CHECK(g.size() == 7);
+    CHECK(g.contains(call_graph::to_id("ns::A::foo")));
+    CHECK_FALSE(g.contains(call_graph::to_id("ns::C::foo")));
+
+    CHECK(g.find_functions("ns::tmain()") == std::vector{tmain});
+    CHECK(g.find_functions("ns::A::foo(int) const") == std::vector{a_foo});
+    CHECK(g.find_functions("ns::T<int>::run()") == std::vector{t_run});
+    CHECK(g.find_functions("ns::main()").empty());
+
+    CHECK(g.callees_closure({a_foo}) ==
+        std::unordered_set<call_graph::node_id>{a_foo, a_bar});
+    CHECK(g.callees_closure({tmain}) ==
+        std::unordered_set<call_graph::node_id>{
+            tmain, a_foo, a_bar, t_run, b_foo});
+
+    CHECK(g.callers_closure({b_baz}) ==
+        std::unordered_set<call_graph::node_id>{b_baz, unused});
+    CHECK(g.callers_closure({a_bar}) ==
+        std::unordered_set<call_graph::node_id>{a_bar, a_foo, tmain, t_run});
+}
+
+TEST_CASE("Test sequence_diagram::model::definition_index")
+{
+    using clanguml::sequence_diagram::model::call_graph;
+    using clanguml::sequence_diagram::model::definition_index;
+    namespace fs = std::filesystem;
+
+    const auto dir = fs::temp_directory_path() / "clanguml_test_index";
+    fs::create_directories(dir);
+
+    const auto write_file = [](const fs::path &path,
+                                const std::string &contents) {
+        std::ofstream ofs{path, std::ios::trunc};
+        ofs << contents;
+    };
+
+    const auto a_cc = (dir / "a.cc").string();
+    const auto b_cc = (dir / "b.cc").string();
+    const auto a_h = (dir / "a.h").string();
+
+    write_file(a_cc, "void foo() { bar(); }");
+    write_file(b_cc, "void bar() {}");
+    write_file(a_h, "inline void baz() {}");
+
+    definition_index index;
+
+    REQUIRE(index.stale_translation_units({a_cc, b_cc}) ==
+        std::vector<std::string>{a_cc, b_cc});
+    CHECK(!index.modified());
+
+    index.set_translation_unit(a_cc,
+        {{{a_cc, definition_index::file_hash(a_cc)},
+             {a_h, definition_index::file_hash(a_h)}},
+            {"foo"}, {"baz"}});
+    index.set_translation_unit(b_cc,
+        {{{b_cc, definition_index::file_hash(b_cc)},
+             {a_h, definition_index::file_hash(a_h)}},
+            {"bar"}, {"baz"}});
+
+    REQUIRE(index.size() == 2);
+    REQUIRE(index.stale_translation_units({a_cc, b_cc}).empty());
+    CHECK(index.modified());
+
+    const auto foo = call_graph::to_id("foo");
+    const auto bar = call_graph::to_id("bar");
+    const auto baz = call_graph::to_id("baz");
+
+    CHECK(index.translation_units(foo) == std::set<std::string>{a_cc});
+    CHECK(index.translation_units(bar) == std::set<std::string>{b_cc});
+    CHECK(index.translation_units(baz).empty());
+    CHECK(index.inline_translation_units(baz) ==
+        std::set<std::string>{a_cc, b_cc});
+
+    call_graph graph;
+    index.add_functions(graph);
+    CHECK(graph.size() == 3);
+    CHECK(graph.contains(baz));
+
+    const auto index_path = definition_index::default_path(dir);
+    index.save(index_path);
+
+    definition_index loaded;
+    REQUIRE(loaded.load(index_path));
+    REQUIRE(loaded.size() == 2);
+    CHECK(!loaded.modified());
+    CHECK(loaded.translation_units(foo) == std::set<std::string>{a_cc});
+    CHECK(loaded.inline_translation_units(baz) ==
+        std::set<std::string>{a_cc, b_cc});
+
+    // Change of an included file invalidates all translation units
+    // including it
+    write_file(a_h, "inline void baz() { }");
+    CHECK(loaded.stale_translation_units({a_cc, b_cc}) ==
+        std::vector<std::string>{a_cc, b_cc});
+
+    // Cached file hashes are refreshed after the file is modified
+    CHECK(index.stale_translation_units({b_cc, a_cc}) ==
+        std::vector<std::string>{b_cc, a_cc});
+
+    // Reindexed translation unit replaces its previous definitions
+    loaded.set_translation_unit(a_cc,
+        {{{a_cc, definition_index::file_hash(a_cc)},
+             {a_h, definition_index::file_hash(a_h)}},
+            {"foo2"}, {}});
+    CHECK(loaded.modified());
+    CHECK(loaded.translation_units(foo).empty());
+    CHECK(loaded.inline_translation_units(baz) ==
+        std::set<std::string>{b_cc});
+    CHECK(loaded.stale_translation_units({a_cc, b_cc}) ==
+        std::vector<std::string>{b_cc});
+
+    write_file(index_path, "{ invalid");
+    CHECK(!loaded.load(index_path));
+    CHECK(loaded.size() == 0);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Test common::model::binary_writer and binary_reader")
+{
+    using namespace clanguml::common::model;
+    using clanguml::common::eid_t;
+
+    binary_writer w;
+    w.write_bool(true);
+    w.write_uint(0);
+    w.write_uint(300);
+    w.write_uint(UINT64_MAX);
+    w.write_id(eid_t{uint64_t{12345}});
+    w.write_id(eid_t{int64_t{67890}});
+    w.write_string("");
+    w.write_string("ns1::A<int>");
+    w.write_optional_string(std::nullopt);
+    w.write_optional_string("comment");
+    w.write_strings({"a", "b"});
+    w.write_enum(access_t::kProtected);
+
+    const auto data = w.release();
+    binary_reader r{data};
+
+    CHECK(r.read_bool());
+    CHECK(r.read_uint() == 0);
+    CHECK(r.read_uint() == 300);
+    CHECK(r.read_uint() == UINT64_MAX);
+    CHECK(r.read_id() == eid_t{uint64_t{12345}});
+    CHECK(r.read_id() == eid_t{int64_t{67890}});
+    CHECK(r.read_string().empty());
+    CHECK(r.read_string() == "ns1::A<int>");
+    CHECK(!r.read_optional_string().has_value());
+    CHECK(r.read_optional_string() == "comment");
+    CHECK(r.read_strings() == std::vector<std::string>{"a", "b"});
+    CHECK(r.read_enum<access_t>() == access_t::kProtected);
+    CHECK(r.at_end());
+
+    CHECK_THROWS_AS(r.read_bool(), clanguml::error::model_serialization_error);
+
+    binary_reader truncated{std::string_view{data}.substr(0, 5)};
+    truncated.read_bool();
+    truncated.read_uint();
+    truncated.read_uint();
+    CHECK_THROWS_AS(
+        truncated.read_uint(), clanguml::error::model_serialization_error);
+}
+
+TEST_CASE("Test common::model::binary_writer interning")
+{
+    using namespace clanguml::common::model;
+    using clanguml::common::eid_t;
+
+    binary_writer w;
+    w.write_string("clanguml::common::model::diagram");
+    w.write_id(eid_t{uint64_t{0xDEADBEEFCAFEULL}});
+    const auto first_size = w.buffer().size();
+
+    w.write_string("clanguml::common::model::diagram");
+    w.write_id(eid_t{uint64_t{0xDEADBEEFCAFEULL}});
+    CHECK(w.buffer().size() == first_size + 2);
+
+    w.write_string("other");
+
+    const auto data = w.release();
+    binary_reader r{data};
+    CHECK(r.read_string_view() == "clanguml::common::model::diagram");
+    CHECK(r.read_id() == eid_t{uint64_t{0xDEADBEEFCAFEULL}});
+    CHECK(r.read_string() == "clanguml::common::model::diagram");
+    CHECK(r.read_id() == eid_t{uint64_t{0xDEADBEEFCAFEULL}});
+    CHECK(r.read_string() == "other");
+    CHECK(r.at_end());
+
+    binary_writer h;
+    write_header(h, diagram_t::kInclude);
+    auto header = h.release();
+    binary_reader hr{header};
+    CHECK(read_header(hr) == diagram_t::kInclude);
+
+    header[kModelFormatMagic.size()]++;
+    binary_reader invalid_version{header};
+    CHECK_THROWS_AS(read_header(invalid_version),
+        clanguml::error::model_serialization_error);
+}
+
+TEST_CASE("Test package_diagram::model serialization")
+{
+    using namespace clanguml::common::model;
+    using clanguml::common::eid_t;
+    using clanguml::package_diagram::model::diagram;
+
+    clanguml::test::register_null_logger();
+
+    const auto make_package = [](const std::string &ns,
+                                  const std::string &name, uint64_t id) {
+        auto p = std::make_unique<package>(path{}, path_type::kNamespace);
+        p->set_namespace(path{ns});
+        p->set_name(name);
+        p->set_id(eid_t{id});
+        return p;
+    };
+
+    diagram d1;
+    d1.add(path{}, make_package("", "A", 1));
+    auto b = make_package("A", "B", 2);
+    b->add_relationship(
+        relationship{relationship_t::kDependency, eid_t{uint64_t{3}}});
+    d1.add(path{"A"}, std::move(b));
+
+    diagram d2;
+    d2.add(path{}, make_package("", "A", 1));
+    auto b2 = make_package("A", "B", 2);
+    b2->add_relationship(
+        relationship{relationship_t::kDependency, eid_t{uint64_t{1}}});
+    d2.add(path{"A"}, std::move(b2));
+    d2.add(path{}, make_package("", "C", 3));
+
+    diagram merged;
+    for (const auto *d : {&d1, &d2}) {
+        binary_writer w;
+        serialize(*d, w);
+        const auto data = w.release();
+        binary_reader r{data};
+        deserialize(r, merged);
+    }
+
+    REQUIRE(merged.elements<package>().size() == 3);
+
+    const auto merged_b = merged.find<package>(eid_t{uint64_t{2}});
+    REQUIRE(merged_b.has_value());
+    CHECK(merged_b.value().full_name(false) == "A::B");
+    CHECK(merged_b.value().relationships().size() == 2);
+    CHECK(merged.find<package>(eid_t{uint64_t{3}}).has_value());
+
+    const auto model_path =
+        std::filesystem::temp_directory_path() / "clanguml_test_model.bin";
+    save_model(merged, model_path);
+
+    diagram loaded;
+    load_model(model_path, loaded);
+    CHECK(loaded.elements<package>().size() == 3);
+    CHECK(loaded.find<package>(eid_t{uint64_t{2}})
+              .value()
+              .relationships()
+              .size() == 2);
+
+    clanguml::class_diagram::model::diagram class_diagram;
+    CHECK_THROWS_AS(load_model(model_path, class_diagram),
+        clanguml::error::model_serialization_error);
+
+    std::filesystem::remove(model_path);
+}
+
+TEST_CASE("Test sequence_diagram::model serialization")
+{
+    using namespace clanguml::common::model;
+    using clanguml::common::eid_t;
+    using clanguml::sequence_diagram::model::activity;
+    using clanguml::sequence_diagram::model::diagram;
+    using clanguml::sequence_diagram::model::message;
+
+    clanguml::test::register_null_logger();
+
+    diagram d1;
+    message m1{message_t::kCall, eid_t{int64_t{1}}};
+    m1.set_to(eid_t{int64_t{2}});
+    m1.set_message_name(d1.intern("a"));
+    m1.location().set_file("/src/a.cc");
+    m1.location().set_line(10);
+
+    message m2{message_t::kIfEnd, eid_t{int64_t{1}}};
+
+    activity a{eid_t{int64_t{1}}};
+    a.add_message(m1);
+    a.add_message(m2);
+    d1.sequences().emplace(eid_t{int64_t{1}}, std::move(a));
+
+    diagram merged;
+    {
+        binary_writer w;
+        serialize(d1, w);
+        const auto data = w.release();
+        binary_reader r{data};
+        deserialize(r, merged);
+    }
+
+    REQUIRE(merged.sequences().size() == 1);
+    const auto &messages = merged.sequences().at(eid_t{int64_t{1}}).messages();
+    REQUIRE(messages.size() == 2);
+    CHECK(messages.at(0) == m1);
+    CHECK(messages.at(1) == m2);
+
+    // Message labels are interned by the diagram they were read into
+    CHECK(messages.at(0).message_name() == "a");
+    CHECK(&messages.at(0).message_name() == merged.intern("a"));
+    CHECK(&messages.at(0).message_name() != &m1.message_name());
+
+    CHECK(messages.at(0).location().file() == "/src/a.cc");
+    CHECK(messages.at(0).location().line() == 10);
+    CHECK(messages.at(1).location().file().empty());
+}
+
+TEST_CASE("Test include_diagram::model::diagram file lookup")
+{
+    using clanguml::common::model::source_file;
+    using clanguml::include_diagram::model::diagram;
+    using clanguml::include_diagram::model::include_cache;
+
+    clanguml::test::register_null_logger();
+
+    diagram d;
+    auto f = std::make_unique<source_file>(std::filesystem::path{"src/a.h"});
+    const auto id = f->id();
+    d.add_file(std::move(f));
+    d.add_file(std::make_unique<source_file>(std::filesystem::path{"src/a.h"}));
+
+    // Parent directory is added along with the file
+    REQUIRE(d.files().size() == 2);
+    REQUIRE(d.find<source_file>(id).has_value());
+    CHECK(d.find<source_file>(id).value().name() == "a.h");
+    CHECK(d.get(id).has_value());
+
+    const auto dir_id = source_file{std::filesystem::path{"src"}}.id();
+    CHECK(d.find<source_file>(dir_id).has_value());
+
+    include_cache &cache = d.includes();
+    const include_cache::file_uid_t a{1, 10};
+    const include_cache::file_uid_t b{1, 11};
+
+    CHECK(cache.add_edge(a, b));
+    CHECK_FALSE(cache.add_edge(a, b));
+    CHECK(cache.add_edge(b, a));
+
+    CHECK(cache.find_source_file(a) == nullptr);
+    cache.add_source_file(a, id);
+    cache.add_source_file(b, std::nullopt);
+    REQUIRE(cache.find_source_file(a) != nullptr);
+    CHECK(*cache.find_source_file(a) == id);
+    REQUIRE(cache.find_source_file(b) != nullptr);
+    CHECK_FALSE(cache.find_source_file(b)->has_value());
+}
+
+TEST_CASE("Test common::jinja::template_variables")
+{
+    using clanguml::common::jinja::element_context;
+    using clanguml::common::jinja::parse_template;
+    using clanguml::common::jinja::render_template;
+    using clanguml::common::jinja::template_variables;
+    using clanguml::common::model::source_location;
+
+    clanguml::test::register_null_logger();
+
+    inja::Environment env;
+
+    const auto t = parse_template(env,
+        "{% if element.source.line > 1 %}{{ git.branch }}{% endif %}"
+        "{{ element.source.path }}#L{{ element.source.line }}");
+    REQUIRE(t);
+
+    const auto &vars = t->variables;
+    CHECK(vars.references("git"));
+    CHECK(vars.references("git.branch"));
+    CHECK_FALSE(vars.references("git.commit"));
+    CHECK(vars.references("element"));
+    CHECK(vars.references("element.source"));
+    CHECK_FALSE(vars.references("element.name"));
+    CHECK_FALSE(vars.references("element.sourc"));
+    CHECK_FALSE(vars.references("user_data"));
+
+    CHECK(template_variables::all().references("user_data"));
+    CHECK(parse_template(env, "{% if exists(\"element.name\") %}{% endif %}")
+              ->variables.references("element.name"));
+    CHECK_FALSE(parse_template(env, "{{ element.name"));
+
+    inja::json diagram_context;
+    diagram_context["git"]["branch"] = "main";
+    diagram_context["user_data"]["key"] = "value";
+
+    source_location sl;
+    sl.set_file("a.h");
+    sl.set_line(2);
+
+    inja::json ec = element_context<source_location>(sl, diagram_context, vars);
+    CHECK(ec.contains("git"));
+    CHECK_FALSE(ec.contains("user_data"));
+    CHECK(render_template(env, ec, *t) == "maina.h#L2");
+
+    const auto names = parse_template(env, "{{ element.name }}");
+    inja::json names_ec =
+        element_context<source_location>(sl, diagram_context, names->variables);
+    CHECK_FALSE(names_ec.contains("git"));
+    CHECK_FALSE(names_ec.contains("element"));
+}
@@ -0,0 +1,162 @@
+/**
+ * @file tests/test_profiler.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/profiler.h"
+#include "util/util.h"
+
+#include <chrono>
+#include <sstream>
+
+TEST_CASE("Test profiler report")
+{
+    using namespace clanguml::common::generators;
+    using clanguml::common::model::diagram_t;
+    using clanguml::util::contains;
+    using std::chrono::milliseconds;
+
+    profiler prof;
+
+    auto &a = prof.add_diagram("A", diagram_t::kClass);
+    a.add_phase("compile commands", timing{milliseconds{1}, milliseconds{1}});
+    a.add_phase("compile commands", timing{milliseconds{2}, milliseconds{1}});
+    a.add_phase("apply_filter", timing{milliseconds{5}, milliseconds{4}});
+    a.add_translation_unit("a1.cc", timing{milliseconds{10}, milliseconds{9}});
+    a.add_translation_unit("a2.cc", timing{milliseconds{30}, milliseconds{9}});
+    a.elements_count = 3;
+    a.relationships_count = 2;
+
+    auto &b = prof.add_diagram("B", diagram_t::kSequence);
+    b.add_translation_unit("b1.cc", timing{milliseconds{20}, milliseconds{9}});
+
+    REQUIRE_EQ(a.phases.size(), 2);
+    CHECK_EQ(a.phases[0].first, "compile commands");
+    CHECK_EQ(a.phases[0].second.wall, milliseconds{3});
+    CHECK_EQ(a.phases[0].second.cpu, milliseconds{2});
+
+    auto j = prof.to_json(2);
+    REQUIRE_EQ(j["diagrams"].size(), 2);
+    CHECK_EQ(j["diagrams"][0]["name"], "A");
+    CHECK_EQ(j["diagrams"][0]["type"], "class");
+    CHECK_EQ(j["diagrams"][0]["elements_count"], 3);
+    CHECK_EQ(j["diagrams"][0]["relationships_count"], 2);
+    CHECK_EQ(j["diagrams"][0]["phases"][1]["name"], "apply_filter");
+
+    REQUIRE_EQ(j["slowest_translation_units"].size(), 2);
+    CHECK_EQ(j["slowest_translation_units"][0]["path"], "a2.cc");
+    CHECK_EQ(j["slowest_translation_units"][1]["path"], "b1.cc");
+    CHECK_EQ(j["slowest_translation_units"][1]["diagram"], "B");
+    CHECK(j.contains("peak_rss"));
+    CHECK(!j["diagrams"][0].contains("peak_rss"));
+
+    std::stringstream sstr;
+    prof.print(sstr, 1);
+
+    const auto report = sstr.str();
+    CHECK(contains(report, "Diagram 'A' [class]: 3 elements, 2 relationships"));
+    CHECK(contains(report, "Peak RSS of the process:"));
+    CHECK(contains(report, "Slowest 1 translation units:"));
+    CHECK(contains(report, "a2.cc [A]"));
+    CHECK(!contains(report, "b1.cc [B]"));
+    CHECK(!contains(report, "Schedule:"));
+
+    a.estimated_cost = 40;
+    b.estimated_cost = 25;
+    prof.set_run(timing{milliseconds{100}, milliseconds{150}}, 2);
+
+    CHECK_EQ(prof.utilization(), doctest::Approx(0.75));
+
+    sstr.str("");
+    prof.print(sstr, 1);
+    CHECK(contains(sstr.str(), "Schedule:"));
+    CHECK(contains(sstr.str(), "Core utilization: 75% of 2 cores"));
+
+    j = prof.to_json(2);
+    CHECK_EQ(j["diagrams"][0]["estimated_cost_ms"], 40);
+    CHECK_EQ(j["run"]["cores"], 2);
+}
+
+TEST_CASE("Test diagram_profile serialization")
+{
+    using namespace clanguml::common::generators;
+    using clanguml::common::model::binary_reader;
+    using clanguml::common::model::binary_writer;
+    using std::chrono::milliseconds;
+
+    // Timings of a worker process
+    diagram_profile worker;
+    worker.add_phase("parse and traverse", {milliseconds{7}, milliseconds{6}});
+    worker.add_phase("traverse AST", {milliseconds{3}, milliseconds{3}});
+    worker.add_translation_unit("b.cc", {milliseconds{4}, milliseconds{4}});
+    worker.add_translation_unit("c.cc", {milliseconds{3}, milliseconds{2}});
+
+    binary_writer w;
+    serialize(worker, w);
+
+    diagram_profile p;
+    p.add_phase("parse and traverse", {milliseconds{5}, milliseconds{5}});
+    p.add_translation_unit("a.cc", {milliseconds{5}, milliseconds{5}});
+
+    binary_reader r{w.buffer()};
+    deserialize(r, p);
+
+    CHECK(r.at_end());
+
+    REQUIRE(p.phases.size() == 2);
+    CHECK(p.phases[0].first == "parse and traverse");
+    CHECK(p.phases[0].second.wall == milliseconds{12});
+    CHECK(p.phases[0].second.cpu == milliseconds{11});
+    CHECK(p.phases[1].first == "traverse AST");
+    CHECK(p.phases[1].second.wall == milliseconds{3});
+
+    REQUIRE(p.translation_units.size() == 3);
+    CHECK(p.translation_units[1].path == "b.cc");
+    CHECK(p.translation_units[1].time.wall == milliseconds{4});
+    CHECK(p.translation_units[2].path == "c.cc");
+    CHECK(p.translation_units[2].time.cpu == milliseconds{2});
+}
+
+TEST_CASE("Test diagram_profile merge")
+{
+    using namespace clanguml::common::generators;
+    using std::chrono::milliseconds;
+
+    // Timings of a task parsing a part of the translation units
+    diagram_profile task;
+    task.add_phase("generate svg", {milliseconds{2}, milliseconds{1}});
+    task.add_phase("parse and traverse", {milliseconds{7}, milliseconds{6}});
+    task.add_translation_unit("b.cc", {milliseconds{7}, milliseconds{6}});
+
+    diagram_profile p;
+    p.add_phase("parse and traverse", {milliseconds{5}, milliseconds{5}});
+    p.add_translation_unit("a.cc", {milliseconds{5}, milliseconds{5}});
+
+    p.merge(task);
+
+    REQUIRE(p.phases.size() == 2);
+    CHECK(p.phases[0].first == "parse and traverse");
+    CHECK(p.phases[0].second.wall == milliseconds{12});
+    CHECK(p.phases[0].second.cpu == milliseconds{11});
+    CHECK(p.phases[1].first == "generate svg");
+
+    REQUIRE(p.translation_units.size() == 2);
+    CHECK(p.translation_units[0].path == "a.cc");
+    CHECK(p.translation_units[1].path == "b.cc");
+}
@@ -43,3 +43,122 @@ TEST_CASE("Test thread_pool_executor")
 
     CHECK(counter == kTaskCount);
 }
+
+TEST_CASE("Test thread_pool_executor nested tasks")
+{
+    using clanguml::util::thread_pool_executor;
+
+    // Each task waits for its nested tasks, which would deadlock a pool
+    // without help-while-waiting
+    thread_pool_executor pool{2};
+
+    std::atomic_int counter{0};
+
+    std::vector<std::future<void>> futs;
+
+    const unsigned int kTaskCount = 8;
+    const unsigned int kNestedTaskCount = 100;
+
+    for (auto i = 0U; i < kTaskCount; i++) {
+        futs.emplace_back(pool.add([&pool, &counter]() {
+            CHECK(thread_pool_executor::current() == &pool);
+
+            std::vector<std::future<void>> nested;
+            for (auto j = 0U; j < kNestedTaskCount; j++) {
+                nested.emplace_back(pool.add([&counter]() { counter++; }));
+            }
+
+            for (auto &f : nested) {
+                pool.wait(f);
+                f.get();
+            }
+        }));
+    }
+
+    for (auto &f : futs) {
+        pool.wait(f);
+        f.get();
+    }
+
+    CHECK(counter == kTaskCount * kNestedTaskCount);
+    CHECK(thread_pool_executor::current() == nullptr);
+}
+
+TEST_CASE("Test thread_pool_executor priorities")
+{
+    using clanguml::util::thread_pool_executor;
+
+    thread_pool_executor pool{1};
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+
+    // Block the only worker until all tasks are added
+    std::promise<void> start;
+    auto started = start.get_future().share();
+    auto blocker = pool.add([started]() { started.wait(); });
+
+    std::vector<std::future<void>> futs;
+    for (const auto priority : {1, 5, 3, 5, 0}) {
+        futs.emplace_back(pool.add(
+            [&order_mutex, &order, priority]() {
+                std::lock_guard<std::mutex> l(order_mutex);
+                order.push_back(priority);
+            },
+            priority));
+    }
+
+    start.set_value();
+
+    blocker.get();
+    for (auto &f : futs) {
+        f.get();
+    }
+
+    CHECK(order == std::vector<int>{5, 5, 3, 1, 0});
+}
+
+TEST_CASE("Test thread_pool_executor task exception")
+{
+    using clanguml::util::thread_pool_executor;
+
+    thread_pool_executor pool{2};
+
+    auto fut = pool.add([]() { throw std::runtime_error("failed"); });
+
+    CHECK_THROWS_AS(fut.get(), std::runtime_error);
+
+    // Pool is still usable after a task failed
+    std::atomic_int counter{0};
+    pool.add([&counter]() { counter++; }).get();
+    CHECK(counter == 1);
+}
+
+TEST_CASE("Test run_nested")
+{
+    using clanguml::util::run_nested;
+    using clanguml::util::thread_pool_executor;
+
+    const unsigned int kTaskCount = 100;
+
+    std::atomic_int counter{0};
+    std::vector<std::function<void()>> tasks;
+    for (auto i = 0U; i < kTaskCount; i++) {
+        tasks.emplace_back([&counter]() { counter++; });
+    }
+
+    // Outside of a pool the tasks are executed sequentially
+    run_nested(tasks);
+    CHECK(counter == kTaskCount);
+
+    thread_pool_executor pool{2};
+
+    pool.add([&tasks]() { run_nested(tasks); }).get();
+    CHECK(counter == 2 * kTaskCount);
+
+    // All tasks finish before the first exception is rethrown
+    tasks.emplace_back([]() { throw std::runtime_error("failed"); });
+    auto fut = pool.add([&tasks]() { run_nested(tasks); });
+    CHECK_THROWS_AS(fut.get(), std::runtime_error);
+    CHECK(counter == 3 * kTaskCount);
+}
@@ -17,10 +17,17 @@
  */
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
+#include "common/generators/graphml/xml_writer.h"
+#include "util/memoized.h"
 #include "util/util.h"
 #include <common/clang_utils.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include "doctest/doctest.h"
 
@@ -530,6 +537,48 @@ TEST_CASE("Test find_entry_by_path_prefix")
     CHECK(kv.value().second == "my_other_project_sources");
 }
 
+TEST_CASE("Test path_prefix_map")
+{
+    using clanguml::util::path_prefix_map;
+
+    const path_prefix_map m{{{"src", "sources"}, {"./src/", "sources_dir"},
+        {"src/lib", "lib"}, {"/usr/include", "system"}}};
+
+    CHECK(m.find("src/main.cc").value().second == "sources_dir");
+    CHECK(m.find("./src/lib/../main.cc").value().second == "sources_dir");
+    CHECK(m.find("src/lib/a/b.cc").value().second == "lib");
+    CHECK(m.find("src/libx/a.cc").value().second == "sources_dir");
+    CHECK(m.find("/usr/include/string.h").value().second == "system");
+    CHECK_FALSE(m.find("usr/include/string.h").has_value());
+    CHECK_FALSE(m.find("/usr/local/include/a.h").has_value());
+    CHECK_FALSE(m.find("include/a.h").has_value());
+    CHECK(path_prefix_map{{}}.find("src/main.cc") == std::nullopt);
+}
+
+TEST_CASE("Test path_prefix_map with many nested prefixes")
+{
+    using clanguml::util::path_prefix_map;
+
+    // Insert enough nested paths to reallocate the node storage many times
+    // while the prefix tree is being built
+    std::map<std::string, std::string> prefixes;
+    std::string prefix{"src"};
+    for (auto i = 0; i < 100; i++) {
+        prefix += fmt::format("/d{}", i);
+        prefixes.emplace(prefix, fmt::format("v{}", i));
+        prefixes.emplace(
+            fmt::format("lib{}/a/b/c", i), fmt::format("lib{}", i));
+    }
+
+    const path_prefix_map m{prefixes};
+
+    CHECK(m.find("src/d0/main.cc").value().second == "v0");
+    CHECK(m.find("src/d0/d1/d2/main.cc").value().second == "v2");
+    CHECK(m.find(prefix + "/main.cc").value().second == "v99");
+    CHECK(m.find("lib42/a/b/c/d.h").value().second == "lib42");
+    CHECK_FALSE(m.find("lib42/a/b/d.h").has_value());
+}
+
 TEST_CASE("Test condense_whitespace")
 {
     using clanguml::util::condense_whitespace;
@@ -538,4 +587,166 @@ TEST_CASE("Test condense_whitespace")
 
     CHECK_EQ(condense_whitespace("  \t\n        "), " ");
     CHECK_EQ(condense_whitespace("A  \t\n        A"), "A A");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test stable_hash")
+{
+    using clanguml::util::stable_hash;
+
+    CHECK(stable_hash("") == 0xcbf29ce484222325ULL);
+    CHECK(stable_hash("a") == 0xaf63dc4c8601ec8cULL);
+    CHECK(stable_hash("foobar") == 0x85944171f73967e8ULL);
+    CHECK(stable_hash("ns1::ns2::A") != stable_hash("ns1::ns2::B"));
+}
+
+TEST_CASE("Test string_interner")
+{
+    using clanguml::util::string_interner;
+
+    string_interner interner;
+
+    const auto &a1 = interner.intern("ns1::A");
+    const auto &b = interner.intern("ns1::B");
+    const auto &a2 = interner.intern(std::string{"ns1::"} + "A");
+
+    CHECK(&a1 == &a2);
+    CHECK(&a1 != &b);
+    CHECK(a1 == "ns1::A");
+    CHECK(interner.size() == 2);
+}
+
+TEST_CASE("Test graphml xml_writer")
+{
+    using clanguml::common::generators::graphml::xml_element;
+    using clanguml::common::generators::graphml::xml_writer;
+
+    std::stringstream ss;
+
+    {
+        xml_writer w{ss};
+        w.write_declaration("1.0", "UTF-8");
+        w.write_comment(" a--b ");
+
+        auto root = w.append_child("graphml");
+        root.append_attribute("xmlns", "ns").append_attribute("q", "a\"<&b");
+
+        auto graph = root.append_child("graph");
+        auto node = graph.append_child("node");
+        node.append_attribute("id", "n0");
+        node.append_child("data").set_text("A<B> && C");
+        node.append_child("data").set_cdata("x]]>y");
+
+        graph.append_child("node").append_attribute("id", "n1");
+
+        // Appending to a null element is ignored
+        xml_element empty;
+        CHECK(!empty);
+        empty.append_child("node").append_attribute("id", "n2");
+
+        root.append_child("desc");
+    }
+
+    CHECK(ss.str() ==
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- a- -b -->
+<graphml xmlns="ns" q="a&quot;&lt;&amp;b">
+  <graph>
+    <node id="n0">
+      <data>A&lt;B&gt; &amp;&amp; C</data>
+      <data><![CDATA[x]]]]><![CDATA[>y]]></data>
+    </node>
+    <node id="n1" />
+  </graph>
+  <desc />
+</graphml>
+)");
+}
+
+TEST_CASE("Test concurrent memoized")
+{
+    using clanguml::util::memoized;
+    using clanguml::util::memoized_value;
+
+    struct tag { };
+
+    constexpr auto kThreadCount{8U};
+    constexpr auto kKeyCount{64U};
+
+    memoized<tag, std::string, std::filesystem::path> m;
+    memoized<tag, std::string> name;
+    memoized_value<std::string> value;
+    std::atomic<unsigned> value_calls{0};
+    std::atomic<unsigned> failures{0};
+
+    std::vector<std::thread> threads;
+    for (auto t = 0U; t < kThreadCount; t++) {
+        threads.emplace_back([&, t]() {
+            for (auto i = 0U; i < kKeyCount; i++) {
+                const auto key = (i + t) % kKeyCount;
+                const auto r = m.memoize(
+                    true,
+                    [](const std::filesystem::path &p) {
+                        return p.filename().string();
+                    },
+                    std::filesystem::path{"/src"} / std::to_string(key));
+
+                if (r != std::to_string(key))
+                    failures++;
+
+                if (name.memoize(true, []() { return std::string{"A"}; }) !=
+                    "A")
+                    failures++;
+
+                if (value.get(true, [&]() {
+                        value_calls++;
+                        return std::string{"B"};
+                    }) != "B")
+                    failures++;
+            }
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    CHECK(failures == 0);
+    // Concurrent first reads can compute the value more than once
+    CHECK(value_calls >= 1);
+    CHECK(value_calls <= kThreadCount);
+
+    auto copy = m;
+    CHECK(copy.memoize(
+              true,
+              [](const std::filesystem::path &) { return std::string{}; },
+              std::filesystem::path{"/src/1"}) == "1");
+
+    m.invalidate(std::filesystem::path{"/src/1"});
+    CHECK(m.memoize(
+              true,
+              [](const std::filesystem::path &) { return std::string{"x"}; },
+              std::filesystem::path{"/src/1"}) == "x");
+
+    value.invalidate();
+    CHECK(value.get(true, []() { return std::string{"C"}; }) == "C");
+}
+
+TEST_CASE("Test nested memoized_value sharing a mutex")
+{
+    using clanguml::util::memoized_value;
+    using clanguml::util::detail::memoization_mutex;
+
+    // Find two values guarded by the same mutex of the pool
+    std::vector<memoized_value<std::string>> values(256);
+    auto outer = values.begin();
+    auto inner = std::find_if(std::next(outer), values.end(),
+        [&outer](const auto &v) {
+            return &memoization_mutex(&v) == &memoization_mutex(&*outer);
+        });
+    REQUIRE(inner != values.end());
+
+    // Computing a value, which reads another value, must not deadlock
+    CHECK(outer->get(true, [&inner]() {
+        return inner->get(true, []() { return std::string{"A"}; }) + "B";
+    }) == "AB");
+    CHECK(inner->valid());
+}
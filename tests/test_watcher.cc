@@ -0,0 +1,182 @@
+/**
+ * @file tests/test_watcher.cc
+ *
+ * Copyright (c) 2021-2026 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/watcher.h"
+
+#include <fstream>
+
+TEST_CASE("Test dependency_tracker")
+{
+    using clanguml::common::generators::dependency_tracker;
+
+    dependency_tracker deps;
+
+    deps.set_dependencies("d1", "/src/a.cc", {"/src/a.cc", "/include/a.h"});
+    deps.set_dependencies("d1", "/src/b.cc", {"/include/b.h"});
+    deps.set_dependencies("d2", "/src/b.cc", {"/include/b.h", "/include/c.h"});
+
+    REQUIRE(deps.files() ==
+        std::set<std::string>{"/src/a.cc", "/src/b.cc", "/include/a.h",
+            "/include/b.h", "/include/c.h"});
+
+    REQUIRE(deps.affected_diagrams({"/include/a.h"}) ==
+        std::set<std::string>{"d1"});
+    REQUIRE(deps.affected_diagrams({"/include/b.h"}) ==
+        std::set<std::string>{"d1", "d2"});
+    REQUIRE(deps.affected_diagrams({"/src/b.cc"}) ==
+        std::set<std::string>{"d1", "d2"});
+    REQUIRE(deps.affected_diagrams({"/include/c.h", "/src/a.cc"}) ==
+        std::set<std::string>{"d1", "d2"});
+    REQUIRE(deps.affected_diagrams({"/include/d.h"}).empty());
+
+    // Translation unit no longer includes c.h
+    deps.set_dependencies("d2", "/src/b.cc", {"/include/b.h"});
+
+    REQUIRE(deps.affected_diagrams({"/include/c.h"}).empty());
+    REQUIRE(deps.files().count("/include/c.h") == 0);
+}
+
+TEST_CASE("Test file_change_detector")
+{
+    using clanguml::common::generators::file_change_detector;
+    namespace fs = std::filesystem;
+
+    const auto dir = fs::temp_directory_path() / "clanguml_test_watcher";
+    fs::create_directories(dir);
+
+    const auto a = (dir / "a.h").string();
+    const auto b = (dir / "b.h").string();
+
+    const auto write_file = [](const std::string &path,
+                                const std::string &contents) {
+        std::ofstream ofs{path, std::ios::trunc};
+        ofs << contents;
+    };
+
+    write_file(a, "struct A {};");
+    write_file(b, "struct B {};");
+
+    file_change_detector detector;
+
+    // Initial state is recorded without reporting any changes
+    REQUIRE(detector.update({a, b}).empty());
+    REQUIRE(detector.update({a, b}).empty());
+
+    // Modification time changed, but the contents did not
+    fs::last_write_time(a, fs::last_write_time(a) + std::chrono::seconds{1});
+    REQUIRE(detector.update({a, b}).empty());
+
+    write_file(b, "struct B { int b; };");
+    fs::last_write_time(b, fs::last_write_time(b) + std::chrono::seconds{2});
+    REQUIRE(detector.update({a, b}) == std::set<std::string>{b});
+    REQUIRE(detector.update({a, b}).empty());
+
+    fs::remove(a);
+    REQUIRE(detector.update({a, b}) == std::set<std::string>{a});
+    REQUIRE(detector.update({a, b}).empty());
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Test dependency_tracker serialization")
+{
+    using clanguml::common::generators::dependency_tracker;
+    using clanguml::common::model::binary_reader;
+    using clanguml::common::model::binary_writer;
+
+    // Dependencies recorded by a worker process
+    dependency_tracker worker;
+    worker.set_dependencies("d1", "/src/b.cc", {"/include/b.h"});
+    worker.set_dependencies("d1", "/src/c.cc", {"/include/c.h"});
+
+    binary_writer w;
+    serialize(worker, w);
+
+    dependency_tracker deps;
+    deps.set_dependencies("d1", "/src/a.cc", {"/include/a.h"});
+    deps.set_dependencies("d1", "/src/b.cc", {});
+
+    binary_reader r{w.buffer()};
+    deserialize(r, deps);
+
+    CHECK(r.at_end());
+
+    // Dependencies of translation units parsed by the worker are replaced
+    const auto dependencies = deps.dependencies();
+    REQUIRE(dependencies.size() == 3);
+    CHECK(dependencies.at({"d1", "/src/a.cc"}) ==
+        std::set<std::string>{"/src/a.cc", "/include/a.h"});
+    CHECK(dependencies.at({"d1", "/src/b.cc"}) ==
+        std::set<std::string>{"/src/b.cc", "/include/b.h"});
+    CHECK(dependencies.at({"d1", "/src/c.cc"}) ==
+        std::set<std::string>{"/src/c.cc", "/include/c.h"});
+    CHECK(deps.files() ==
+        std::set<std::string>{"/src/a.cc", "/src/b.cc", "/src/c.cc",
+            "/include/a.h", "/include/b.h", "/include/c.h"});
+}
+
+TEST_CASE("Test dependency_tracker partial models")
+{
+    using clanguml::common::generators::dependency_tracker;
+
+    const std::vector<std::string> tus{"/src/a.cc", "/src/b.cc"};
+
+    dependency_tracker deps;
+    deps.set_dependencies("d1", "/src/a.cc", {"/include/a.h"});
+    deps.set_dependencies("d1", "/src/b.cc", {"/include/b.h"});
+    deps.set_dependencies("d2", "/src/b.cc", {"/include/b.h"});
+
+    // Initial generation parses all translation units
+    CHECK(deps.set_context("d1", 0, tus));
+    CHECK(deps.outdated_translation_units("d1", tus) == tus);
+    CHECK(deps.set_partial_model("d1", "/src/a.cc", "a"));
+    CHECK(deps.set_partial_model("d1", "/src/b.cc", "b"));
+    CHECK(deps.outdated_translation_units("d1", tus).empty());
+    REQUIRE(deps.partial_model("d1", "/src/a.cc"));
+    CHECK(*deps.partial_model("d1", "/src/a.cc") == "a");
+    CHECK_FALSE(deps.partial_model("d2", "/src/a.cc"));
+
+    // Only translation units depending on changed files are invalidated
+    CHECK(deps.invalidate({"/include/b.h"}) ==
+        std::set<std::string>{"d1", "d2"});
+    CHECK_FALSE(deps.set_context("d1", 0, tus));
+    CHECK(deps.outdated_translation_units("d1", tus) ==
+        std::vector<std::string>{"/src/b.cc"});
+
+    // Partial model which did not change does not change the diagram
+    CHECK_FALSE(deps.set_partial_model("d1", "/src/b.cc", "b"));
+    CHECK(deps.outdated_translation_units("d1", tus).empty());
+    CHECK(deps.set_partial_model("d1", "/src/b.cc", "b2"));
+    CHECK(*deps.partial_model("d1", "/src/b.cc") == "b2");
+
+    // Failed generation is repeated even if no partial model changes
+    deps.reset_context("d1");
+    CHECK(deps.set_context("d1", 0, tus));
+
+    // Change of the translation units changes the diagram
+    CHECK(deps.set_context("d1", 0, {"/src/a.cc"}));
+    CHECK(deps.outdated_translation_units("d1", tus).empty());
+
+    // Change of the context drops all partial models of the diagram
+    CHECK(deps.set_context("d1", 1, tus));
+    CHECK(deps.outdated_translation_units("d1", tus) == tus);
+    CHECK_FALSE(deps.partial_model("d1", "/src/a.cc"));
+}